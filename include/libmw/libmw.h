@@ -25,10 +25,23 @@ IMPORT std::vector<uint8_t> SerializeHeader(const libmw::HeaderRef& header);
 IMPORT libmw::BlockRef DeserializeBlock(const std::vector<uint8_t>& bytes);
 IMPORT std::vector<uint8_t> SerializeBlock(const libmw::BlockRef& block);
 
+//
+// Deserializes directly from the caller's memory (e.g. a network buffer or a memory-mapped file), without copying it first.
+// The memory is only read during the call.
+//
+IMPORT libmw::BlockRef DeserializeBlock(const uint8_t* pBytes, const size_t length);
+
 IMPORT libmw::BlockUndoRef DeserializeBlockUndo(const std::vector<uint8_t>& bytes);
 IMPORT std::vector<uint8_t> SerializeBlockUndo(const libmw::BlockUndoRef& blockUndo);
 
+//
+// Serializes the undo data without copying spent outputs, which are instead referenced by MMR leaf index.
+// Use ExpandCompactBlockUndo to turn the bytes back into a BlockUndoRef.
+//
+IMPORT std::vector<uint8_t> SerializeCompactBlockUndo(const libmw::BlockUndoRef& blockUndo);
+
 IMPORT libmw::TxRef DeserializeTx(const std::vector<uint8_t>& bytes);
+IMPORT libmw::TxRef DeserializeTx(const uint8_t* pBytes, const size_t length);
 IMPORT std::vector<uint8_t> SerializeTx(const libmw::TxRef& tx);
 
 NODE_NAMESPACE
@@ -36,12 +49,14 @@ NODE_NAMESPACE
 //
 // Loads the state (MMRs mostly) into memory, and validates the current UTXO set.
 // If successful, the CoinsViewDB will be returned which represents the state of the active chain.
+// When auditState is true, the entire UTXO set is re-summed and checked, rather than just the saved running totals.
 // TODO: Document exceptions thrown.
 //
 IMPORT libmw::CoinsViewRef Initialize(
     const libmw::ChainParams& chainParams,
     const libmw::HeaderRef& header,
-    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper
+    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper,
+    const bool auditState = false
 );
 
 //
@@ -63,7 +78,36 @@ IMPORT void CheckBlock(
 );
 
 IMPORT libmw::BlockUndoRef ConnectBlock(const libmw::BlockRef& block, const libmw::CoinsViewRef& view);
+
+//
+// Connects the blocks, in order, using a single cache that is flushed to the view only once.
+// Results are identical to calling ConnectBlock for each block, so this is intended for initial sync.
+// If maxCacheBytes is non-zero, the cache is also flushed whenever its memory usage exceeds it.
+// Returns one BlockUndoRef per block, in the same order as the blocks.
+//
+IMPORT std::vector<libmw::BlockUndoRef> ConnectBlocks(
+    const std::vector<libmw::BlockRef>& blocks,
+    const libmw::CoinsViewRef& view,
+    const uint64_t maxCacheBytes = 0
+);
 IMPORT void DisconnectBlock(const libmw::BlockUndoRef& undoData, const libmw::CoinsViewRef& view);
+
+//
+// Disconnects the blocks, ordered from the current tip backwards, with a single rewind and flush.
+// Results are identical to calling DisconnectBlock for each BlockUndoRef, so this is intended for reorgs.
+//
+IMPORT void DisconnectBlocks(const std::vector<libmw::BlockUndoRef>& undos, const libmw::CoinsViewRef& view);
+
+//
+// Deserializes undo data written by SerializeCompactBlockUndo, reading the spent outputs back from the view's MMRs.
+// The view must still be at the block being disconnected. Outputs that have been pruned from the MMRs
+// are looked up in pBlockStore instead, which may be null if nothing has been pruned.
+//
+IMPORT libmw::BlockUndoRef ExpandCompactBlockUndo(
+    const std::vector<uint8_t>& bytes,
+    const libmw::CoinsViewRef& view,
+    const libmw::IBlockStore::Ptr& pBlockStore
+);
 IMPORT libmw::BlockRef BuildNextBlock(
     const uint64_t height,
     const libmw::CoinsViewRef& view,
@@ -73,12 +117,31 @@ IMPORT libmw::BlockRef BuildNextBlock(
 );
 IMPORT void FlushCache(const libmw::CoinsViewRef& view, const std::unique_ptr<libmw::IDBBatch>& pBatch = nullptr);
 
+//
+// Starts writing the cache's changes to the database on a background thread, and returns immediately.
+// The view can keep being used to connect blocks while the write is in progress.
+// Call WaitForFlush before committing or reading the underlying database view.
+//
+IMPORT void FlushCacheAsync(const libmw::CoinsViewRef& view);
+IMPORT void WaitForFlush(const libmw::CoinsViewRef& view);
+
+//
+// Returns the approximate number of bytes of memory held by the view's unflushed changes.
+// Consumers can add this to their own cache usage when deciding whether to call FlushCache.
+//
+IMPORT uint64_t GetCacheMemoryUsage(const libmw::CoinsViewRef& view);
+
 // State
 IMPORT libmw::StateRef DeserializeState(const std::vector<uint8_t>& bytes);
 IMPORT std::vector<uint8_t> SerializeState(const libmw::StateRef& state);
 IMPORT libmw::StateRef SnapshotState(const libmw::CoinsViewRef& view, const libmw::BlockHash& block_hash);
 
 // Mempool
+
+//
+// Context-free validation of a transaction. Throws a ValidationException if invalid.
+// Valid transactions are marked as such, so BuildNextBlock can skip verifying them again.
+//
 IMPORT void CheckTransaction(const libmw::TxRef& transaction);
 
 END_NAMESPACE // node
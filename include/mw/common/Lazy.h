@@ -0,0 +1,119 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <thread>
+#include <utility>
+
+//
+// A value that's computed on first use, and then cached.
+// The computation must always give the same result, e.g. hashing immutable fields.
+//
+// Safe to use from multiple threads without locking. Threads that race to compute the value
+// each compute it, but only one stores it. With Get(), the others return their own (identical) copy.
+// Copies only carry over a value that has finished being stored.
+//
+template<class T>
+class Lazy
+{
+    enum EState : uint8_t
+    {
+        EMPTY,
+        WRITING,
+        READY
+    };
+
+public:
+    Lazy() noexcept : m_state(EMPTY), m_value() { }
+    explicit Lazy(T value) noexcept : m_state(READY), m_value(std::move(value)) { }
+    Lazy(const Lazy& other) : m_state(EMPTY), m_value() { CopyFrom(other); }
+    Lazy(Lazy&& other) noexcept : m_state(EMPTY), m_value() { MoveFrom(other); }
+    Lazy& operator=(const Lazy& other)
+    {
+        if (this != &other) {
+            m_state.store(EMPTY, std::memory_order_relaxed);
+            CopyFrom(other);
+        }
+
+        return *this;
+    }
+
+    Lazy& operator=(Lazy&& other) noexcept
+    {
+        if (this != &other) {
+            m_state.store(EMPTY, std::memory_order_relaxed);
+            MoveFrom(other);
+        }
+
+        return *this;
+    }
+
+    template<typename Fn>
+    T Get(const Fn& compute) const
+    {
+        if (m_state.load(std::memory_order_acquire) == READY) {
+            return m_value;
+        }
+
+        T value = compute();
+
+        uint8_t expected = EMPTY;
+        if (m_state.compare_exchange_strong(expected, WRITING, std::memory_order_acq_rel)) {
+            m_value = value;
+            m_state.store(READY, std::memory_order_release);
+        }
+
+        return value;
+    }
+
+    //
+    // Same as Get(), but returns a reference to the stored value instead of a copy,
+    // which is valid for as long as the Lazy isn't assigned to or destroyed.
+    // A thread that loses the race to store the value waits for the winner to finish storing it.
+    //
+    template<typename Fn>
+    const T& GetRef(const Fn& compute) const
+    {
+        if (m_state.load(std::memory_order_acquire) == READY) {
+            return m_value;
+        }
+
+        T value = compute();
+
+        uint8_t expected = EMPTY;
+        if (m_state.compare_exchange_strong(expected, WRITING, std::memory_order_acq_rel)) {
+            m_value = std::move(value);
+            m_state.store(READY, std::memory_order_release);
+        } else {
+            while (m_state.load(std::memory_order_acquire) != READY) {
+                std::this_thread::yield();
+            }
+        }
+
+        return m_value;
+    }
+
+    bool IsSet() const noexcept { return m_state.load(std::memory_order_acquire) == READY; }
+
+private:
+    void CopyFrom(const Lazy& other)
+    {
+        if (other.m_state.load(std::memory_order_acquire) == READY) {
+            m_value = other.m_value;
+            m_state.store(READY, std::memory_order_release);
+        }
+    }
+
+    // Like any move, this must not race with other uses of the object being moved from.
+    void MoveFrom(Lazy& other) noexcept
+    {
+        if (other.m_state.load(std::memory_order_acquire) == READY) {
+            m_value = std::move(other.m_value);
+            m_state.store(READY, std::memory_order_release);
+            other.m_state.store(EMPTY, std::memory_order_release);
+        }
+    }
+
+    mutable std::atomic<uint8_t> m_state;
+    mutable T m_value;
+};
@@ -0,0 +1,171 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+//
+// Per-thread free lists for the small objects the node creates and destroys by the thousand per block
+// (UTXOs, rangeproofs, headers).
+//
+// Objects are still owned through std::shared_ptr, so nothing that holds a CPtr has to change,
+// but MakeShared allocates the object and its reference count together from a free list.
+// Freed blocks go back to the free list of whichever thread releases them, which is lock-free
+// and doesn't touch the global heap once the lists are warm.
+//
+class ObjectPool
+{
+public:
+    //
+    // Counts for the calling thread, since it started. Plain (non-atomic) counters,
+    // so take a copy before and after some work on the same thread to see what that work allocated.
+    //
+    struct Stats
+    {
+        uint64_t allocated{ 0 }; // Taken from the global heap, because the free list was empty.
+        uint64_t reused{ 0 };    // Taken from the free list.
+        uint64_t released{ 0 };  // Returned to the free list, or to the heap when the list was full.
+
+        uint64_t GetTotal() const noexcept { return allocated + reused; }
+
+        Stats operator-(const Stats& rhs) const noexcept
+        {
+            return Stats{ allocated - rhs.allocated, reused - rhs.reused, released - rhs.released };
+        }
+    };
+
+    static Stats GetThreadStats() noexcept { return GetStats(); }
+
+    template<typename T>
+    class Allocator
+    {
+    public:
+        using value_type = T;
+
+        Allocator() noexcept = default;
+        template<typename U>
+        Allocator(const Allocator<U>&) noexcept { }
+
+        T* allocate(const size_t n)
+        {
+            if (n != 1) {
+                return static_cast<T*>(::operator new(n * sizeof(T)));
+            }
+
+            return static_cast<T*>(FreeList<sizeof(T)>::Allocate());
+        }
+
+        void deallocate(T* p, const size_t n) noexcept
+        {
+            if (n != 1) {
+                ::operator delete(p);
+                return;
+            }
+
+            FreeList<sizeof(T)>::Release(p);
+        }
+
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned types aren't supported");
+
+        template<typename U>
+        bool operator==(const Allocator<U>&) const noexcept { return true; }
+        template<typename U>
+        bool operator!=(const Allocator<U>&) const noexcept { return false; }
+    };
+
+    //
+    // Same as std::make_shared, but allocated from the calling thread's free list.
+    //
+    template<typename T, typename... Args>
+    static std::shared_ptr<T> MakeShared(Args&&... args)
+    {
+        return std::allocate_shared<T>(Allocator<T>(), std::forward<Args>(args)...);
+    }
+
+private:
+    // Blocks beyond this go back to the heap, so a thread that frees more than it allocates doesn't hoard memory.
+    static constexpr size_t MAX_FREE_BLOCKS = 16384;
+
+    static Stats& GetStats() noexcept
+    {
+        static thread_local Stats stats;
+        return stats;
+    }
+
+    template<size_t SIZE>
+    class FreeList
+    {
+    public:
+        static void* Allocate()
+        {
+            return IsDestroyed() ? ::operator new(SIZE) : Get().Pop();
+        }
+
+        // Objects released after the thread's list is destroyed (e.g. by static destructors) go straight back to the heap.
+        static void Release(void* pBlock) noexcept
+        {
+            if (IsDestroyed()) {
+                ::operator delete(pBlock);
+            } else {
+                Get().Push(pBlock);
+            }
+        }
+
+        ~FreeList()
+        {
+            IsDestroyed() = true;
+            for (void* pBlock : m_blocks) {
+                ::operator delete(pBlock);
+            }
+        }
+
+    private:
+        static FreeList& Get()
+        {
+            static thread_local FreeList list;
+            return list;
+        }
+
+        static bool& IsDestroyed() noexcept
+        {
+            static thread_local bool destroyed = false;
+            return destroyed;
+        }
+
+        void* Pop()
+        {
+            if (m_blocks.empty()) {
+                ++GetStats().allocated;
+                return ::operator new(SIZE);
+            }
+
+            ++GetStats().reused;
+            void* pBlock = m_blocks.back();
+            m_blocks.pop_back();
+            return pBlock;
+        }
+
+        void Push(void* pBlock) noexcept
+        {
+            ++GetStats().released;
+            if (m_blocks.size() >= MAX_FREE_BLOCKS) {
+                ::operator delete(pBlock);
+                return;
+            }
+
+            try
+            {
+                m_blocks.push_back(pBlock);
+            }
+            catch (...)
+            {
+                ::operator delete(pBlock);
+            }
+        }
+
+        std::vector<void*> m_blocks;
+    };
+};
@@ -0,0 +1,196 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+//
+// A fixed-capacity map that's safe to use from multiple threads, for caching the results of expensive crypto.
+//
+// The keys are split across shards, each with its own lock, so concurrent lookups rarely contend.
+// When a shard is over its share of the capacity, its oldest entries are evicted.
+// The upper half of the key's hash picks the shard, while the buckets within a shard mostly depend on the lower half,
+// so the keys within a shard still spread across its buckets.
+//
+template<typename K, typename V, typename Hasher>
+class ShardedFifoCache
+{
+public:
+    struct Stats
+    {
+        uint64_t hits;
+        uint64_t misses;
+        uint64_t insertions;
+        uint64_t evictions;
+        size_t size;
+        size_t capacity;
+
+        double GetHitRate() const noexcept
+        {
+            return (hits + misses) == 0 ? 0.0 : (double)hits / (double)(hits + misses);
+        }
+    };
+
+    ShardedFifoCache(const size_t capacity, const size_t numShards, const Hasher& hasher = Hasher())
+        : m_hasher(hasher),
+        m_shards(std::max<size_t>(numShards, 1)),
+        m_capacity(capacity),
+        m_hits(0),
+        m_misses(0),
+        m_insertions(0),
+        m_evictions(0)
+    {
+        for (auto& pShard : m_shards) {
+            pShard = std::make_unique<Shard>(m_hasher);
+        }
+    }
+
+    bool Find(const K& key, V& value) const
+    {
+        const Shard& shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> readLock(shard.mutex);
+
+        auto iter = shard.entries.find(key);
+        const bool found = iter != shard.entries.end();
+        (found ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+        if (found) {
+            value = iter->second;
+        }
+
+        return found;
+    }
+
+    bool Contains(const K& key) const
+    {
+        const Shard& shard = GetShard(key);
+        std::shared_lock<std::shared_mutex> readLock(shard.mutex);
+
+        const bool found = shard.entries.count(key) > 0;
+        (found ? m_hits : m_misses).fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+
+    //
+    // Does nothing if the key is already cached.
+    //
+    void Insert(const K& key, const V& value)
+    {
+        const size_t shard_capacity = GetShardCapacity();
+        if (shard_capacity == 0) {
+            return;
+        }
+
+        Shard& shard = GetShard(key);
+        std::unique_lock<std::shared_mutex> writeLock(shard.mutex);
+
+        if (!shard.entries.insert({ key, value }).second) {
+            return;
+        }
+
+        shard.order.push_back(key);
+        m_insertions.fetch_add(1, std::memory_order_relaxed);
+        Trim(shard, shard_capacity);
+    }
+
+    //
+    // Changes the maximum number of entries, evicting the oldest ones if the cache is now over capacity.
+    //
+    void SetCapacity(const size_t capacity)
+    {
+        m_capacity = capacity;
+
+        const size_t shard_capacity = GetShardCapacity();
+        for (auto& pShard : m_shards) {
+            std::unique_lock<std::shared_mutex> writeLock(pShard->mutex);
+            Trim(*pShard, shard_capacity);
+        }
+    }
+
+    void Clear()
+    {
+        for (auto& pShard : m_shards) {
+            std::unique_lock<std::shared_mutex> writeLock(pShard->mutex);
+            pShard->entries.clear();
+            pShard->order.clear();
+        }
+    }
+
+    size_t GetSize() const
+    {
+        size_t size = 0;
+        for (const auto& pShard : m_shards) {
+            std::shared_lock<std::shared_mutex> readLock(pShard->mutex);
+            size += pShard->entries.size();
+        }
+
+        return size;
+    }
+
+    Stats GetStats() const
+    {
+        return Stats{
+            m_hits.load(std::memory_order_relaxed),
+            m_misses.load(std::memory_order_relaxed),
+            m_insertions.load(std::memory_order_relaxed),
+            m_evictions.load(std::memory_order_relaxed),
+            GetSize(),
+            m_capacity.load()
+        };
+    }
+
+    void ResetStats() noexcept
+    {
+        m_hits = 0;
+        m_misses = 0;
+        m_insertions = 0;
+        m_evictions = 0;
+    }
+
+private:
+    struct Shard
+    {
+        Shard(const Hasher& hasher) : entries(0, hasher) { }
+
+        mutable std::shared_mutex mutex;
+        std::unordered_map<K, V, Hasher> entries;
+        std::deque<K> order;
+    };
+
+    size_t GetShardIndex(const K& key) const noexcept
+    {
+        return (size_t)(((uint64_t)m_hasher(key) >> 32) % m_shards.size());
+    }
+
+    Shard& GetShard(const K& key) { return *m_shards[GetShardIndex(key)]; }
+    const Shard& GetShard(const K& key) const { return *m_shards[GetShardIndex(key)]; }
+
+    size_t GetShardCapacity() const noexcept
+    {
+        const size_t capacity = m_capacity;
+        return (capacity + m_shards.size() - 1) / m_shards.size();
+    }
+
+    void Trim(Shard& shard, const size_t shardCapacity)
+    {
+        while (shard.order.size() > shardCapacity) {
+            shard.entries.erase(shard.order.front());
+            shard.order.pop_front();
+            m_evictions.fetch_add(1, std::memory_order_relaxed);
+        }
+    }
+
+    const Hasher m_hasher;
+    std::vector<std::unique_ptr<Shard>> m_shards;
+    std::atomic<size_t> m_capacity;
+
+    mutable std::atomic<uint64_t> m_hits;
+    mutable std::atomic<uint64_t> m_misses;
+    std::atomic<uint64_t> m_insertions;
+    std::atomic<uint64_t> m_evictions;
+};
@@ -0,0 +1,122 @@
+#pragma once
+
+#include <mw/util/ThreadUtil.h>
+
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <exception>
+#include <functional>
+#include <condition_variable>
+
+//
+// Runs tasks, in the order they were added, on a single background thread.
+// The number of tasks waiting to run is bounded, so producers can't get too far ahead of the worker.
+//
+class TaskQueue
+{
+public:
+    using UPtr = std::unique_ptr<TaskQueue>;
+
+    static TaskQueue::UPtr Create(const size_t maxPending)
+    {
+        auto pQueue = std::unique_ptr<TaskQueue>(new TaskQueue(maxPending));
+        pQueue->m_thread = std::thread(TaskQueue::Worker, pQueue.get());
+        return pQueue;
+    }
+
+    //
+    // Runs all remaining tasks before returning.
+    //
+    ~TaskQueue()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_taskAdded.notify_all();
+        ThreadUtil::Join(m_thread);
+    }
+
+    //
+    // Adds the task to the end of the queue.
+    // Blocks while the queue already holds maxPending tasks that haven't started running.
+    //
+    void Enqueue(std::function<void()>&& task)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taskRemoved.wait(lock, [this] { return m_tasks.size() < m_maxPending; });
+
+        m_tasks.push_back(std::move(task));
+        m_taskAdded.notify_one();
+    }
+
+    //
+    // Blocks until every task that was enqueued has finished running.
+    // If any of those tasks threw, the first exception is rethrown here.
+    //
+    void Wait()
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_taskRemoved.wait(lock, [this] { return m_tasks.empty() && !m_running; });
+
+        if (m_pException != nullptr) {
+            std::exception_ptr pException = m_pException;
+            m_pException = nullptr;
+            std::rethrow_exception(pException);
+        }
+    }
+
+private:
+    TaskQueue(const size_t maxPending)
+        : m_maxPending(maxPending), m_stop(false), m_running(false) { }
+
+    static void Worker(TaskQueue* pQueue)
+    {
+        std::unique_lock<std::mutex> lock(pQueue->m_mutex);
+        while (true)
+        {
+            pQueue->m_taskAdded.wait(lock, [pQueue] { return pQueue->m_stop || !pQueue->m_tasks.empty(); });
+            if (pQueue->m_tasks.empty()) {
+                break;
+            }
+
+            std::function<void()> task = std::move(pQueue->m_tasks.front());
+            pQueue->m_tasks.pop_front();
+            pQueue->m_running = true;
+            pQueue->m_taskRemoved.notify_all();
+            lock.unlock();
+
+            std::exception_ptr pException = nullptr;
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+                pException = std::current_exception();
+            }
+
+            lock.lock();
+            if (pException != nullptr && pQueue->m_pException == nullptr) {
+                pQueue->m_pException = pException;
+            }
+
+            pQueue->m_running = false;
+            pQueue->m_taskRemoved.notify_all();
+        }
+    }
+
+    size_t m_maxPending;
+    bool m_stop;
+    bool m_running;
+    std::exception_ptr m_pException;
+    std::deque<std::function<void()>> m_tasks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::condition_variable m_taskRemoved;
+    std::thread m_thread;
+};
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <mw/util/ThreadUtil.h>
+
+#include <algorithm>
+#include <atomic>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <thread>
+#include <memory>
+#include <functional>
+#include <condition_variable>
+
+//
+// A fixed set of worker threads that run tasks in the order they were submitted.
+// Unlike TaskQueue, tasks may run concurrently, and there's no limit on how many can be waiting.
+//
+// Tasks must not block waiting on other tasks submitted to the same pool, since that can deadlock.
+// Exceptions thrown by tasks are swallowed, so tasks should report their own failures.
+//
+class ThreadPool
+{
+public:
+    //
+    // A pool with one thread per core, shared by everything that validates in parallel.
+    //
+    static ThreadPool& GetShared()
+    {
+        static ThreadPool pool((size_t)std::max(ThreadUtil::GetNumCores(), 1));
+        return pool;
+    }
+
+    explicit ThreadPool(const size_t numThreads)
+        : m_stop(false)
+    {
+        m_threads.reserve(numThreads);
+        for (size_t i = 0; i < numThreads; i++) {
+            m_threads.emplace_back(ThreadPool::Worker, this);
+        }
+    }
+
+    //
+    // Runs all remaining tasks before returning.
+    //
+    ~ThreadPool()
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_stop = true;
+        }
+
+        m_taskAdded.notify_all();
+        ThreadUtil::Join(m_threads);
+    }
+
+    void Submit(std::function<void()>&& task)
+    {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_tasks.push_back(std::move(task));
+        }
+
+        m_taskAdded.notify_one();
+    }
+
+    //
+    // Calls fn(i) for every i in [0, count), spread across the pool's threads and the calling thread.
+    // The calling thread works through the calls too, so this finishes even when every pool thread is busy.
+    // Once all calls return, the first exception thrown (if any) is rethrown.
+    //
+    template<typename Fn>
+    void ForEach(const size_t count, const Fn& fn)
+    {
+        // Shared with the pool's tasks, since those that don't start until all calls are claimed may outlive this call.
+        struct State
+        {
+            std::atomic<size_t> next{ 0 };
+            size_t completed{ 0 };
+            std::exception_ptr pException;
+            std::function<void(size_t)> fn;
+            std::mutex mutex;
+            std::condition_variable callComplete;
+        };
+
+        auto pState = std::make_shared<State>();
+        pState->fn = [&fn](const size_t i) { fn(i); };
+
+        // fn is only called for claimed indices, and this doesn't return until they've all completed.
+        auto run = [count](State& state) {
+            for (size_t i = state.next++; i < count; i = state.next++) {
+                std::exception_ptr pException = nullptr;
+                try
+                {
+                    state.fn(i);
+                }
+                catch (...)
+                {
+                    pException = std::current_exception();
+                }
+
+                std::unique_lock<std::mutex> lock(state.mutex);
+                if (state.pException == nullptr) {
+                    state.pException = pException;
+                }
+
+                ++state.completed;
+                state.callComplete.notify_all();
+            }
+        };
+
+        const size_t num_tasks = count > 1 ? std::min(count - 1, m_threads.size()) : 0;
+        for (size_t i = 0; i < num_tasks; i++) {
+            Submit([pState, run]() { run(*pState); });
+        }
+
+        run(*pState);
+
+        std::unique_lock<std::mutex> lock(pState->mutex);
+        pState->callComplete.wait(lock, [&pState, count] { return pState->completed == count; });
+
+        if (pState->pException != nullptr) {
+            std::rethrow_exception(pState->pException);
+        }
+    }
+
+    size_t GetNumThreads() const noexcept { return m_threads.size(); }
+
+private:
+    static void Worker(ThreadPool* pPool)
+    {
+        std::unique_lock<std::mutex> lock(pPool->m_mutex);
+        while (true)
+        {
+            pPool->m_taskAdded.wait(lock, [pPool] { return pPool->m_stop || !pPool->m_tasks.empty(); });
+            if (pPool->m_tasks.empty()) {
+                break;
+            }
+
+            std::function<void()> task = std::move(pPool->m_tasks.front());
+            pPool->m_tasks.pop_front();
+            lock.unlock();
+
+            try
+            {
+                task();
+            }
+            catch (...)
+            {
+
+            }
+
+            lock.lock();
+        }
+    }
+
+    bool m_stop;
+    std::deque<std::function<void()>> m_tasks;
+
+    std::mutex m_mutex;
+    std::condition_variable m_taskAdded;
+    std::vector<std::thread> m_threads;
+};
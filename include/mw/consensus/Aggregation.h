@@ -2,6 +2,7 @@
 
 #include <mw/models/tx/Transaction.h>
 #include <mw/consensus/CutThrough.h>
+#include <mw/util/ParallelUtil.h>
 #include <cassert>
 
 static struct
@@ -28,35 +29,71 @@ public:
             return transactions.front();
         }
 
+        size_t numInputs = 0, numOutputs = 0, numKernels = 0;
+        for (const mw::Transaction::CPtr& pTransaction : transactions) {
+            numInputs += pTransaction->GetInputs().size();
+            numOutputs += pTransaction->GetOutputs().size();
+            numKernels += pTransaction->GetKernels().size();
+        }
+
         std::vector<Input> inputs;
         std::vector<Output> outputs;
         std::vector<Kernel> kernels;
         std::vector<BlindingFactor> kernelOffsets;
+        inputs.reserve(numInputs);
+        outputs.reserve(numOutputs);
+        kernels.reserve(numKernels);
+        kernelOffsets.reserve(transactions.size());
 
         // collect all the inputs, outputs and kernels from the txs
         for (const mw::Transaction::CPtr& pTransaction : transactions) {
-            for (const Input& input : pTransaction->GetInputs()) {
-                inputs.push_back(input);
-            }
+            inputs.insert(inputs.end(), pTransaction->GetInputs().cbegin(), pTransaction->GetInputs().cend());
+            outputs.insert(outputs.end(), pTransaction->GetOutputs().cbegin(), pTransaction->GetOutputs().cend());
+            kernels.insert(kernels.end(), pTransaction->GetKernels().cbegin(), pTransaction->GetKernels().cend());
+            kernelOffsets.push_back(pTransaction->GetOffset());
+        }
 
-            for (const Output& output : pTransaction->GetOutputs()) {
-                outputs.push_back(output);
-            }
+        return Build(std::move(inputs), std::move(outputs), std::move(kernels), kernelOffsets);
+    }
 
-            for (const Kernel& kernel : pTransaction->GetKernels()) {
-                kernels.push_back(kernel);
-            }
+private:
+    //
+    // Same order as sorting with SortByHash, but each hash is only fetched once,
+    // and only the (hash, index) pairs are moved around while sorting.
+    //
+    template<typename T>
+    static void SortByHashParallel(std::vector<T>& items)
+    {
+        std::vector<std::pair<mw::Hash, size_t>> keys;
+        keys.reserve(items.size());
+        for (size_t i = 0; i < items.size(); i++) {
+            keys.push_back({ items[i].GetHash(), i });
+        }
 
-            kernelOffsets.push_back(pTransaction->GetOffset());
+        ParallelUtil::Sort(keys, [](const auto& a, const auto& b) { return a.first < b.first; });
+
+        std::vector<T> sorted;
+        sorted.reserve(items.size());
+        for (const auto& key : keys) {
+            sorted.push_back(std::move(items[key.second]));
         }
 
+        items = std::move(sorted);
+    }
+
+    static mw::Transaction::CPtr Build(
+        std::vector<Input>&& inputs,
+        std::vector<Output>&& outputs,
+        std::vector<Kernel>&& kernels,
+        const std::vector<BlindingFactor>& kernelOffsets)
+    {
         // Perform cut-through
         CutThrough::PerformCutThrough(inputs, outputs);
 
-        // Sort the kernels.
-        std::sort(kernels.begin(), kernels.end(), SortByHash);
-        std::sort(inputs.begin(), inputs.end(), SortByHash);
-        std::sort(outputs.begin(), outputs.end(), SortByHash);
+        // Sort the kernels, inputs and outputs.
+        SortByHashParallel(kernels);
+        SortByHashParallel(inputs);
+        SortByHashParallel(outputs);
 
         // Sum the kernel_offsets up to give us an aggregate offset for the transaction.
         BlindingFactor offset = Crypto::AddBlindingFactors(kernelOffsets);
@@ -71,4 +108,4 @@ public:
             TxBody{ std::move(inputs), std::move(outputs), std::move(kernels) }
         );
     }
-};
\ No newline at end of file
+};
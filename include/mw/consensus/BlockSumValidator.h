@@ -2,6 +2,9 @@
 
 #include <mw/exceptions/ValidationException.h>
 #include <mw/crypto/Crypto.h>
+#include <mw/crypto/CommitmentSum.h>
+#include <mw/models/block/Header.h>
+#include <mw/models/block/StateAggregates.h>
 #include <mw/models/tx/TxBody.h>
 #include <mw/models/tx/Transaction.h>
 #include <mw/models/tx/UTXO.h>
@@ -14,24 +17,27 @@ public:
     // Makes sure the sums of all utxo commitments minus the total supply
     // equals the sum of all kernel excesses and the total offset.
     // This is to be used only when validating the entire state.
+    // Returns the state's running totals, so they can be kept up to date from here on.
     //
     // Throws a ValidationException if the utxo sum != kernel sum.
-    static void ValidateState(
+    static mw::StateAggregates ValidateState(
+        const mw::Header::CPtr& pHeader,
         const std::vector<UTXO::CPtr>& utxos,
-        const std::vector<Kernel>& kernels,
-        const BlindingFactor& total_offset)
+        const std::vector<Kernel>& kernels)
     {
-        // Sum all utxo commitments - expected supply.
-        std::vector<Commitment> utxo_commitments;
-        std::transform(
-            utxos.cbegin(), utxos.cend(),
-            std::back_inserter(utxo_commitments),
-            [](const UTXO::CPtr& pUTXO) { return pUTXO->GetCommitment(); }
-        );
+        // There can be millions of UTXOs, so they're streamed into a CommitmentSum, which sums them on all cores.
+        CommitmentSum utxo_sum;
+        for (const UTXO::CPtr& pUTXO : utxos)
+        {
+            utxo_sum.Add(pUTXO->GetCommitment());
+        }
 
         uint64_t total_mw_supply = 0;
+        CommitmentSum excess_sum;
         for (const Kernel& kernel : kernels)
         {
+            excess_sum.Add(kernel.GetCommitment());
+
             if (kernel.IsPegIn()) {
                 total_mw_supply += kernel.GetAmount();
             } else if (kernel.IsPegOut()) {
@@ -43,25 +49,41 @@ public:
             }
         }
 
-        Commitment total_utxo_commitment = Crypto::AddCommitments(
-            utxo_commitments,
-            { Crypto::CommitTransparent(total_mw_supply) }
-        );
+        mw::StateAggregates aggregates(pHeader->GetHash(), utxo_sum.Total(), excess_sum.Total(), total_mw_supply);
+        ValidateAggregates(aggregates, pHeader->GetOffset());
+        return aggregates;
+    }
 
-        // Sum the kernel excesses accounting for the kernel offset.
-        std::vector<Commitment> kernel_excess_commitments;
-        std::transform(
-            kernels.cbegin(), kernels.cend(),
-            std::back_inserter(kernel_excess_commitments),
-            [](const Kernel& kernel) { return kernel.GetCommitment(); }
-        );
+    //
+    // Makes sure the state's running totals balance: the utxo sum minus the total supply
+    // must equal the kernel excess sum plus the total offset.
+    // This is constant time, so unlike ValidateState, it can be done on every startup.
+    //
+    // Throws a ValidationException if the utxo sum != kernel sum.
+    //
+    static void ValidateAggregates(const mw::StateAggregates& aggregates, const BlindingFactor& total_offset)
+    {
+        // A zero sum means the point at infinity, which CommitmentSum can't be given.
+        CommitmentSum utxo_sum;
+        if (!aggregates.GetUTXOSum().IsZero()) {
+            utxo_sum.Add(aggregates.GetUTXOSum());
+        }
 
-        if (!total_offset.IsZero()) {
-            kernel_excess_commitments.push_back(Crypto::CommitBlinded((uint64_t)0, total_offset));
+        if (aggregates.GetPeggedSupply() > 0) {
+            utxo_sum.Subtract(Crypto::CommitTransparent(aggregates.GetPeggedSupply()));
+        }
+
+        CommitmentSum excess_sum;
+        if (!aggregates.GetKernelSum().IsZero()) {
+            excess_sum.Add(aggregates.GetKernelSum());
         }
 
-        Commitment total_excess_commitment =  Crypto::AddCommitments(kernel_excess_commitments);
+        if (!total_offset.IsZero()) {
+            excess_sum.Add(Crypto::CommitBlinded((uint64_t)0, total_offset));
+        }
 
+        const Commitment& total_utxo_commitment = utxo_sum.Total();
+        const Commitment& total_excess_commitment = excess_sum.Total();
         if (total_utxo_commitment != total_excess_commitment) {
             LOG_ERROR_F(
                 "UTXO sum {} does not match kernel excess sum {}.",
@@ -1,8 +1,17 @@
 #pragma once
 
 #include <cstdint>
+#include <cstddef>
 
 namespace Consensus
 {
+    //
+    // Weights are used to limit the size of blocks, since their serialized size
+    // is dominated by outputs, which carry a rangeproof.
+    //
+    static constexpr size_t INPUT_WEIGHT = 1;
+    static constexpr size_t OUTPUT_WEIGHT = 18;
+    static constexpr size_t KERNEL_WEIGHT = 2;
 
-}
\ No newline at end of file
+    static constexpr size_t MAX_BLOCK_WEIGHT = 200'000;
+}
@@ -3,40 +3,47 @@
 #include <mw/models/tx/Input.h>
 #include <mw/models/tx/Output.h>
 #include <mw/exceptions/ValidationException.h>
+#include <mw/util/ParallelUtil.h>
 #include <unordered_set>
 
 class CutThrough
 {
 public:
+    //
+    // Removes inputs spending outputs in the same set, along with those outputs.
+    // Both sides are sorted by commitment and walked in a single merge, so this is O(n log n),
+    // and the remaining inputs and outputs keep their original order.
+    //
     static void PerformCutThrough(std::vector<Input>& inputs, std::vector<Output>& outputs)
     {
-        std::unordered_set<Commitment> inputCommitments;
-        for (const Input& input : inputs) {
-            inputCommitments.insert(input.GetCommitment());
-        }
+        std::vector<std::pair<const Commitment*, size_t>> sortedInputs = SortByCommitment(inputs);
+        std::vector<std::pair<const Commitment*, size_t>> sortedOutputs = SortByCommitment(outputs);
 
-        std::unordered_set<Commitment> outputCommitments;
-        for (const Output& output : outputs) {
-            outputCommitments.insert(output.GetCommitment());
-        }
+        std::vector<bool> inputsToRemove(inputs.size(), false);
+        std::vector<bool> outputsToRemove(outputs.size(), false);
 
-        auto inputIter = inputs.begin();
-        while (inputIter != inputs.end()) {
-            if (outputCommitments.find(inputIter->GetCommitment()) != outputCommitments.end()) {
-                inputIter = inputs.erase(inputIter);
-            } else {
+        auto inputIter = sortedInputs.cbegin();
+        auto outputIter = sortedOutputs.cbegin();
+        while (inputIter != sortedInputs.cend() && outputIter != sortedOutputs.cend()) {
+            if (*inputIter->first < *outputIter->first) {
                 ++inputIter;
-            }
-        }
-
-        auto outputIter = outputs.begin();
-        while (outputIter != outputs.end()) {
-            if (inputCommitments.find(outputIter->GetCommitment()) != inputCommitments.end()) {
-                outputIter = outputs.erase(outputIter);
-            } else {
+            } else if (*outputIter->first < *inputIter->first) {
                 ++outputIter;
+            } else {
+                // Remove every input and output with the matching commitment.
+                const Commitment& commitment = *inputIter->first;
+                for (; inputIter != sortedInputs.cend() && *inputIter->first == commitment; ++inputIter) {
+                    inputsToRemove[inputIter->second] = true;
+                }
+
+                for (; outputIter != sortedOutputs.cend() && *outputIter->first == commitment; ++outputIter) {
+                    outputsToRemove[outputIter->second] = true;
+                }
             }
         }
+
+        RemoveFlagged(inputs, inputsToRemove);
+        RemoveFlagged(outputs, outputsToRemove);
     }
 
     static void VerifyCutThrough(const std::vector<Input>& inputs, const std::vector<Output>& outputs)
@@ -63,4 +70,38 @@ public:
             ThrowValidation(EConsensusError::CUT_THROUGH);
         }
     }
+
+private:
+    template<typename T>
+    static std::vector<std::pair<const Commitment*, size_t>> SortByCommitment(const std::vector<T>& committed)
+    {
+        std::vector<std::pair<const Commitment*, size_t>> sorted;
+        sorted.reserve(committed.size());
+        for (size_t i = 0; i < committed.size(); i++) {
+            sorted.push_back({ &committed[i].GetCommitment(), i });
+        }
+
+        ParallelUtil::Sort(
+            sorted,
+            [](const auto& a, const auto& b) { return *a.first < *b.first; }
+        );
+        return sorted;
+    }
+
+    template<typename T>
+    static void RemoveFlagged(std::vector<T>& vec, const std::vector<bool>& flagged)
+    {
+        size_t kept = 0;
+        for (size_t i = 0; i < vec.size(); i++) {
+            if (!flagged[i]) {
+                if (kept != i) {
+                    vec[kept] = std::move(vec[i]);
+                }
+
+                ++kept;
+            }
+        }
+
+        vec.erase(vec.begin() + kept, vec.end());
+    }
 };
\ No newline at end of file
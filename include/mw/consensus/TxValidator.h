@@ -1,13 +1,73 @@
 #pragma once
 
 #include <mw/models/tx/Transaction.h>
+#include <mw/consensus/BlockSumValidator.h>
+#include <mw/consensus/CutThrough.h>
+#include <mw/exceptions/ValidationException.h>
+#include <unordered_set>
 
+//
+// Context-free validation of a transaction, for acceptance to the mempool.
+// Checks are ordered from cheapest to most expensive, so invalid transactions are rejected as early as possible:
+//   1. Structure: weight, kernels, duplicate inputs and outputs, and cut-through.
+//   2. Sums: inputs, outputs, and pegs balance with the kernel excesses and offset.
+//   3. Kernel signatures, batch verified.
+//   4. Rangeproofs, batch verified.
+//
+// A transaction that passes is marked as validated. Blocks built only from validated transactions
+// are marked as validated too (see CoinsViewCache::BuildNextBlock), so the signatures and rangeproofs
+// aren't verified a second time.
+//
 class TransactionValidator
 {
 public:
-	void Validate(const Transaction& transaction) const;
+    TransactionValidator() = default;
+
+    void Validate(const mw::Transaction::Ptr& pTransaction) const
+    {
+        assert(pTransaction != nullptr);
+
+        if (pTransaction->WasValidated()) {
+            return;
+        }
+
+        ValidateFeatures(pTransaction->GetBody());
+        ValidateKernelSums(*pTransaction);
+        pTransaction->GetBody().Validate();
+
+        pTransaction->MarkAsValidated();
+    }
 
 private:
-	void ValidateFeatures(const TxBody& transactionBody) const;
-	void ValidateKernelSums(const Transaction& transaction) const;
-};
\ No newline at end of file
+    void ValidateFeatures(const TxBody& transactionBody) const
+    {
+        if (transactionBody.GetKernels().empty()) {
+            ThrowValidation(EConsensusError::BLOCK_SUMS);
+        }
+
+        if (transactionBody.GetWeight() > Consensus::MAX_BLOCK_WEIGHT) {
+            ThrowValidation(EConsensusError::BLOCK_WEIGHT);
+        }
+
+        std::unordered_set<Commitment> inputs;
+        for (const Input& input : transactionBody.GetInputs()) {
+            if (!inputs.insert(input.GetCommitment()).second) {
+                ThrowValidation(EConsensusError::DOUBLE_SPEND);
+            }
+        }
+
+        std::unordered_set<Commitment> outputs;
+        for (const Output& output : transactionBody.GetOutputs()) {
+            if (!outputs.insert(output.GetCommitment()).second) {
+                ThrowValidation(EConsensusError::DUPLICATE_OUTPUT);
+            }
+        }
+
+        CutThrough::VerifyCutThrough(transactionBody.GetInputs(), transactionBody.GetOutputs());
+    }
+
+    void ValidateKernelSums(const mw::Transaction& transaction) const
+    {
+        BlockSumValidator::ValidateForTx(transaction);
+    }
+};
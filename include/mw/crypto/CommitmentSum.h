@@ -0,0 +1,41 @@
+#pragma once
+
+#include <mw/models/crypto/Commitment.h>
+
+#include <vector>
+
+//
+// Sums a large number of commitments, such as every UTXO in the state, using all cores.
+//
+// Commitments are added one at a time, so the caller never has to collect them into a single vector.
+// They're buffered until a batch is full, then the batch is split across threads,
+// and the per-thread partial sums are combined pairwise in a tree.
+//
+// Unlike Crypto::AddCommitments, a sum that cancels out is not an error: Total() just returns a zero commitment.
+//
+class CommitmentSum
+{
+public:
+    static constexpr size_t DEFAULT_BATCH_SIZE = 65'536;
+
+    explicit CommitmentSum(const size_t batchSize = DEFAULT_BATCH_SIZE);
+
+    void Add(const Commitment& commitment);
+    void Subtract(const Commitment& commitment);
+
+    //
+    // Sums any buffered commitments, and returns the total so far.
+    // Throws a CryptoException if any of the commitments were invalid, including zero commitments.
+    //
+    const Commitment& Total();
+
+private:
+    void Flush();
+
+    size_t m_batchSize;
+    std::vector<Commitment> m_positive;
+    std::vector<Commitment> m_negative;
+
+    // Zero when nothing has been added yet, or when the sum is the point at infinity.
+    Commitment m_total;
+};
@@ -125,7 +125,7 @@ public:
     );
 
     //
-    //
+    // Verifies the rangeproofs, skipping any found in the shared VerificationCache.
     //
     static bool VerifyRangeProofs(
         const std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>>& rangeProofs
@@ -9,9 +9,21 @@ static mw::Hash Hashed(const std::vector<uint8_t>& serialized)
     return mw::Hash(SerializeHash(serialized).begin());
 }
 
+//
+// Same as Hashed(std::vector<uint8_t>(pData, pData + length)), without copying the bytes,
+// e.g. for hashing an element of a serialized block in place.
+//
+static mw::Hash Hashed(const uint8_t* pData, const size_t length)
+{
+    CHashWriter writer(SER_GETHASH, PROTOCOL_VERSION);
+    WriteCompactSize(writer, length);
+    writer.write((const char*)pData, length);
+    return mw::Hash(writer.GetHash().begin());
+}
+
 static mw::Hash Hashed(const Traits::ISerializable& serializable)
 {
-    Serializer serializer;
+    Serializer serializer(serializable.GetSerializedSize());
     serializable.Serialize(serializer);
     return mw::Hash(SerializeHash(serializer.vec()).begin());
 }
\ No newline at end of file
@@ -23,6 +23,10 @@ public:
         const mw::Hash& message
     );
 
+    //
+    // Verifies the signatures against their commitments, skipping any found in the shared VerificationCache.
+    // If all are valid, they're added to the cache.
+    //
     static bool BatchVerify(
         const std::vector<std::tuple<Signature, Commitment, mw::Hash>>& signatures
     );
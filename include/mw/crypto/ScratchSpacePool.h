@@ -0,0 +1,134 @@
+#pragma once
+
+#include <mw/crypto/secp256k1.h>
+#include <mw/exceptions/CryptoException.h>
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+//
+// Keeps secp256k1 scratch spaces around for reuse, instead of creating and destroying one for every call.
+//
+// A scratch space only bounds how much memory may be used: secp256k1 allocates each frame when it's needed,
+// sized for the actual batch, and frees it again before returning. So the max size is a cap, not an allocation.
+// Scratch spaces refer to the error callback of the context they were created with,
+// so they're only handed out again for the same context. That context must outlive the pool,
+// so acquire them for the shared context, even when the call itself uses a thread's randomized copy of it.
+//
+class ScratchSpacePool
+{
+public:
+    // Upper bound on the memory a single verification may use.
+    static constexpr size_t MAX_SCRATCH_SIZE = 256 * (1 << 20);
+
+    // Idle scratch spaces beyond this are destroyed when released.
+    static constexpr size_t MAX_IDLE = 64;
+
+    struct Stats
+    {
+        size_t acquired;
+        size_t created;
+        size_t inUse;
+        size_t peakInUse;
+    };
+
+    //
+    // Returns the scratch space to the pool when destroyed.
+    //
+    class Handle
+    {
+    public:
+        Handle(ScratchSpacePool& pool, const secp256k1_context* pContext, secp256k1_scratch_space* pScratch)
+            : m_pool(pool), m_pContext(pContext), m_pScratch(pScratch) { }
+        Handle(const Handle&) = delete;
+        Handle& operator=(const Handle&) = delete;
+        ~Handle() { m_pool.Release(m_pContext, m_pScratch); }
+
+        secp256k1_scratch_space* Get() const noexcept { return m_pScratch; }
+
+    private:
+        ScratchSpacePool& m_pool;
+        const secp256k1_context* m_pContext;
+        secp256k1_scratch_space* m_pScratch;
+    };
+
+    static ScratchSpacePool& GetShared()
+    {
+        static ScratchSpacePool pool;
+        return pool;
+    }
+
+    ~ScratchSpacePool()
+    {
+        for (const IdleScratch& idle : m_idle) {
+            secp256k1_scratch_space_destroy(idle.pScratch);
+        }
+    }
+
+    Handle Acquire(const secp256k1_context* pContext)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        ++m_stats.acquired;
+        m_stats.peakInUse = std::max(m_stats.peakInUse, ++m_stats.inUse);
+
+        auto iter = std::find_if(
+            m_idle.begin(), m_idle.end(),
+            [pContext](const IdleScratch& idle) { return idle.pContext == pContext; }
+        );
+        if (iter != m_idle.end()) {
+            secp256k1_scratch_space* pScratch = iter->pScratch;
+            m_idle.erase(iter);
+            return Handle(*this, pContext, pScratch);
+        }
+
+        ++m_stats.created;
+        lock.unlock();
+
+        secp256k1_scratch_space* pScratch = secp256k1_scratch_space_create(pContext, MAX_SCRATCH_SIZE);
+        if (pScratch == nullptr) {
+            Release(pContext, nullptr);
+            ThrowCrypto("Failed to create scratch space");
+        }
+
+        return Handle(*this, pContext, pScratch);
+    }
+
+    Stats GetStats() const
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        return m_stats;
+    }
+
+private:
+    ScratchSpacePool()
+        : m_stats{ 0, 0, 0, 0 } { }
+
+    struct IdleScratch
+    {
+        const secp256k1_context* pContext;
+        secp256k1_scratch_space* pScratch;
+    };
+
+    void Release(const secp256k1_context* pContext, secp256k1_scratch_space* pScratch)
+    {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        --m_stats.inUse;
+
+        if (pScratch == nullptr) {
+            return;
+        }
+
+        if (m_idle.size() < MAX_IDLE) {
+            m_idle.push_back(IdleScratch{ pContext, pScratch });
+        } else {
+            lock.unlock();
+            secp256k1_scratch_space_destroy(pScratch);
+        }
+    }
+
+    mutable std::mutex m_mutex;
+    std::vector<IdleScratch> m_idle;
+    Stats m_stats;
+};
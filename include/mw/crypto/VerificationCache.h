@@ -0,0 +1,122 @@
+#pragma once
+
+#include <mw/common/ShardedFifoCache.h>
+#include <mw/crypto/Random.h>
+#include <crypto/sha256.h>
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <vector>
+
+//
+// Remembers what has already been verified (kernel signatures, rangeproofs), so that transactions
+// verified on their way into the mempool don't have to be verified again when they show up in a block.
+//
+// Entries are keyed by a salted SHA256 of everything that went into the verification, so a hit means
+// the exact same data was verified before. The salt is random per cache, so keys can't be predicted,
+// and no one can craft entries that all land in the same shard (see ShardedFifoCache).
+//
+class VerificationCache
+{
+public:
+    using Key = std::array<uint8_t, CSHA256::OUTPUT_SIZE>;
+
+    static constexpr size_t DEFAULT_SIGNATURE_CAPACITY = 100'000;
+    static constexpr size_t DEFAULT_RANGEPROOF_CAPACITY = 100'000;
+    static constexpr size_t DEFAULT_NUM_SHARDS = 16;
+
+private:
+    // Keys are already uniformly distributed (salted SHA256), so any 8 bytes make a good hash.
+    struct KeyHasher
+    {
+        size_t operator()(const Key& key) const noexcept
+        {
+            size_t hash;
+            std::memcpy(&hash, key.data(), sizeof(hash));
+            return hash;
+        }
+    };
+
+    // Only the keys matter.
+    struct Verified { };
+
+    using Cache = ShardedFifoCache<Key, Verified, KeyHasher>;
+
+public:
+    using Stats = Cache::Stats;
+
+    //
+    // Builds a key by hashing the salt and each appended field, prefixed with its length.
+    //
+    class KeyBuilder
+    {
+    public:
+        KeyBuilder(const Key& salt) { m_sha256.Write(salt.data(), salt.size()); }
+
+        KeyBuilder& Append(const uint8_t* pData, const size_t length)
+        {
+            const uint64_t length64 = length;
+            m_sha256.Write((const uint8_t*)&length64, sizeof(length64));
+            m_sha256.Write(pData, length);
+            return *this;
+        }
+
+        KeyBuilder& Append(const std::vector<uint8_t>& data) { return Append(data.data(), data.size()); }
+
+        Key Build()
+        {
+            Key key;
+            m_sha256.Finalize(key.data());
+            return key;
+        }
+
+    private:
+        CSHA256 m_sha256;
+    };
+
+    //
+    // The caches shared by Schnorr::BatchVerify and Crypto::VerifyRangeProofs.
+    //
+    static VerificationCache& GetSignatureCache()
+    {
+        static VerificationCache cache(DEFAULT_SIGNATURE_CAPACITY);
+        return cache;
+    }
+
+    static VerificationCache& GetRangeProofCache()
+    {
+        static VerificationCache cache(DEFAULT_RANGEPROOF_CAPACITY);
+        return cache;
+    }
+
+    explicit VerificationCache(const size_t capacity, const size_t numShards = DEFAULT_NUM_SHARDS)
+        : m_salt(RandomSalt()), m_cache(capacity, numShards) { }
+
+    KeyBuilder NewKey() const { return KeyBuilder(m_salt); }
+
+    bool Contains(const Key& key) const { return m_cache.Contains(key); }
+    void Insert(const Key& key) { m_cache.Insert(key, Verified{}); }
+
+    //
+    // Changes the maximum number of entries, evicting the oldest ones if the cache is now over capacity.
+    //
+    void SetCapacity(const size_t capacity) { m_cache.SetCapacity(capacity); }
+
+    void Clear() { m_cache.Clear(); }
+
+    Stats GetStats() const { return m_cache.GetStats(); }
+    void ResetStats() noexcept { m_cache.ResetStats(); }
+
+private:
+    static Key RandomSalt()
+    {
+        Key salt;
+        const SecretKey random = Random::CSPRNG<32>();
+        std::copy(random.data(), random.data() + salt.size(), salt.begin());
+        return salt;
+    }
+
+    const Key m_salt;
+    Cache m_cache;
+};
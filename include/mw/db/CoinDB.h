@@ -2,6 +2,8 @@
 
 #include <mw/models/crypto/Commitment.h>
 #include <mw/models/tx/UTXO.h>
+#include <mw/models/block/StateAggregates.h>
+#include <functional>
 #include <libmw/interfaces.h>
 #include <unordered_map>
 
@@ -42,6 +44,18 @@ public:
 	//
 	void RemoveAllUTXOs();
 
+	//
+	// Calls fn for every UTXO in the database (not including any in an uncommitted batch).
+	//
+	void ForEachUTXO(const std::function<void(const UTXO&)>& fn) const;
+
+	//
+	// The state's running totals, as of the last flushed header.
+	// Returns nullptr if they were never written.
+	//
+	mw::StateAggregates::CPtr GetAggregates() const;
+	void WriteAggregates(const mw::StateAggregates::CPtr& pAggregates);
+
 private:
 	std::unique_ptr<Database> m_pDatabase;
 };
\ No newline at end of file
@@ -0,0 +1,33 @@
+#pragma once
+
+#include <mw/exceptions/LTCException.h>
+#include <mw/models/block/BlockUndo.h>
+
+#include <exception>
+#include <vector>
+
+//
+// Thrown by INode::ConnectBlocks when a block fails to connect.
+// Every block before it is connected, and their BlockUndos are carried here so they can still be disconnected.
+//
+class ConnectBlocksException : public LTCException
+{
+public:
+    ConnectBlocksException(
+        const std::string& message,
+        const std::string& function,
+        std::vector<mw::BlockUndo::CPtr>&& undos,
+        const std::exception_ptr& pCause)
+        : LTCException("ConnectBlocksException", message, function), m_undos(std::move(undos)), m_pCause(pCause) { }
+
+    // The BlockUndos of the connected blocks, in the same order as the blocks. The failed block's index is undos.size().
+    const std::vector<mw::BlockUndo::CPtr>& GetUndos() const noexcept { return m_undos; }
+    size_t GetFailedIndex() const noexcept { return m_undos.size(); }
+
+    // The exception the failed block threw, e.g. a ValidationException.
+    const std::exception_ptr& GetCause() const noexcept { return m_pCause; }
+
+private:
+    std::vector<mw::BlockUndo::CPtr> m_undos;
+    std::exception_ptr m_pCause;
+};
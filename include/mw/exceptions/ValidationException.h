@@ -15,7 +15,9 @@ enum class EConsensusError
     PEGIN_MISMATCH,
     PEGOUT_MISMATCH,
     MMR_MISMATCH,
-	UTXO_MISSING
+	UTXO_MISSING,
+    DOUBLE_SPEND,
+    DUPLICATE_OUTPUT
 };
 
 class ValidationException : public LTCException
@@ -55,6 +57,10 @@ private:
 				return "MMR_MISMATCH";
 			case EConsensusError::UTXO_MISSING:
 				return "UTXO_MISSING";
+            case EConsensusError::DOUBLE_SPEND:
+                return "DOUBLE_SPEND";
+            case EConsensusError::DUPLICATE_OUTPUT:
+                return "DUPLICATE_OUTPUT";
         }
 
         return "UNKNOWN";
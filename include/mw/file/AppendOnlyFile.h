@@ -64,6 +64,11 @@ public:
         m_buffer.insert(m_buffer.end(), data.cbegin(), data.cend());
     }
 
+    void Append(const uint8_t* pData, const size_t numBytes)
+    {
+        m_buffer.insert(m_buffer.end(), pData, pData + numBytes);
+    }
+
     void Rewind(const uint64_t nextPosition)
     {
         assert(m_fileSize == m_bufferIndex);
@@ -109,6 +114,26 @@ public:
         }
     }
 
+    //
+    // Like Read, but copies into the caller's buffer instead of allocating a vector.
+    //
+    void Read(const uint64_t position, const uint64_t numBytes, uint8_t* pOut) const
+    {
+        if ((position + numBytes) > (m_bufferIndex + m_buffer.size()))
+        {
+            ThrowFile_F("Tried to read past end of {}", m_file);
+        }
+
+        if (position < m_bufferIndex)
+        {
+            m_mmap.Read(position, numBytes, pOut);
+        }
+        else
+        {
+            memcpy(pOut, m_buffer.data() + position - m_bufferIndex, numBytes);
+        }
+    }
+
 private:
     File m_file;
     MemMap m_mmap;
@@ -10,6 +10,7 @@
 
 #include <mw/file/File.h>
 #include <cassert>
+#include <cstring>
 
 class MemMap
 {
@@ -49,6 +50,12 @@ public:
         return std::vector<uint8_t>(m_mmap.cbegin() + position, m_mmap.cbegin() + position + numBytes);
     }
 
+    void Read(const size_t position, const size_t numBytes, uint8_t* pOut) const
+    {
+        assert(m_mapped);
+        memcpy(pOut, m_mmap.data() + position, numBytes);
+    }
+
     uint8_t ReadByte(const size_t position) const
     {
         assert(m_mapped);
@@ -20,7 +20,7 @@ public:
 
     static Leaf Create(const LeafIndex& index, std::vector<uint8_t>&& data)
     {
-        Serializer hashSerializer;
+        Serializer hashSerializer(sizeof(uint64_t) + data.size());
         hashSerializer.Append<uint64_t>(index.GetPosition());
         hashSerializer.Append(data);
         mw::Hash hash = Hashed(hashSerializer.vec());
@@ -6,6 +6,9 @@
 #include <mw/models/crypto/Hash.h>
 #include <mw/mmr/LeafIndex.h>
 #include <mw/traits/Batchable.h>
+#include <mw/util/MemoryUtil.h>
+#include <deque>
+#include <shared_mutex>
 #include <unordered_map>
 
 class ILeafSetBackend;
@@ -41,6 +44,10 @@ protected:
 	mmr::LeafIndex m_nextLeafIdx;
 };
 
+//
+// The leafset stored in a memory-mapped file.
+// Reads may happen concurrently with updates, so a cache can keep reading while a snapshot is written.
+//
 class LeafSet : public ILeafSet
 {
 public:
@@ -59,8 +66,14 @@ private:
 	LeafSet(MemMap&& mmap, const mmr::LeafIndex& nextLeafIdx)
 		: m_mmap(std::move(mmap)), ILeafSet(nextLeafIdx) { }
 
+	// Same as GetByte, SetByte, and Flush, but the caller must already hold m_mutex.
+	uint8_t ReadByte(const uint64_t byteIdx) const;
+	void WriteByte(const uint64_t byteIdx, const uint8_t value);
+	void WriteToFile();
+
 	MemMap m_mmap;
 	std::unordered_map<uint64_t, uint8_t> m_modifiedBytes;
+	mutable std::shared_mutex m_mutex;
 };
 
 class LeafSetCache : public ILeafSet
@@ -80,9 +93,35 @@ public:
 	void ApplyUpdates(const mmr::LeafIndex& nextLeafIdx, const std::unordered_map<uint64_t, uint8_t>& modifiedBytes) final;
 	void Flush();
 
+	// Returns the approximate number of bytes of memory held by the modified bytes.
+	size_t GetMemoryUsage() const noexcept;
+
+	//
+	// The modified bytes at the time TakeSnapshot was called.
+	//
+	struct Snapshot
+	{
+		using CPtr = std::shared_ptr<const Snapshot>;
+
+		mmr::LeafIndex nextLeafIdx;
+		std::unordered_map<uint64_t, uint8_t> modifiedBytes;
+	};
+
+	//
+	// Moves the modified bytes into an immutable snapshot, so they can be written to the base
+	// by WriteSnapshot on another thread while the cache continues to be modified.
+	// Reads are served from the snapshot until ReleaseSnapshot is called for it.
+	//
+	Snapshot::CPtr TakeSnapshot();
+	void WriteSnapshot(const Snapshot& snapshot) const;
+	void ReleaseSnapshot();
+
 private:
 	ILeafSet::Ptr m_pBacked;
 	std::unordered_map<uint64_t, uint8_t> m_modifiedBytes;
+
+	// Snapshots that are being written to the base, oldest first.
+	std::deque<Snapshot::CPtr> m_snapshots;
 };
 
 END_NAMESPACE
\ No newline at end of file
@@ -12,6 +12,10 @@
 #include <mw/mmr/LeafIndex.h>
 #include <mw/mmr/Leaf.h>
 #include <mw/mmr/Node.h>
+#include <mw/util/MemoryUtil.h>
+
+#include <deque>
+#include <shared_mutex>
 
 MMR_NAMESPACE
 
@@ -88,19 +92,38 @@ public:
     virtual void BatchWrite(const LeafIndex& firstLeafIdx, const std::vector<Leaf>& leaves) = 0;
 };
 
+//
+// An MMR stored in a backend.
+// Reads may happen concurrently with writes, so a cache can keep reading while a snapshot is written.
+//
 class MMR : public Traits::IBatchable, public IMMR
 {
 public:
     using Ptr = std::shared_ptr<MMR>;
     using CPtr = std::shared_ptr<const MMR>;
 
-    MMR(const IBackend::Ptr& pBackend) : m_pBackend(pBackend) { }
+    MMR(const IBackend::Ptr& pBackend)
+        : m_pBackend(pBackend), m_pMutex(std::make_shared<std::shared_mutex>()) { }
 
     LeafIndex AddLeaf(std::vector<uint8_t>&& data) final;
 
-    Leaf GetLeaf(const LeafIndex& leafIdx) const final { return m_pBackend->GetLeaf(leafIdx); }
-    mw::Hash GetHash(const Index& idx) const final { return m_pBackend->GetHash(idx); }
-    LeafIndex GetNextLeafIdx() const noexcept final { return m_pBackend->GetNextLeaf(); }
+    Leaf GetLeaf(const LeafIndex& leafIdx) const final
+    {
+        std::shared_lock<std::shared_mutex> lock(*m_pMutex);
+        return m_pBackend->GetLeaf(leafIdx);
+    }
+
+    mw::Hash GetHash(const Index& idx) const final
+    {
+        std::shared_lock<std::shared_mutex> lock(*m_pMutex);
+        return m_pBackend->GetHash(idx);
+    }
+
+    LeafIndex GetNextLeafIdx() const noexcept final
+    {
+        std::shared_lock<std::shared_mutex> lock(*m_pMutex);
+        return m_pBackend->GetNextLeaf();
+    }
 
     uint64_t GetNumLeaves() const noexcept;
     uint64_t GetNumNodes() const noexcept;
@@ -108,13 +131,25 @@ public:
 
     //mw::Hash Root() const final;
 
-    void Commit() final { m_pBackend->Commit(); }
-    void Rollback() noexcept final { m_pBackend->Rollback(); }
+    void Commit() final
+    {
+        std::unique_lock<std::shared_mutex> lock(*m_pMutex);
+        m_pBackend->Commit();
+    }
+
+    void Rollback() noexcept final
+    {
+        std::unique_lock<std::shared_mutex> lock(*m_pMutex);
+        m_pBackend->Rollback();
+    }
 
     void BatchWrite(const LeafIndex& firstLeafIdx, const std::vector<Leaf>& leaves) final;
 
 private:
     IBackend::Ptr m_pBackend;
+
+    // Shared by copies, since they share the backend too.
+    std::shared_ptr<std::shared_mutex> m_pMutex;
 };
 
 class MMRCache : public IMMR
@@ -145,6 +180,7 @@ public:
             nextIdx = nextIdx.GetNext();
         }
 
+        m_heapUsage += GetHeapUsage(leaf);
         m_leaves.push_back(std::move(leaf));
         return leafIdx;
     }
@@ -152,6 +188,13 @@ public:
     Leaf GetLeaf(const LeafIndex& leafIdx) const final
     {
         if (leafIdx < m_firstLeaf) {
+            for (auto iter = m_snapshots.crbegin(); iter != m_snapshots.crend(); iter++) {
+                const Snapshot& snapshot = **iter;
+                if (leafIdx >= snapshot.firstLeaf && (leafIdx.GetLeafIndex() - snapshot.firstLeaf.GetLeafIndex()) < snapshot.leaves.size()) {
+                    return snapshot.leaves[leafIdx.GetLeafIndex() - snapshot.firstLeaf.GetLeafIndex()];
+                }
+            }
+
             return m_pBase->GetLeaf(leafIdx);
         }
 
@@ -176,6 +219,13 @@ public:
     mw::Hash GetHash(const Index& idx) const final
     {
         if (idx < m_firstLeaf.GetPosition()) {
+            for (auto iter = m_snapshots.crbegin(); iter != m_snapshots.crend(); iter++) {
+                const Snapshot& snapshot = **iter;
+                if (idx >= snapshot.firstLeaf.GetPosition() && (idx.GetPosition() - snapshot.firstLeaf.GetPosition()) < snapshot.nodes.size()) {
+                    return snapshot.nodes[idx.GetPosition() - snapshot.firstLeaf.GetPosition()];
+                }
+            }
+
             return m_pBase->GetHash(idx);
         } else {
             const uint64_t vecIdx = idx.GetPosition() - m_firstLeaf.GetPosition();
@@ -187,10 +237,12 @@ public:
     void Rewind(const uint64_t numLeaves) final
     {
         LeafIndex nextLeaf = LeafIndex::At(numLeaves);
+        assert(m_snapshots.empty() || nextLeaf >= m_firstLeaf); // Snapshots can't be rewound.
         if (nextLeaf <= m_firstLeaf) {
             m_firstLeaf = nextLeaf;
             m_leaves.clear();
             m_nodes.clear();
+            m_heapUsage = 0;
         } else if (!m_leaves.empty()) {
             auto iter = m_leaves.begin();
             while (iter != m_leaves.end() && iter->GetLeafIndex() < nextLeaf) {
@@ -198,6 +250,10 @@ public:
             }
 
             if (iter != m_leaves.end()) {
+                for (auto removed = iter; removed != m_leaves.end(); removed++) {
+                    m_heapUsage -= GetHeapUsage(*removed);
+                }
+
                 m_leaves.erase(iter, m_leaves.end());
             }
 
@@ -219,17 +275,98 @@ public:
 
     void Flush()
     {
+        assert(m_snapshots.empty());
+
         m_pBase->BatchWrite(m_firstLeaf, m_leaves);
         m_firstLeaf = GetNextLeafIdx();
-        m_leaves.clear();
-        m_nodes.clear();
+
+        // Release the memory, rather than just clearing, so a flush actually reduces memory usage.
+        std::vector<Leaf>().swap(m_leaves);
+        std::vector<mw::Hash>().swap(m_nodes);
+        m_heapUsage = 0;
+    }
+
+    //
+    // Returns the approximate number of bytes of memory held by the uncommitted leaves and hashes.
+    //
+    size_t GetMemoryUsage() const noexcept
+    {
+        size_t usage = MemoryUtil::DynamicUsage(m_leaves) + MemoryUtil::DynamicUsage(m_nodes) + m_heapUsage;
+        for (const Snapshot::CPtr& pSnapshot : m_snapshots) {
+            usage += pSnapshot->memoryUsage;
+        }
+
+        return usage;
+    }
+
+    //
+    // The uncommitted leaves and hashes at the time TakeSnapshot was called.
+    //
+    struct Snapshot
+    {
+        using CPtr = std::shared_ptr<const Snapshot>;
+
+        LeafIndex firstLeaf;
+        std::vector<Leaf> leaves;
+        std::vector<mw::Hash> nodes;
+        size_t memoryUsage;
+    };
+
+    //
+    // Moves the uncommitted leaves and hashes into an immutable snapshot, so they can be written
+    // to the base by WriteSnapshot on another thread while new leaves are added to the cache.
+    // Reads are served from the snapshot until ReleaseSnapshot is called for it.
+    //
+    Snapshot::CPtr TakeSnapshot()
+    {
+        const LeafIndex nextLeaf = GetNextLeafIdx();
+        const size_t memoryUsage = MemoryUtil::DynamicUsage(m_leaves) + MemoryUtil::DynamicUsage(m_nodes) + m_heapUsage;
+        auto pSnapshot = std::make_shared<const Snapshot>(
+            Snapshot{ m_firstLeaf, std::move(m_leaves), std::move(m_nodes), memoryUsage }
+        );
+
+        m_firstLeaf = nextLeaf;
+        m_leaves = std::vector<Leaf>();
+        m_nodes = std::vector<mw::Hash>();
+        m_heapUsage = 0;
+
+        m_snapshots.push_back(pSnapshot);
+        return pSnapshot;
+    }
+
+    //
+    // Writes the snapshot to the base MMR. Only reads the snapshot itself, so it's safe to call from
+    // another thread as long as the base MMR supports concurrent access (see MMR).
+    //
+    void WriteSnapshot(const Snapshot& snapshot) const
+    {
+        m_pBase->BatchWrite(snapshot.firstLeaf, snapshot.leaves);
+    }
+
+    //
+    // Releases the oldest snapshot. Call this only once it's been written to the base.
+    //
+    void ReleaseSnapshot()
+    {
+        assert(!m_snapshots.empty());
+        m_snapshots.pop_front();
     }
 
 private:
+    static size_t GetHeapUsage(const Leaf& leaf) noexcept
+    {
+        return MemoryUtil::DynamicUsage(leaf.vec());
+    }
+
     IMMR::Ptr m_pBase;
     LeafIndex m_firstLeaf;
     std::vector<Leaf> m_leaves;
     std::vector<mw::Hash> m_nodes;
+
+    // Memory owned by the elements of m_leaves and m_nodes, tracked as they're added and removed.
+    size_t m_heapUsage{ 0 };
+    // Snapshots that are being written to the base, oldest first.
+    std::deque<Snapshot::CPtr> m_snapshots;
 };
 
 END_NAMESPACE
\ No newline at end of file
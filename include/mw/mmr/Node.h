@@ -16,7 +16,7 @@ class Node
 public:
     static Node CreateParent(const Index& index, const mw::Hash& leftHash, const mw::Hash& rightHash)
     {
-        Serializer hashSerializer;
+        Serializer hashSerializer(sizeof(uint64_t) + leftHash.size() + rightHash.size());
         hashSerializer.Append<uint64_t>(index.GetPosition());
         hashSerializer.Append(leftHash);
         hashSerializer.Append(rightHash);
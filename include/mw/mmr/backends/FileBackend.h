@@ -9,8 +9,12 @@
 #include <mw/mmr/Node.h>
 #include <mw/file/FilePath.h>
 #include <mw/file/AppendOnlyFile.h>
+#include <mw/file/File.h>
+#include <mw/exceptions/FileException.h>
 #include <boost/optional.hpp>
+#include <array>
 #include <cassert>
+#include <functional>
 
 MMR_NAMESPACE
 
@@ -43,6 +47,57 @@ public:
         return pBackend;
     }
 
+    //
+    // Rebuilds the position file of a variable-length backend whose data file was written without one,
+    // i.e. by a version that opened the backend as fixed-length. Does nothing if there's already a position file.
+    // leafSize returns the size of the leaf whose data starts at pData, given the number of bytes left, or 0 if it's invalid.
+    // Every leaf is checked against the hash file. Throws a FileException if the data doesn't match the hashes,
+    // e.g. because a fixed-length rewind truncated it in the wrong place.
+    //
+    static void RebuildPositionFile(const FilePath& path, const std::function<size_t(const uint8_t*, const size_t)>& leafSize)
+    {
+        const FilePath dataPath = path.GetChild("pmmr_data.bin");
+        if (path.GetChild("pmmr_pos.bin").Exists() || !dataPath.Exists()) {
+            return;
+        }
+
+        const std::vector<uint8_t> data = File(dataPath).ReadBytes();
+        const FilePath hashPath = path.GetChild("pmmr_hash.bin");
+        const std::vector<uint8_t> hashes = hashPath.Exists() ? File(hashPath).ReadBytes() : std::vector<uint8_t>{};
+
+        Serializer positions;
+        uint64_t numLeaves = 0;
+        for (size_t offset = 0; offset < data.size(); numLeaves++) {
+            const size_t available = data.size() - offset;
+            const size_t size = leafSize(data.data() + offset, available);
+            if (size == 0 || size > available || size > UINT16_MAX) {
+                ThrowFile_F("Can't read leaf {} of {}. Delete the directory and resync.", numLeaves, path);
+            }
+
+            const LeafIndex leafIdx = LeafIndex::At(numLeaves);
+            const Leaf leaf = Leaf::Create(leafIdx, std::vector<uint8_t>(data.cbegin() + offset, data.cbegin() + offset + size));
+            const size_t hashOffset = leafIdx.GetPosition() * mw::Hash::size();
+            if (hashOffset + mw::Hash::size() > hashes.size()
+                || mw::Hash(hashes.data() + hashOffset) != leaf.GetHash()) {
+                ThrowFile_F("Leaf {} of {} doesn't match its hash. Delete the directory and resync.", numLeaves, path);
+            }
+
+            positions.Append<uint64_t>(offset).Append<uint16_t>((uint16_t)size);
+            offset += size;
+        }
+
+        if (LeafIndex::At(numLeaves).GetPosition() * mw::Hash::size() != hashes.size()) {
+            ThrowFile_F("{} has {} leaves, which doesn't match its hash file. Delete the directory and resync.", path, numLeaves);
+        }
+
+        // Written under another name first, so an interrupted rebuild is started over next time.
+        File tempFile(path.GetChild("pmmr_pos.bin.tmp"));
+        tempFile.Create();
+        tempFile.Truncate(0);
+        tempFile.Write(positions.vec());
+        tempFile.Rename("pmmr_pos.bin");
+    }
+
     FileBackend(const AppendOnlyFile::Ptr& pHashFile, const AppendOnlyFile::Ptr& pDataFile, const uint16_t fixedLength)
         : m_pHashFile(pHashFile), m_pDataFile(pDataFile), m_fixedLength(fixedLength) { }
 
@@ -64,7 +119,7 @@ public:
         }
     }
 
-    void AddHash(const mw::Hash& hash) final { m_pHashFile->Append(hash.vec()); }
+    void AddHash(const mw::Hash& hash) final { m_pHashFile->Append(hash.data(), hash.size()); }
 
     void Rewind(const LeafIndex& nextLeafIndex) final
     {
@@ -83,7 +138,7 @@ public:
             m_pPositionFile->Rewind(nextLeafIndex.GetLeafIndex() * PosEntry::LENGTH);
             m_pDataFile->Rewind(posEntry.position + posEntry.size);
         } else {
-            m_pDataFile->Rewind(nextLeafIndex.GetPosition() * m_fixedLength);
+            m_pDataFile->Rewind(nextLeafIndex.GetLeafIndex() * m_fixedLength);
         }
 
         m_pHashFile->Rewind(nextLeafIndex.GetPosition() * 32);
@@ -149,11 +204,11 @@ private:
     {
         assert(m_pPositionFile != nullptr);
 
-        std::vector<uint8_t> data = m_pPositionFile->Read(leafIndex * PosEntry::LENGTH, PosEntry::LENGTH);
+        std::array<uint8_t, PosEntry::LENGTH> data;
+        m_pPositionFile->Read(leafIndex * PosEntry::LENGTH, PosEntry::LENGTH, data.data());
 
-        Deserializer deserializer(std::move(data));
-        const uint64_t position = deserializer.Read<uint64_t>();
-        const uint16_t size = deserializer.Read<uint16_t>();
+        const uint64_t position = EndianUtil::ReadBE64(data.data());
+        const uint16_t size = EndianUtil::ReadBE16(data.data() + sizeof(uint64_t));
         return PosEntry{ position, size };
     }
 
@@ -11,6 +11,7 @@
 #include <mw/traits/Printable.h>
 #include <mw/traits/Jsonable.h>
 #include <algorithm>
+#include <atomic>
 
 MW_NAMESPACE
 
@@ -32,15 +33,30 @@ public:
         : m_pHeader(pHeader), m_body(std::move(body)), m_validated(false) { }
     Block(const mw::Header::CPtr& pHeader, const TxBody& body)
         : m_pHeader(pHeader), m_body(body), m_validated(false) { }
-    Block(const Block& other) = default;
-    Block(Block&& other) noexcept = default;
-    Block() = default;
+    Block(const Block& other)
+        : m_pHeader(other.m_pHeader), m_body(other.m_body), m_validated(other.WasValidated()) { }
+    Block(Block&& other) noexcept
+        : m_pHeader(std::move(other.m_pHeader)), m_body(std::move(other.m_body)), m_validated(other.WasValidated()) { }
+    Block() : m_validated(false) { }
 
     //
     // Operators
     //
-    Block& operator=(const Block& other) = default;
-    Block& operator=(Block&& other) noexcept = default;
+    Block& operator=(const Block& other)
+    {
+        m_pHeader = other.m_pHeader;
+        m_body = other.m_body;
+        m_validated = other.WasValidated();
+        return *this;
+    }
+
+    Block& operator=(Block&& other) noexcept
+    {
+        m_pHeader = std::move(other.m_pHeader);
+        m_body = std::move(other.m_body);
+        m_validated = other.WasValidated();
+        return *this;
+    }
 
     //
     // Getters
@@ -102,8 +118,8 @@ public:
 
     static Block Deserialize(Deserializer& deserializer)
     {
-        mw::Header::CPtr pHeader = std::make_shared<mw::Header>(mw::Header::Deserialize(deserializer));
-        TxBody body = deserializer.Read<TxBody>();
+        mw::Header::CPtr pHeader = ObjectPool::MakeShared<mw::Header>(mw::Header::Deserialize(deserializer));
+        TxBody body = TxBody::Deserialize(deserializer);
         return Block{ pHeader, std::move(body) };
     }
 
@@ -118,7 +134,7 @@ public:
     static Block FromJSON(const Json& json)
     {
         return Block{
-            std::make_shared<mw::Header>(json.GetRequired<mw::Header>("header")),
+            ObjectPool::MakeShared<mw::Header>(json.GetRequired<mw::Header>("header")),
             json.GetRequired<TxBody>("body")
         };
     }
@@ -144,7 +160,8 @@ public:
 private:
     mw::Header::CPtr m_pHeader;
     TxBody m_body;
-    bool m_validated;
+    // Atomic, since a block can be shared between validation threads.
+    std::atomic_bool m_validated;
 };
 
 END_NAMESPACE
\ No newline at end of file
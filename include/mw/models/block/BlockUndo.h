@@ -53,7 +53,7 @@ public:
         mw::Header::CPtr pPrevHeader = nullptr;
         const bool has_previous = deserializer.Read<uint8_t>() == 1;
         if (has_previous) {
-            pPrevHeader = std::make_shared<mw::Header>(mw::Header::Deserialize(deserializer));
+            pPrevHeader = ObjectPool::MakeShared<mw::Header>(mw::Header::Deserialize(deserializer));
         }
 
         std::vector<UTXO> coinsSpent = deserializer.ReadVec<UTXO>();
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <mw/common/Macros.h>
+#include <mw/common/ThreadPool.h>
+#include <mw/consensus/Consensus.h>
+#include <mw/crypto/Hasher.h>
+#include <mw/models/block/Block.h>
+#include <mw/models/block/Header.h>
+#include <mw/models/tx/Input.h>
+#include <mw/models/tx/Output.h>
+#include <mw/models/tx/Kernel.h>
+#include <mw/serialization/Deserializer.h>
+#include <mw/util/ParallelUtil.h>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+MW_NAMESPACE
+
+//
+// A serialized block that's only been split into its inputs, outputs and kernels, without decoding them.
+//
+// Relay and early checks mostly need hashes, commitments and sizes, which are read straight from the bytes.
+// Inputs, outputs and kernels are only decoded (with their own heap allocations) when asked for,
+// so holding a block this way takes little more memory than its serialized size.
+//
+// Since the boundaries are known up front, large blocks can also be decoded and hashed in parallel (see Decode).
+//
+class BlockView
+{
+public:
+    using CPtr = std::shared_ptr<const BlockView>;
+
+    //
+    // Finds the boundaries of each element. Only the header is decoded.
+    // Throws a DeserializationException if the bytes aren't a well-formed block.
+    //
+    static BlockView Parse(std::vector<uint8_t>&& bytes)
+    {
+        BlockView view;
+        view.m_bytes = std::move(bytes);
+        view.Scan(view.m_bytes.data(), view.m_bytes.size());
+        return view;
+    }
+
+    //
+    // Decodes the block in the given memory, which is only read during the call.
+    // Gives the same block as Block::Deserialize, but splits the decoding and hashing across the pool.
+    //
+    static mw::Block::Ptr Decode(const uint8_t* pBytes, const size_t length, ThreadPool& pool = ThreadPool::GetShared())
+    {
+        BlockView view;
+        view.Scan(pBytes, length);
+        return view.Decode(pBytes, pool);
+    }
+
+    //
+    // Getters
+    //
+    const mw::Header::CPtr& GetHeader() const noexcept { return m_pHeader; }
+    const std::vector<uint8_t>& GetBytes() const noexcept { return m_bytes; }
+
+    size_t GetNumInputs() const noexcept { return m_inputs.size(); }
+    size_t GetNumOutputs() const noexcept { return m_outputs.size(); }
+    size_t GetNumKernels() const noexcept { return m_kernels.size(); }
+
+    size_t GetWeight() const noexcept
+    {
+        return (m_inputs.size() * Consensus::INPUT_WEIGHT)
+            + (m_outputs.size() * Consensus::OUTPUT_WEIGHT)
+            + (m_kernels.size() * Consensus::KERNEL_WEIGHT);
+    }
+
+    //
+    // Read directly from the serialized block. Inputs and outputs both start with a features byte and a commitment.
+    //
+    Commitment GetInputCommitment(const size_t index) const { return ReadCommitment(m_inputs.at(index)); }
+    Commitment GetOutputCommitment(const size_t index) const { return ReadCommitment(m_outputs.at(index)); }
+
+    //
+    // The same hashes Input, Output and Kernel's GetHash() return, computed from the serialized bytes.
+    //
+    mw::Hash GetInputHash(const size_t index) const { return HashElement(m_inputs.at(index)); }
+    mw::Hash GetOutputHash(const size_t index) const { return HashElement(m_outputs.at(index)); }
+    mw::Hash GetKernelHash(const size_t index) const { return HashElement(m_kernels.at(index)); }
+
+    // Output hashes are by far the most expensive (each includes a rangeproof), so these are computed across the pool.
+    std::vector<mw::Hash> GetOutputHashes(ThreadPool& pool = ThreadPool::GetShared()) const { return HashElements(m_outputs, pool); }
+
+    //
+    // Decode individual elements, or the whole block.
+    //
+    Input GetInput(const size_t index) const { return DecodeElement<Input>(m_bytes.data(), m_inputs.at(index)); }
+    Output GetOutput(const size_t index) const { return DecodeElement<Output>(m_bytes.data(), m_outputs.at(index)); }
+    Kernel GetKernel(const size_t index) const { return DecodeElement<Kernel>(m_bytes.data(), m_kernels.at(index)); }
+
+    mw::Block::Ptr Materialize(ThreadPool& pool = ThreadPool::GetShared()) const { return Decode(m_bytes.data(), pool); }
+
+private:
+    struct Element
+    {
+        size_t offset;
+        size_t length;
+    };
+
+    // Enough work per chunk to be worth handing to another thread. Outputs are mostly rangeproof, which is what's slow to hash.
+    static constexpr size_t INPUTS_PER_CHUNK = 1024;
+    static constexpr size_t OUTPUTS_PER_CHUNK = 64;
+    static constexpr size_t KERNELS_PER_CHUNK = 256;
+
+    BlockView() = default;
+
+    void Scan(const uint8_t* pBytes, const size_t length)
+    {
+        Deserializer deserializer(pBytes, length);
+        m_pHeader = ObjectPool::MakeShared<mw::Header>(mw::Header::Deserialize(deserializer));
+
+        const uint64_t numInputs = deserializer.Read<uint64_t>();
+        const uint64_t numOutputs = deserializer.Read<uint64_t>();
+        const uint64_t numKernels = deserializer.Read<uint64_t>();
+
+        // Each element takes at least one byte, so this limits how much a malformed count can make us reserve.
+        const size_t remaining = deserializer.GetRemainingSize();
+        if (numInputs > remaining || numOutputs > remaining || numKernels > remaining || numInputs + numOutputs + numKernels > remaining) {
+            ThrowDeserialization("Block has more elements than bytes");
+        }
+
+        m_inputs.reserve(numInputs);
+        for (uint64_t i = 0; i < numInputs; i++) {
+            m_inputs.push_back(ReadElement(pBytes, deserializer, [](Deserializer& d) {
+                d.ReadBytes(1 + Commitment::SIZE);
+            }));
+        }
+
+        m_outputs.reserve(numOutputs);
+        for (uint64_t i = 0; i < numOutputs; i++) {
+            m_outputs.push_back(ReadElement(pBytes, deserializer, [](Deserializer& d) {
+                d.ReadBytes(1 + Commitment::SIZE);
+                d.ReadBytes(d.Read<uint8_t>());
+
+                const uint64_t proofSize = d.Read<uint64_t>();
+                if (proofSize > RangeProof::MAX_SIZE) {
+                    ThrowDeserialization("RangeProof is larger than MAX_SIZE");
+                }
+
+                d.ReadBytes(proofSize);
+            }));
+        }
+
+        // Kernels have several layouts, so they're decoded to find where each ends.
+        m_kernels.reserve(numKernels);
+        for (uint64_t i = 0; i < numKernels; i++) {
+            m_kernels.push_back(ReadElement(pBytes, deserializer, [](Deserializer& d) { Kernel::Deserialize(d); }));
+        }
+    }
+
+    template<typename SkipFn>
+    static Element ReadElement(const uint8_t* pBytes, Deserializer& deserializer, const SkipFn& skip)
+    {
+        const uint8_t* pStart = deserializer.ReadBytes(0);
+        skip(deserializer);
+        return Element{ (size_t)(pStart - pBytes), (size_t)(deserializer.ReadBytes(0) - pStart) };
+    }
+
+    //
+    // Decodes every element of the block in chunks, hashing each as it's decoded.
+    // Each element is only ever touched by the thread decoding its chunk.
+    //
+    mw::Block::Ptr Decode(const uint8_t* pBytes, ThreadPool& pool) const
+    {
+        std::vector<Input> inputs(m_inputs.size());
+        std::vector<Output> outputs(m_outputs.size());
+        std::vector<Kernel> kernels(m_kernels.size());
+
+        const size_t num_input_chunks = NumChunks(inputs.size(), INPUTS_PER_CHUNK);
+        const size_t num_output_chunks = NumChunks(outputs.size(), OUTPUTS_PER_CHUNK);
+        const size_t num_kernel_chunks = NumChunks(kernels.size(), KERNELS_PER_CHUNK);
+
+        pool.ForEach(num_input_chunks + num_output_chunks + num_kernel_chunks, [&](size_t chunk) {
+            if (chunk < num_input_chunks) {
+                DecodeChunk(pBytes, m_inputs, inputs, chunk, INPUTS_PER_CHUNK);
+            } else if ((chunk -= num_input_chunks) < num_output_chunks) {
+                DecodeChunk(pBytes, m_outputs, outputs, chunk, OUTPUTS_PER_CHUNK);
+            } else {
+                DecodeChunk(pBytes, m_kernels, kernels, chunk - num_output_chunks, KERNELS_PER_CHUNK);
+            }
+        });
+
+        return std::make_shared<mw::Block>(m_pHeader, TxBody(std::move(inputs), std::move(outputs), std::move(kernels)));
+    }
+
+    static size_t NumChunks(const size_t numElements, const size_t perChunk) noexcept
+    {
+        return (numElements + perChunk - 1) / perChunk;
+    }
+
+    template<typename T>
+    static void DecodeChunk(const uint8_t* pBytes, const std::vector<Element>& elements, std::vector<T>& decoded, const size_t chunk, const size_t perChunk)
+    {
+        const size_t end = std::min(elements.size(), (chunk + 1) * perChunk);
+        for (size_t i = chunk * perChunk; i < end; i++) {
+            decoded[i] = DecodeElement<T>(pBytes, elements[i]);
+            decoded[i].GetHash();
+        }
+    }
+
+    Commitment ReadCommitment(const Element& element) const
+    {
+        Deserializer deserializer(m_bytes.data() + element.offset + 1, Commitment::SIZE);
+        return Commitment::Deserialize(deserializer);
+    }
+
+    mw::Hash HashElement(const Element& element) const
+    {
+        return Hashed(m_bytes.data() + element.offset, element.length);
+    }
+
+    std::vector<mw::Hash> HashElements(const std::vector<Element>& elements, ThreadPool& pool) const
+    {
+        std::vector<mw::Hash> hashes(elements.size());
+
+        const size_t num_chunks = ParallelUtil::NumThreads(elements.size(), 256);
+        pool.ForEach(num_chunks, [this, &elements, &hashes, num_chunks](const size_t chunk) {
+            const size_t end = (elements.size() * (chunk + 1)) / num_chunks;
+            for (size_t i = (elements.size() * chunk) / num_chunks; i < end; i++) {
+                hashes[i] = HashElement(elements[i]);
+            }
+        });
+
+        return hashes;
+    }
+
+    template<typename T>
+    static T DecodeElement(const uint8_t* pBytes, const Element& element)
+    {
+        Deserializer deserializer(pBytes + element.offset, element.length);
+        return T::Deserialize(deserializer);
+    }
+
+    std::vector<uint8_t> m_bytes;
+    mw::Header::CPtr m_pHeader;
+    std::vector<Element> m_inputs;
+    std::vector<Element> m_outputs;
+    std::vector<Element> m_kernels;
+};
+
+END_NAMESPACE
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <mw/common/Macros.h>
+#include <mw/models/block/Header.h>
+#include <mw/models/block/BlockUndo.h>
+#include <mw/models/crypto/Commitment.h>
+#include <mw/mmr/LeafIndex.h>
+#include <mw/traits/Serializable.h>
+
+MW_NAMESPACE
+
+//
+// Identifies a coin spent by a block without copying its rangeproof.
+// The output and rangeproof can be read back from the MMRs at the leaf index,
+// or, once pruned from there, looked up by commitment in the block at the given height.
+//
+class SpentCoinRef final : public Traits::ISerializable
+{
+public:
+    SpentCoinRef() = default;
+    SpentCoinRef(const uint64_t blockHeight, const mmr::LeafIndex& leafIdx, const Commitment& commitment, const std::vector<uint8_t>& extraData)
+        : m_blockHeight(blockHeight), m_leafIdx(leafIdx), m_commitment(commitment), m_extraData(extraData) { }
+
+    static SpentCoinRef FromUTXO(const UTXO& utxo)
+    {
+        return SpentCoinRef(utxo.GetBlockHeight(), utxo.GetLeafIndex(), utxo.GetCommitment(), utxo.GetExtraData());
+    }
+
+    uint64_t GetBlockHeight() const noexcept { return m_blockHeight; }
+    const mmr::LeafIndex& GetLeafIndex() const noexcept { return m_leafIdx; }
+    const Commitment& GetCommitment() const noexcept { return m_commitment; }
+
+    // The extra data isn't committed to by the MMRs, so it has to be kept here.
+    const std::vector<uint8_t>& GetExtraData() const noexcept { return m_extraData; }
+
+    Serializer& Serialize(Serializer& serializer) const noexcept final
+    {
+        return serializer
+            .Append<uint64_t>(m_blockHeight)
+            .Append<uint64_t>(m_leafIdx.GetLeafIndex())
+            .Append(m_commitment)
+            .Append<uint8_t>((uint8_t)m_extraData.size())
+            .Append(m_extraData);
+    }
+
+    static SpentCoinRef Deserialize(Deserializer& deserializer)
+    {
+        const uint64_t blockHeight = deserializer.Read<uint64_t>();
+        const uint64_t leafIdx = deserializer.Read<uint64_t>();
+        Commitment commitment = Commitment::Deserialize(deserializer);
+        const uint8_t extra_data_len = deserializer.Read<uint8_t>();
+        std::vector<uint8_t> extra_data = deserializer.ReadVector(extra_data_len);
+        return SpentCoinRef(blockHeight, mmr::LeafIndex::At(leafIdx), commitment, extra_data);
+    }
+
+private:
+    uint64_t m_blockHeight;
+    mmr::LeafIndex m_leafIdx;
+    Commitment m_commitment;
+    std::vector<uint8_t> m_extraData;
+};
+
+//
+// An alternative encoding of BlockUndo that references spent coins by leaf index instead of copying them.
+// It's a fraction of the size, since it doesn't include rangeproofs, but must be expanded back
+// into a BlockUndo (see INode::ExpandUndo) before the block can be disconnected.
+//
+class CompactBlockUndo final : public Traits::ISerializable
+{
+public:
+    using CPtr = std::shared_ptr<const CompactBlockUndo>;
+
+    //
+    // Constructors
+    //
+    CompactBlockUndo(const mw::Header::CPtr& pPrevHeader, std::vector<SpentCoinRef>&& coinsSpent, std::vector<Commitment>&& coinsAdded)
+        : m_pPrevHeader(pPrevHeader), m_coinsSpent(std::move(coinsSpent)), m_coinsAdded(std::move(coinsAdded)) { }
+    CompactBlockUndo(const CompactBlockUndo& other) = default;
+    CompactBlockUndo(CompactBlockUndo&& other) noexcept = default;
+    CompactBlockUndo() = default;
+
+    static CompactBlockUndo FromUndo(const BlockUndo& undo)
+    {
+        std::vector<SpentCoinRef> coinsSpent;
+        coinsSpent.reserve(undo.GetCoinsSpent().size());
+        for (const UTXO& utxo : undo.GetCoinsSpent()) {
+            coinsSpent.push_back(SpentCoinRef::FromUTXO(utxo));
+        }
+
+        std::vector<Commitment> coinsAdded = undo.GetCoinsAdded();
+        return CompactBlockUndo{ undo.GetPreviousHeader(), std::move(coinsSpent), std::move(coinsAdded) };
+    }
+
+    //
+    // Operators
+    //
+    CompactBlockUndo& operator=(const CompactBlockUndo& other) = default;
+    CompactBlockUndo& operator=(CompactBlockUndo&& other) noexcept = default;
+
+    //
+    // Getters
+    //
+    const mw::Header::CPtr& GetPreviousHeader() const noexcept { return m_pPrevHeader; }
+    const std::vector<SpentCoinRef>& GetCoinsSpent() const noexcept { return m_coinsSpent; }
+    const std::vector<Commitment>& GetCoinsAdded() const noexcept { return m_coinsAdded; }
+
+    //
+    // Serialization/Deserialization
+    //
+    Serializer& Serialize(Serializer& serializer) const noexcept final
+    {
+        if (m_pPrevHeader != nullptr) {
+            serializer.Append<uint8_t>(1).Append(m_pPrevHeader);
+        } else {
+            serializer.Append<uint8_t>(0);
+        }
+
+        return serializer.AppendVec(m_coinsSpent).AppendVec(m_coinsAdded);
+    }
+
+    static CompactBlockUndo Deserialize(Deserializer& deserializer)
+    {
+        mw::Header::CPtr pPrevHeader = nullptr;
+        const bool has_previous = deserializer.Read<uint8_t>() == 1;
+        if (has_previous) {
+            pPrevHeader = ObjectPool::MakeShared<mw::Header>(mw::Header::Deserialize(deserializer));
+        }
+
+        std::vector<SpentCoinRef> coinsSpent = deserializer.ReadVec<SpentCoinRef>();
+        std::vector<Commitment> coinsAdded = deserializer.ReadVec<Commitment>();
+
+        return CompactBlockUndo{ pPrevHeader, std::move(coinsSpent), std::move(coinsAdded) };
+    }
+
+private:
+    mw::Header::CPtr m_pPrevHeader;
+    std::vector<SpentCoinRef> m_coinsSpent;
+    std::vector<Commitment> m_coinsAdded;
+};
+
+END_NAMESPACE
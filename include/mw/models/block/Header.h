@@ -5,6 +5,7 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <mw/common/Macros.h>
+#include <mw/common/ObjectPool.h>
 #include <mw/models/crypto/BlindingFactor.h>
 #include <mw/models/crypto/Hash.h>
 #include <mw/traits/Hashable.h>
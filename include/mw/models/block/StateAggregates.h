@@ -0,0 +1,162 @@
+#pragma once
+
+#include <mw/common/Macros.h>
+#include <mw/crypto/CommitmentSum.h>
+#include <mw/models/crypto/Commitment.h>
+#include <mw/models/crypto/Hash.h>
+#include <mw/models/tx/Kernel.h>
+#include <mw/traits/Serializable.h>
+
+#include <cassert>
+#include <memory>
+#include <vector>
+
+MW_NAMESPACE
+
+//
+// Running totals over the entire state as of a header: the sum of all UTXO commitments,
+// the sum of all kernel excesses, and the total amount pegged in (minus the amount pegged out).
+//
+// They're updated as blocks are connected and disconnected (see Changes), and persisted with the header
+// on each flush, so the state can be checked against the header's total offset without re-summing
+// every UTXO (see BlockSumValidator::ValidateAggregates).
+//
+class StateAggregates final : public Traits::ISerializable
+{
+public:
+    using CPtr = std::shared_ptr<const StateAggregates>;
+
+    //
+    // Constructors
+    //
+    StateAggregates() = default; // The empty state, before the first header.
+    StateAggregates(const mw::Hash& headerHash, const Commitment& utxoSum, const Commitment& kernelSum, const uint64_t peggedSupply)
+        : m_headerHash(headerHash), m_utxoSum(utxoSum), m_kernelSum(kernelSum), m_peggedSupply(peggedSupply) { }
+
+    //
+    // Getters
+    //
+    // The hash of the header the totals are for, or ZERO_HASH for the empty state.
+    const mw::Hash& GetHeaderHash() const noexcept { return m_headerHash; }
+
+    // A zero commitment when there are no UTXOs, or they sum to the point at infinity.
+    const Commitment& GetUTXOSum() const noexcept { return m_utxoSum; }
+
+    // A zero commitment when there are no kernels, or they sum to the point at infinity.
+    const Commitment& GetKernelSum() const noexcept { return m_kernelSum; }
+
+    uint64_t GetPeggedSupply() const noexcept { return m_peggedSupply; }
+
+    //
+    // UTXOs and kernels added and removed since the totals were last computed.
+    // Collecting these and applying them all at once is much cheaper than updating the sums block by block.
+    //
+    struct Changes
+    {
+        std::vector<Commitment> utxosAdded;
+        std::vector<Commitment> utxosRemoved;
+        std::vector<Commitment> excessesAdded;
+        std::vector<Commitment> excessesRemoved;
+        uint64_t supplyAdded{ 0 };
+        uint64_t supplyRemoved{ 0 };
+
+        void AddKernel(const Kernel& kernel)
+        {
+            excessesAdded.push_back(kernel.GetExcess());
+            supplyAdded += kernel.GetPeggedIn();
+            supplyRemoved += kernel.GetPeggedOut();
+        }
+
+        void RemoveKernel(const Kernel& kernel)
+        {
+            excessesRemoved.push_back(kernel.GetExcess());
+            supplyAdded += kernel.GetPeggedOut();
+            supplyRemoved += kernel.GetPeggedIn();
+        }
+
+        void Append(const Changes& changes)
+        {
+            utxosAdded.insert(utxosAdded.end(), changes.utxosAdded.cbegin(), changes.utxosAdded.cend());
+            utxosRemoved.insert(utxosRemoved.end(), changes.utxosRemoved.cbegin(), changes.utxosRemoved.cend());
+            excessesAdded.insert(excessesAdded.end(), changes.excessesAdded.cbegin(), changes.excessesAdded.cend());
+            excessesRemoved.insert(excessesRemoved.end(), changes.excessesRemoved.cbegin(), changes.excessesRemoved.cend());
+            supplyAdded += changes.supplyAdded;
+            supplyRemoved += changes.supplyRemoved;
+        }
+
+        bool IsEmpty() const noexcept
+        {
+            return utxosAdded.empty() && utxosRemoved.empty() && excessesAdded.empty() && excessesRemoved.empty()
+                && supplyAdded == 0 && supplyRemoved == 0;
+        }
+    };
+
+    //
+    // Returns the totals for the given header, after applying the changes.
+    // This only sums: the pegged supply can't go negative, since blocks pegging out more than it are
+    // rejected when they're applied (see CoinsViewCache::ApplyBlock).
+    //
+    StateAggregates Apply(const mw::Hash& headerHash, const Changes& changes) const
+    {
+        assert(m_peggedSupply + changes.supplyAdded >= changes.supplyRemoved);
+
+        if (changes.IsEmpty()) {
+            return StateAggregates(headerHash, m_utxoSum, m_kernelSum, m_peggedSupply);
+        }
+
+        return StateAggregates(
+            headerHash,
+            Sum(m_utxoSum, changes.utxosAdded, changes.utxosRemoved),
+            Sum(m_kernelSum, changes.excessesAdded, changes.excessesRemoved),
+            m_peggedSupply + changes.supplyAdded - changes.supplyRemoved
+        );
+    }
+
+    //
+    // Serialization/Deserialization
+    //
+    Serializer& Serialize(Serializer& serializer) const noexcept final
+    {
+        return serializer
+            .Append(m_headerHash)
+            .Append(m_utxoSum)
+            .Append(m_kernelSum)
+            .Append<uint64_t>(m_peggedSupply);
+    }
+
+    static StateAggregates Deserialize(Deserializer& deserializer)
+    {
+        mw::Hash headerHash = mw::Hash::Deserialize(deserializer);
+        Commitment utxoSum = Commitment::Deserialize(deserializer);
+        Commitment kernelSum = Commitment::Deserialize(deserializer);
+        const uint64_t peggedSupply = deserializer.Read<uint64_t>();
+        return StateAggregates(headerHash, utxoSum, kernelSum, peggedSupply);
+    }
+
+private:
+    static Commitment Sum(const Commitment& total, const std::vector<Commitment>& added, const std::vector<Commitment>& removed)
+    {
+        // A zero total is the point at infinity, not a commitment.
+        CommitmentSum sum;
+        if (!total.IsZero()) {
+            sum.Add(total);
+        }
+
+        for (const Commitment& commitment : added) {
+            sum.Add(commitment);
+        }
+
+        for (const Commitment& commitment : removed) {
+            sum.Subtract(commitment);
+        }
+
+        return sum.Total();
+    }
+
+    mw::Hash m_headerHash{ ZERO_HASH };
+    Commitment m_utxoSum;
+    Commitment m_kernelSum;
+    uint64_t m_peggedSupply{ 0 };
+};
+
+END_NAMESPACE
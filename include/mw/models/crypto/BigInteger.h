@@ -6,7 +6,6 @@
 
 #include <mw/util/BitUtil.h>
 #include <mw/util/HexUtil.h>
-#include <mw/traits/Printable.h>
 #include <mw/serialization/Serializer.h>
 
 #include <cassert>
@@ -18,42 +17,38 @@
 #include <iomanip>
 #include <algorithm>
 #include <array>
+#include <cstring>
 
 #pragma warning(disable: 4505)
 
-template<size_t NUM_BYTES, class ALLOC = std::allocator<uint8_t>>
-class BigInt : public Traits::IPrintable, public Traits::ISerializable
+//
+// A fixed-size big-endian integer, stored inline rather than on the heap.
+// It has no virtual methods and no destructor, so it's trivially copyable, and so are the public
+// types built on it (mw::Hash, Commitment, Signature, PublicKey). Secret types (SecretKey, BlindingFactor)
+// wipe their own bytes when destroyed.
+//
+template<size_t NUM_BYTES>
+class BigInt
 {
 public:
     //
     // Constructors
     //
-    BigInt() noexcept : m_bytes(NUM_BYTES) { }
-    BigInt(const std::vector<uint8_t, ALLOC>& bytes) : m_bytes(bytes) { assert(bytes.size() == NUM_BYTES); }
-    BigInt(std::vector<uint8_t, ALLOC>&& bytes) : m_bytes(std::move(bytes)) { assert(bytes.size() == NUM_BYTES); }
-    BigInt(const std::array<uint8_t, NUM_BYTES>& bytes) : m_bytes(bytes.cbegin(), bytes.cend()) { }
-    explicit BigInt(const uint8_t* arr) : m_bytes(arr, arr + NUM_BYTES) { }
+    BigInt() noexcept : m_bytes{ } { }
+    BigInt(const std::vector<uint8_t>& bytes) { assert(bytes.size() == NUM_BYTES); std::copy_n(bytes.cbegin(), NUM_BYTES, m_bytes.begin()); }
+    BigInt(const std::array<uint8_t, NUM_BYTES>& bytes) noexcept : m_bytes(bytes) { }
+    explicit BigInt(const uint8_t* arr) { std::copy_n(arr, NUM_BYTES, m_bytes.begin()); }
     BigInt(const BigInt& bigInteger) = default;
     BigInt(BigInt&& bigInteger) noexcept = default;
 
-    //
-    // Destructor
-    //
-    virtual ~BigInt()
-    {
-        for (size_t i = 0; i < m_bytes.size(); i++)
-        {
-            m_bytes[i] = 0;
-        }
-    }
-
-    static size_t size() noexcept { return NUM_BYTES; }
-    const std::vector<uint8_t, ALLOC>& vec() const { return m_bytes; }
-    uint8_t* data() { return m_bytes.data(); }
-    const uint8_t* data() const { return m_bytes.data(); }
+    static constexpr size_t size() noexcept { return NUM_BYTES; }
+    std::vector<uint8_t> vec() const { return std::vector<uint8_t>(m_bytes.cbegin(), m_bytes.cend()); }
+    uint8_t* data() noexcept { return m_bytes.data(); }
+    const uint8_t* data() const noexcept { return m_bytes.data(); }
+    const uint8_t* cbegin() const noexcept { return m_bytes.data(); }
+    const uint8_t* cend() const noexcept { return m_bytes.data() + NUM_BYTES; }
     bool IsZero() const noexcept
     {
-        assert(m_bytes.size() == NUM_BYTES);
         for (uint8_t byte : m_bytes)
         {
             if (byte != 0) {
@@ -64,41 +59,32 @@ public:
         return true;
     }
 
-    static BigInt<NUM_BYTES, ALLOC> ValueOf(const uint8_t value)
+    static BigInt<NUM_BYTES> ValueOf(const uint8_t value)
     {
-        std::vector<uint8_t, ALLOC> bytes(NUM_BYTES);
-        bytes[NUM_BYTES - 1] = value;
-        return BigInt<NUM_BYTES, ALLOC>(std::move(bytes));
+        BigInt<NUM_BYTES> result;
+        result[NUM_BYTES - 1] = value;
+        return result;
     }
 
-    static BigInt<NUM_BYTES, ALLOC> FromHex(const std::string& hex)
+    static BigInt<NUM_BYTES> FromHex(const std::string& hex)
     {
         assert(hex.length() == NUM_BYTES * 2);
         std::vector<uint8_t> bytes = HexUtil::FromHex(hex);
         assert(bytes.size() == NUM_BYTES);
-        return BigInt<NUM_BYTES, ALLOC>(std::move(bytes));
+        return BigInt<NUM_BYTES>(bytes);
     }
 
-    static BigInt<NUM_BYTES, ALLOC> Max()
+    static BigInt<NUM_BYTES> Max()
     {
-        std::vector<uint8_t, ALLOC> bytes(NUM_BYTES);
-        for (int i = 0; i < NUM_BYTES; i++)
-        {
-            bytes[i] = 0xFF;
-        }
-
-        return BigInt<NUM_BYTES, ALLOC>(std::move(bytes));
+        BigInt<NUM_BYTES> result;
+        result.m_bytes.fill(0xFF);
+        return result;
     }
 
-    std::array<uint8_t, NUM_BYTES> ToArray() const noexcept
-    {
-        std::array<uint8_t, NUM_BYTES> arr;
-        std::copy_n(m_bytes.begin(), NUM_BYTES, arr.begin());
-        return arr;
-    }
+    const std::array<uint8_t, NUM_BYTES>& ToArray() const noexcept { return m_bytes; }
 
-    std::string ToHex() const noexcept { return HexUtil::ToHex(m_bytes); }
-    std::string Format() const noexcept final { return ToHex(); }
+    std::string ToHex() const noexcept { return HexUtil::ToHex(m_bytes.data(), NUM_BYTES); }
+    std::string Format() const noexcept { return ToHex(); }
 
     //
     // Operators
@@ -108,7 +94,7 @@ public:
 
     BigInt operator^(const BigInt& rhs) const
     {
-        BigInt<NUM_BYTES, ALLOC> result = *this;
+        BigInt<NUM_BYTES> result = *this;
         for (size_t i = 0; i < NUM_BYTES; i++)
         {
             result[i] ^= rhs[i];
@@ -122,21 +108,7 @@ public:
 
     bool operator<(const BigInt& rhs) const noexcept
     {
-        if (this == &rhs)
-        {
-            return false;
-        }
-
-        assert(m_bytes.size() == NUM_BYTES && rhs.m_bytes.size() == NUM_BYTES);
-        for (size_t i = 0; i < NUM_BYTES; i++)
-        {
-            if (m_bytes[i] != rhs.m_bytes[i])
-            {
-                return m_bytes[i] < rhs.m_bytes[i];
-            }
-        }
-
-        return false;
+        return std::memcmp(m_bytes.data(), rhs.m_bytes.data(), NUM_BYTES) < 0;
     }
 
     bool operator>(const BigInt& rhs) const
@@ -146,7 +118,7 @@ public:
 
     bool operator==(const BigInt& rhs) const
     {
-        return this == &rhs || this->m_bytes == rhs.m_bytes;
+        return std::memcmp(m_bytes.data(), rhs.m_bytes.data(), NUM_BYTES) == 0;
     }
 
     bool operator!=(const BigInt& rhs) const
@@ -156,12 +128,12 @@ public:
 
     bool operator<=(const BigInt& rhs) const
     {
-        return *this < rhs || *this == rhs;
+        return !(rhs < *this);
     }
 
     bool operator>=(const BigInt& rhs) const
     {
-        return *this > rhs || *this == rhs;
+        return !(*this < rhs);
     }
 
     BigInt operator^=(const BigInt& rhs)
@@ -174,21 +146,21 @@ public:
     //
     // Serialization/Deserialization
     //
-    Serializer& Serialize(Serializer& serializer) const noexcept final
+    Serializer& Serialize(Serializer& serializer) const noexcept
     {
         return serializer.Append(m_bytes);
     }
 
-    static BigInt<NUM_BYTES, ALLOC> Deserialize(Deserializer& deserializer)
+    static BigInt<NUM_BYTES> Deserialize(Deserializer& deserializer)
     {
-        return BigInt<NUM_BYTES, ALLOC>(deserializer.ReadVector(NUM_BYTES));
+        return BigInt<NUM_BYTES>(deserializer.ReadBytes(NUM_BYTES));
     }
 
 #ifdef INCLUDE_TEST_MATH
     // Not safe for use in production code
     BigInt operator/(const int divisor) const
     {
-        std::vector<uint8_t, ALLOC> quotient(NUM_BYTES);
+        BigInt<NUM_BYTES> quotient;
 
         int remainder = 0;
         for (int i = 0; i < NUM_BYTES; i++)
@@ -198,10 +170,10 @@ public:
             remainder -= quotient[i] * divisor;
         }
 
-        return BigInt<NUM_BYTES, ALLOC>(std::move(quotient));
+        return quotient;
     }
 #endif
 
 private:
-    std::vector<uint8_t, ALLOC> m_bytes;
-};
\ No newline at end of file
+    std::array<uint8_t, NUM_BYTES> m_bytes;
+};
@@ -24,7 +24,7 @@ public:
     //
     // Destructor
     //
-    virtual ~BlindingFactor() = default;
+    virtual ~BlindingFactor() { memory_cleanse(m_value.data(), m_value.size()); }
 
     //
     // Operators
@@ -39,7 +39,7 @@ public:
     // Getters
     //
     const BigInt<32>& GetBigInt() const noexcept { return m_value; }
-    const std::vector<uint8_t>& vec() const noexcept { return m_value.vec(); }
+    std::vector<uint8_t> vec() const { return m_value.vec(); }
     const uint8_t* data() const noexcept { return m_value.data(); }
     uint8_t* data() noexcept { return m_value.data(); }
     size_t size() const noexcept { return m_value.size(); }
@@ -13,10 +13,10 @@
 #include <boost/container_hash/hash.hpp>
 #include <cassert>
 
-class Commitment :
-    public Traits::IPrintable,
-    public Traits::ISerializable,
-    public Traits::IJsonable
+//
+// A pedersen commitment. Trivially copyable, so it can be stored and copied without heap allocations.
+//
+class Commitment
 {
 public:
     static constexpr size_t const& SIZE = 33;
@@ -30,11 +30,6 @@ public:
     Commitment(const Commitment& other) = default;
     Commitment(Commitment&& other) noexcept = default;
 
-    //
-    // Destructor
-    //
-    virtual ~Commitment() = default;
-
     //
     // Operators
     //
@@ -48,7 +43,7 @@ public:
     // Getters
     //
     const BigInt<SIZE>& GetBigInt() const noexcept { return m_bytes; }
-    const std::vector<uint8_t>& vec() const noexcept { return m_bytes.vec(); }
+    std::vector<uint8_t> vec() const { return m_bytes.vec(); }
     const uint8_t* data() const noexcept { return m_bytes.data(); }
     uint8_t* data() noexcept { return m_bytes.data(); }
     size_t size() const noexcept { return m_bytes.size(); }
@@ -57,7 +52,7 @@ public:
     //
     // Serialization/Deserialization
     //
-    Serializer& Serialize(Serializer& serializer) const noexcept final
+    Serializer& Serialize(Serializer& serializer) const noexcept
     {
         return m_bytes.Serialize(serializer);
     }
@@ -67,7 +62,7 @@ public:
         return Commitment(BigInt<SIZE>::Deserialize(deserializer));
     }
 
-    json ToJSON() const noexcept final
+    json ToJSON() const noexcept
     {
         return json(m_bytes.ToHex());
     }
@@ -83,7 +78,7 @@ public:
     //
     // Traits
     //
-    std::string Format() const final { return m_bytes.Format(); }
+    std::string Format() const { return m_bytes.Format(); }
 
 private:
     BigInt<SIZE> m_bytes;
@@ -96,7 +91,7 @@ namespace std
     {
         size_t operator()(const Commitment& commitment) const
         {
-            return boost::hash_value(commitment.vec());
+            return boost::hash_range(commitment.data(), commitment.data() + commitment.size());
         }
     };
 }
\ No newline at end of file
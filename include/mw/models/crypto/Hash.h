@@ -24,7 +24,7 @@ namespace std
     {
         size_t operator()(const mw::Hash& hash) const
         {
-            return boost::hash_value(hash.vec());
+            return boost::hash_range(hash.cbegin(), hash.cend());
         }
     };
 }
\ No newline at end of file
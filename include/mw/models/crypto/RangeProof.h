@@ -4,6 +4,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
+#include <mw/common/ObjectPool.h>
 #include <mw/traits/Printable.h>
 #include <mw/traits/Serializable.h>
 #include <mw/traits/Jsonable.h>
@@ -18,18 +18,23 @@ public:
     secret_key_t() = default;
     secret_key_t(BigInt<NUM_BYTES>&& value) : m_value(std::move(value)) { }
     secret_key_t(const SecureVector& bytes) : m_value(BigInt<NUM_BYTES>(bytes.data())) { }
-    secret_key_t(std::vector<uint8_t>&& bytes) : m_value(BigInt<NUM_BYTES>(std::move(bytes))) { }
+    secret_key_t(std::vector<uint8_t>&& bytes) : m_value(BigInt<NUM_BYTES>(bytes)) { memory_cleanse(bytes.data(), bytes.size()); }
+    secret_key_t(const secret_key_t& other) = default;
+    secret_key_t(secret_key_t&& other) noexcept = default;
 
     //
     // Destructor
     //
-    virtual ~secret_key_t() = default;
+    virtual ~secret_key_t() { memory_cleanse(m_value.data(), m_value.size()); }
+
+    secret_key_t& operator=(const secret_key_t& other) = default;
+    secret_key_t& operator=(secret_key_t&& other) noexcept = default;
 
     //
     // Getters
     //
     const BigInt<NUM_BYTES>& GetBigInt() const { return m_value; }
-    const std::vector<uint8_t>& vec() const { return m_value.vec(); }
+    std::vector<uint8_t> vec() const { return m_value.vec(); }
     uint8_t* data() { return m_value.data(); }
     const uint8_t* data() const { return m_value.data(); }
     size_t size() const { return m_value.size(); }
@@ -48,7 +53,8 @@ public:
     }
 
 private:
-    BigInt<NUM_BYTES> m_value; // TODO: Use SecureAllocator
+    // Wiped on destruction. Copies made with GetBigInt() aren't, so avoid them where possible.
+    BigInt<NUM_BYTES> m_value;
 };
 
 using SecretKey = secret_key_t<32>;
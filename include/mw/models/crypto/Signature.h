@@ -9,10 +9,7 @@
 #include <mw/traits/Serializable.h>
 #include <mw/traits/Jsonable.h>
 
-class Signature :
-    public Traits::IPrintable,
-    public Traits::ISerializable,
-    public Traits::IJsonable
+class Signature
 {
 public:
     using UPtr = std::unique_ptr<const Signature>;
@@ -28,11 +25,6 @@ public:
     Signature(const Signature& other) = default;
     Signature(Signature&& other) noexcept = default;
 
-    //
-    // Destructor
-    //
-    virtual ~Signature() = default;
-
     //
     // Operators
     //
@@ -46,14 +38,15 @@ public:
     // Getters
     //
     const BigInt<SIZE>& GetBigInt() const { return m_bytes; }
-    const std::vector<uint8_t>& vec() const { return m_bytes.vec(); }
+    std::vector<uint8_t> vec() const { return m_bytes.vec(); }
+    size_t size() const noexcept { return m_bytes.size(); }
     const uint8_t* data() const { return m_bytes.data(); }
     uint8_t* data() { return m_bytes.data(); }
 
     //
     // Serialization/Deserialization
     //
-    Serializer& Serialize(Serializer& serializer) const noexcept final
+    Serializer& Serialize(Serializer& serializer) const noexcept
     {
         return m_bytes.Serialize(serializer);
     }
@@ -63,7 +56,7 @@ public:
         return Signature(BigInt<SIZE>::Deserialize(deserializer));
     }
 
-    json ToJSON() const noexcept final
+    json ToJSON() const noexcept
     {
         return json(m_bytes.ToHex());
     }
@@ -79,7 +72,7 @@ public:
     //
     // Traits
     //
-    std::string Format() const final { return m_bytes.Format(); }
+    std::string Format() const { return m_bytes.Format(); }
 
 private:
     // The 64 byte Signature.
@@ -93,6 +86,4 @@ public:
 
     CompactSignature() = default;
     CompactSignature(BigInt<SIZE>&& bytes) : Signature(std::move(bytes)) { }
-
-    virtual ~CompactSignature() = default;
 };
\ No newline at end of file
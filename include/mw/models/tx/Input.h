@@ -4,6 +4,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
+#include <mw/common/Lazy.h>
 #include <mw/models/tx/Features.h>
 #include <mw/crypto/Hasher.h>
 #include <mw/traits/Committed.h>
@@ -25,12 +26,7 @@ public:
     // Constructors
     //
     Input(const EOutputFeatures features, Commitment&& commitment)
-        : m_features(features), m_commitment(std::move(commitment))
-    {
-        Serializer serializer;
-        Serialize(serializer);
-        m_hash = Hashed(serializer.vec());
-    }
+        : m_features(features), m_commitment(std::move(commitment)) { }
     Input(const Input& input) = default;
     Input(Input&& input) noexcept = default;
     Input() = default;
@@ -45,8 +41,8 @@ public:
     //
     Input& operator=(const Input& input) = default;
     Input& operator=(Input&& input) noexcept = default;
-    bool operator<(const Input& input) const noexcept { return m_hash < input.m_hash; }
-    bool operator==(const Input& input) const noexcept { return m_hash == input.m_hash; }
+    bool operator<(const Input& input) const noexcept { return GetHash() < input.GetHash(); }
+    bool operator==(const Input& input) const noexcept { return GetHash() == input.GetHash(); }
 
     //
     // Getters
@@ -92,7 +88,7 @@ public:
     //
     // Traits
     //
-    mw::Hash GetHash() const noexcept final { return m_hash; }
+    mw::Hash GetHash() const noexcept final { return m_hash.Get([this]() { return Hashed(*this); }); }
 
 private:
     // The features of the output being spent. 
@@ -102,5 +98,5 @@ private:
     // The commit referencing the output being spent.
     Commitment m_commitment;
 
-    mutable mw::Hash m_hash;
+    Lazy<mw::Hash> m_hash;
 };
\ No newline at end of file
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <mw/common/Lazy.h>
 #include <mw/common/Macros.h>
 #include <mw/crypto/Crypto.h>
 #include <mw/crypto/Hasher.h>
@@ -37,7 +38,6 @@ public:
         m_lockHeight(lockHeight),
         m_excess(std::move(excess)),
         m_signature(std::move(signature)),
-        m_hash(boost::none),
         m_amount(amount),
         m_address(std::move(address)),
         m_extraData(std::move(extraData))
@@ -115,44 +115,50 @@ public:
     const Commitment& GetExcess() const noexcept { return m_excess; }
     const Signature& GetSignature() const noexcept { return m_signature; }
 
+    //
+    // The message the signature signs. Computed once, then cached, since validation and the mempool
+    // check each kernel's signature repeatedly.
+    //
     mw::Hash GetSignatureMessage() const
     {
-        Serializer serializer;
-        serializer.Append<uint8_t>(m_features);
+        return m_signatureMessage.Get([this]() {
+            Serializer serializer;
+            serializer.Append<uint8_t>(m_features);
 
-        switch (m_features)
-        {
-            case KernelType::PLAIN_KERNEL:
-            {
-                serializer.Append<uint64_t>(m_fee);
-                break;
-            }
-            case KernelType::PEGIN_KERNEL:
-            {
-                serializer.Append<uint64_t>(m_amount);
-                break;
-            }
-            case KernelType::PEGOUT_KERNEL:
-            {
-                serializer.Append<uint64_t>(m_fee);
-                serializer.Append<uint64_t>(m_amount);
-                serializer.Append(m_address.value());
-                break;
-            }
-            case KernelType::HEIGHT_LOCKED:
-            {
-                serializer.Append<uint64_t>(m_fee);
-                serializer.Append<uint64_t>(m_lockHeight);
-                break;
-            }
-            default:
+            switch (m_features)
             {
-                serializer.Append<uint64_t>(m_fee);
-                serializer.Append(m_extraData);
+                case KernelType::PLAIN_KERNEL:
+                {
+                    serializer.Append<uint64_t>(m_fee);
+                    break;
+                }
+                case KernelType::PEGIN_KERNEL:
+                {
+                    serializer.Append<uint64_t>(m_amount);
+                    break;
+                }
+                case KernelType::PEGOUT_KERNEL:
+                {
+                    serializer.Append<uint64_t>(m_fee);
+                    serializer.Append<uint64_t>(m_amount);
+                    serializer.Append(m_address.value());
+                    break;
+                }
+                case KernelType::HEIGHT_LOCKED:
+                {
+                    serializer.Append<uint64_t>(m_fee);
+                    serializer.Append<uint64_t>(m_lockHeight);
+                    break;
+                }
+                default:
+                {
+                    serializer.Append<uint64_t>(m_fee);
+                    serializer.Append(m_extraData);
+                }
             }
-        }
 
-        return Hashed(serializer.vec());
+            return Hashed(serializer.vec());
+        });
     }
 
     bool IsPegIn() const noexcept { return GetFeatures() == KernelType::PEGIN_KERNEL; }
@@ -209,6 +215,15 @@ public:
             .Append(m_signature);
     }
 
+    //
+    // Same as Serialized(), but computed once and then cached, e.g. for adding the kernel to the kernel MMR.
+    // The reference is valid for the lifetime of the kernel.
+    //
+    const std::vector<uint8_t>& GetSerialized() const
+    {
+        return m_serialized.GetRef([this]() { return Serialized(); });
+    }
+
     static Kernel Deserialize(Deserializer& deserializer)
     {
         uint8_t type = deserializer.Read<uint8_t>();
@@ -341,12 +356,7 @@ public:
     //
     mw::Hash GetHash() const noexcept final
     {
-        if (!m_hash.has_value())
-        {
-            m_hash = boost::make_optional(Hashed(*this));
-        }
-
-        return m_hash.value();
+        return m_hash.Get([this]() { return Hashed(GetSerialized()); });
     }
 
     const Commitment& GetCommitment() const noexcept final { return m_excess; }
@@ -369,8 +379,12 @@ private:
     // The signature proving the excess is a valid public key, which signs the transaction fee.
     Signature m_signature;
 
-    mutable boost::optional<mw::Hash> m_hash;
     uint64_t m_amount;
     boost::optional<Bech32Address> m_address;
     std::vector<uint8_t> m_extraData;
+
+    // Derived from the fields above, which never change.
+    Lazy<mw::Hash> m_hash;
+    Lazy<mw::Hash> m_signatureMessage;
+    Lazy<std::vector<uint8_t>> m_serialized;
 };
\ No newline at end of file
@@ -4,6 +4,7 @@
 // Distributed under the MIT software license, see the accompanying
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
+#include <mw/common/Lazy.h>
 #include <mw/models/tx/Features.h>
 #include <mw/models/tx/OutputId.h>
 #include <mw/models/crypto/RangeProof.h>
@@ -27,10 +28,7 @@ public:
     // Constructors
     //
     Output(const EOutputFeatures features, Commitment&& commitment, std::vector<uint8_t>&& extra_data, const RangeProof::CPtr& pProof)
-        : m_features(features), m_commitment(std::move(commitment)), m_extraData(std::move(extra_data)), m_pProof(pProof)
-    {
-        m_hash = Hashed(*this);
-    }
+        : m_features(features), m_commitment(std::move(commitment)), m_extraData(std::move(extra_data)), m_pProof(pProof) { }
     Output(const Output& Output) = default;
     Output(Output&& Output) noexcept = default;
     Output() = default;
@@ -45,8 +43,8 @@ public:
     //
     Output& operator=(const Output& Output) = default;
     Output& operator=(Output&& Output) noexcept = default;
-    bool operator<(const Output& Output) const noexcept { return m_hash < Output.m_hash; }
-    bool operator==(const Output& Output) const noexcept { return m_hash == Output.m_hash; }
+    bool operator<(const Output& Output) const noexcept { return GetHash() < Output.GetHash(); }
+    bool operator==(const Output& Output) const noexcept { return GetHash() == Output.GetHash(); }
 
     //
     // Getters
@@ -79,7 +77,7 @@ public:
         Commitment commitment = Commitment::Deserialize(deserializer);
         const uint8_t extra_data_len = deserializer.Read<uint8_t>();
         std::vector<uint8_t> extra_data = deserializer.ReadVector(extra_data_len);
-        RangeProof::CPtr pProof = std::make_shared<const RangeProof>(RangeProof::Deserialize(deserializer));
+        RangeProof::CPtr pProof = ObjectPool::MakeShared<const RangeProof>(RangeProof::Deserialize(deserializer));
         return Output(features, std::move(commitment), std::move(extra_data), pProof);
     }
 
@@ -99,14 +97,15 @@ public:
             OutputFeatures::FromString(json.GetRequired<std::string>("features")),
             json.GetRequired<Commitment>("commit"),
             HexUtil::FromHex(json.GetOr<std::string>("extra_data", "")),
-            std::make_shared<const RangeProof>(json.GetRequired<RangeProof>("proof"))
+            ObjectPool::MakeShared<const RangeProof>(json.GetRequired<RangeProof>("proof"))
         );
     }
 
     //
     // Traits
     //
-    mw::Hash GetHash() const noexcept final { return m_hash; }
+    // Hashing serializes the whole output, rangeproof included, so it's only done when first needed.
+    mw::Hash GetHash() const noexcept final { return m_hash.Get([this]() { return Hashed(*this); }); }
 
 private:
     // Options for an output's structure or use
@@ -121,5 +120,5 @@ private:
     // A proof that the commitment is in the right range
     RangeProof::CPtr m_pProof;
 
-    mutable mw::Hash m_hash;
+    Lazy<mw::Hash> m_hash;
 };
\ No newline at end of file
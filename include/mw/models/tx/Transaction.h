@@ -15,6 +15,7 @@
 #include <mw/traits/Hashable.h>
 #include <mw/traits/Jsonable.h>
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -30,6 +31,7 @@ class Transaction :
     public Traits::IJsonable
 {
 public:
+    using Ptr = std::shared_ptr<Transaction>;
     using CPtr = std::shared_ptr<const Transaction>;
 
     //
@@ -41,8 +43,10 @@ public:
         m_hash = Hashed(*this);
     }
 
-    Transaction(const Transaction& transaction) = default;
-    Transaction(Transaction&& transaction) noexcept = default;
+    Transaction(const Transaction& transaction)
+        : m_offset(transaction.m_offset), m_body(transaction.m_body), m_hash(transaction.m_hash), m_validated(transaction.WasValidated()) { }
+    Transaction(Transaction&& transaction) noexcept
+        : m_offset(std::move(transaction.m_offset)), m_body(std::move(transaction.m_body)), m_hash(std::move(transaction.m_hash)), m_validated(transaction.WasValidated()) { }
     Transaction() = default;
 
     //
@@ -53,8 +57,24 @@ public:
     //
     // Operators
     //
-    Transaction& operator=(const Transaction& transaction) = default;
-    Transaction& operator=(Transaction&& transaction) noexcept = default;
+    Transaction& operator=(const Transaction& transaction)
+    {
+        m_offset = transaction.m_offset;
+        m_body = transaction.m_body;
+        m_hash = transaction.m_hash;
+        m_validated = transaction.WasValidated();
+        return *this;
+    }
+
+    Transaction& operator=(Transaction&& transaction) noexcept
+    {
+        m_offset = std::move(transaction.m_offset);
+        m_body = std::move(transaction.m_body);
+        m_hash = std::move(transaction.m_hash);
+        m_validated = transaction.WasValidated();
+        return *this;
+    }
+
     bool operator<(const Transaction& transaction) const noexcept { return GetHash() < transaction.GetHash(); }
     bool operator==(const Transaction& transaction) const noexcept { return GetHash() == transaction.GetHash(); }
     bool operator!=(const Transaction& transaction) const noexcept { return GetHash() != transaction.GetHash(); }
@@ -108,6 +128,14 @@ public:
     std::string Format() const final { return GetHash().Format(); }
     mw::Hash GetHash() const noexcept final { return m_hash; }
 
+    //
+    // Set by TransactionValidator once the transaction passes validation,
+    // so it doesn't need to be verified again when building a block from it.
+    // Atomic, since transactions are shared between the mempool and validation threads.
+    //
+    bool WasValidated() const noexcept { return m_validated; }
+    void MarkAsValidated() noexcept { m_validated = true; }
+
 private:
     // The kernel "offset" k2 excess is k1G after splitting the key k = k1 + k2.
     BlindingFactor m_offset;
@@ -116,6 +144,8 @@ private:
     TxBody m_body;
 
     mutable mw::Hash m_hash;
+
+    std::atomic_bool m_validated{ false };
 };
 
 END_NAMESPACE
\ No newline at end of file
@@ -10,6 +10,7 @@
 #include <mw/models/tx/Input.h>
 #include <mw/models/tx/Output.h>
 #include <mw/models/tx/Kernel.h>
+#include <mw/consensus/Consensus.h>
 #include <mw/consensus/CutThrough.h>
 #include <mw/crypto/Schnorr.h>
 
@@ -55,6 +56,13 @@ public:
     const std::vector<Output>& GetOutputs() const noexcept { return m_outputs; }
     const std::vector<Kernel>& GetKernels() const noexcept { return m_kernels; }
 
+    size_t GetWeight() const noexcept
+    {
+        return (m_inputs.size() * Consensus::INPUT_WEIGHT)
+            + (m_outputs.size() * Consensus::OUTPUT_WEIGHT)
+            + (m_kernels.size() * Consensus::KERNEL_WEIGHT);
+    }
+
     uint64_t GetTotalFee() const noexcept
     {
         return std::accumulate(
@@ -145,22 +153,41 @@ public:
 
     void Validate() const
     {
+        ValidateWeight();
         CutThrough::VerifyCutThrough(m_inputs, m_outputs);
+        VerifyKernelSignatures();
+
+        // TODO: Verify Sorted
 
+        VerifyRangeProofs();
+    }
+
+    //
+    // The individual stages of Validate. These are independent of each other,
+    // so BlockValidator runs them concurrently.
+    //
+    void ValidateWeight() const
+    {
+        if (GetWeight() > Consensus::MAX_BLOCK_WEIGHT) {
+            ThrowValidation(EConsensusError::BLOCK_WEIGHT);
+        }
+    }
+
+    void VerifyKernelSignatures() const
+    {
         std::vector<std::tuple<Signature, Commitment, mw::Hash>> signatures;
         std::transform(
             m_kernels.cbegin(), m_kernels.cend(),
             std::back_inserter(signatures),
             [](const Kernel& kernel) { return std::make_tuple(kernel.GetSignature(), kernel.GetCommitment(), kernel.GetSignatureMessage()); }
         );
-        Schnorr::BatchVerify(signatures);
-
-        // TODO: Validate Weight
-        // TODO: Verify Sorted
+        if (!Schnorr::BatchVerify(signatures)) {
+            ThrowValidation(EConsensusError::KERNEL_SIG);
+        }
+    }
 
-        //
-        // Verify RangeProofs
-        //
+    void VerifyRangeProofs() const
+    {
         std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>> rangeProofs;
         std::transform(
             m_outputs.cbegin(), m_outputs.cend(),
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <mw/common/Macros.h>
+#include <mw/common/ObjectPool.h>
 #include <mw/models/tx/Output.h>
 #include <mw/mmr/LeafIndex.h>
 #include <mw/traits/Serializable.h>
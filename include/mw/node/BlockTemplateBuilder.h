@@ -0,0 +1,120 @@
+#pragma once
+
+#include <mw/common/Macros.h>
+#include <mw/consensus/Consensus.h>
+#include <mw/models/block/Block.h>
+#include <mw/models/tx/Transaction.h>
+#include <mw/node/CoinsView.h>
+
+#include <map>
+#include <set>
+#include <unordered_map>
+#include <unordered_set>
+
+MW_NAMESPACE
+
+//
+// Builds block templates for miners from a changing set of mempool transactions.
+//
+// Transactions are selected greedily by fee rate (fee per unit of weight) until the weight limit is reached.
+// A transaction spending outputs of another unconfirmed transaction is only selected along with its parent.
+// Of the candidates spending the same output, at most one is selected.
+// Likewise, a candidate creating an output or kernel that's already selected is skipped.
+// The selected inputs, outputs and kernels are kept sorted, with cut-through already applied,
+// and the total offset and fees are updated as transactions are selected or dropped,
+// so a template only needs to be rebuilt when the selection actually changed.
+//
+// Each template is built on a fresh CoinsViewCache forked from the base, so the base is never modified.
+// The builder is tied to the base's current tip; create a new one when the tip changes.
+//
+class BlockTemplateBuilder
+{
+public:
+    using Ptr = std::shared_ptr<BlockTemplateBuilder>;
+
+    BlockTemplateBuilder(const ICoinsView::Ptr& pBase, const uint64_t height, const size_t maxWeight = Consensus::MAX_BLOCK_WEIGHT)
+        : m_pBase(pBase), m_height(height), m_maxWeight(maxWeight), m_weight(0), m_totalFee(0), m_numUnvalidated(0), m_reselect(false) { }
+
+    //
+    // Adds the transaction as a candidate, selecting it right away if it fits.
+    // The transaction is expected to have been validated against the mempool already.
+    //
+    void AddTransaction(const mw::Transaction::CPtr& pTransaction);
+
+    //
+    // Removes the transaction. Any selected transactions spending its outputs are dropped from the template,
+    // but remain candidates in case their inputs show up again.
+    //
+    void RemoveTransaction(const mw::Hash& txHash);
+
+    //
+    // Returns a block containing the selected transactions.
+    // The same block is returned until the selection changes.
+    //
+    mw::Block::Ptr GetTemplate();
+
+    size_t GetWeight() const noexcept { return m_weight; }
+    uint64_t GetTotalFee() const noexcept { return m_totalFee; }
+    size_t GetNumSelected() const noexcept { return m_selected.size(); }
+    bool IsSelected(const mw::Hash& txHash) const noexcept { return m_selected.find(txHash) != m_selected.cend(); }
+
+private:
+    struct Candidate
+    {
+        mw::Transaction::CPtr pTransaction;
+        size_t weight;
+        uint64_t fee;
+        double feeRate;
+
+        // Inputs not found in the base. These must be created by selected transactions.
+        std::vector<Commitment> unconfirmedInputs;
+    };
+
+    // Highest fee rate first, ties broken by hash so the order is deterministic.
+    using FeeRateKey = std::pair<double, mw::Hash>;
+    struct FeeRateOrder
+    {
+        bool operator()(const FeeRateKey& a, const FeeRateKey& b) const
+        {
+            return a.first > b.first || (a.first == b.first && a.second < b.second);
+        }
+    };
+
+    bool TrySelect(const Candidate& candidate);
+    void Select(const Candidate& candidate);
+    void Deselect(const Candidate& candidate);
+    void SelectDependents(const mw::Transaction& transaction);
+    void DeselectDependents(const mw::Transaction& transaction);
+    void Reselect();
+
+    ICoinsView::Ptr m_pBase;
+    uint64_t m_height;
+    size_t m_maxWeight;
+
+    std::unordered_map<mw::Hash, Candidate> m_candidates;
+    std::set<FeeRateKey, FeeRateOrder> m_byFeeRate;
+
+    // Commitment -> hashes of the candidates spending it. Conflicting candidates can spend the same commitment.
+    std::unordered_map<Commitment, std::unordered_set<mw::Hash>> m_spentBy;
+
+    //
+    // Selection
+    //
+    std::unordered_set<mw::Hash> m_selected;
+    std::unordered_map<Commitment, const Output*> m_selectedOutputs;
+    std::unordered_set<Commitment> m_selectedSpends;
+    std::unordered_set<Commitment> m_cutThrough;
+    std::map<mw::Hash, Input> m_inputs;
+    std::map<mw::Hash, Output> m_outputs;
+    std::map<mw::Hash, Kernel> m_kernels;
+    BlindingFactor m_offset;
+    size_t m_weight;
+    uint64_t m_totalFee;
+    size_t m_numUnvalidated;
+
+    // Set when a candidate could displace a selected transaction, or room was freed up.
+    bool m_reselect;
+    mw::Block::Ptr m_pTemplate;
+};
+
+END_NAMESPACE
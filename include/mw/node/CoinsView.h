@@ -4,12 +4,19 @@
 #include <mw/models/block/Header.h>
 #include <mw/models/block/Block.h>
 #include <mw/models/block/BlockUndo.h>
+#include <mw/models/block/StateAggregates.h>
 #include <mw/models/tx/Transaction.h>
 #include <mw/models/tx/UTXO.h>
 #include <mw/mmr/MMR.h>
 #include <mw/mmr/LeafSet.h>
+#include <mw/util/MemoryUtil.h>
+#include <mw/common/TaskQueue.h>
 #include <libmw/interfaces.h>
+#include <atomic>
+#include <deque>
+#include <limits>
 #include <memory>
+#include <shared_mutex>
 
 // Forward Declarations
 class CoinDB;
@@ -32,6 +39,7 @@ public:
 
     void AddUTXO(const UTXO::CPtr& pUTXO)
     {
+        m_memoryUsage += GetHeapUsage(*pUTXO);
         AddAction(pUTXO->GetCommitment(), CoinAction{ pUTXO });
     }
 
@@ -42,6 +50,10 @@ public:
 
     const std::unordered_map<Commitment, std::vector<CoinAction>>& GetActions() const noexcept { return m_actions; }
 
+    // Changes to the running totals, which are only summed once they reach the database (or are asked for).
+    mw::StateAggregates::Changes& GetAggregateChanges() noexcept { return m_aggregateChanges; }
+    const mw::StateAggregates::Changes& GetAggregateChanges() const noexcept { return m_aggregateChanges; }
+
     std::vector<CoinAction> GetActions(const Commitment& commitment) const
     {
         auto iter = m_actions.find(commitment);
@@ -54,25 +66,55 @@ public:
 
     void Clear() noexcept
     {
-        m_actions.clear();
+        std::unordered_map<Commitment, std::vector<CoinAction>>().swap(m_actions);
+        m_aggregateChanges = mw::StateAggregates::Changes{};
+        m_memoryUsage = 0;
     }
 
+    //
+    // Returns the approximate number of bytes of memory held by the actions, including the UTXOs they reference.
+    // UTXOs are counted in full, even when their rangeproofs are still shared with a block.
+    //
+    size_t GetMemoryUsage() const noexcept { return m_memoryUsage + MemoryUtil::BucketUsage(m_actions); }
+
 private:
     void AddAction(const Commitment commitment, CoinAction&& action)
     {
         auto iter = m_actions.find(commitment);
         if (iter != m_actions.end()) {
             std::vector<CoinAction>& actions = iter->second;
+            const size_t prevUsage = MemoryUtil::DynamicUsage(actions);
             actions.emplace_back(std::move(action));
+            m_memoryUsage += MemoryUtil::DynamicUsage(actions) - prevUsage;
         } else {
             std::vector<CoinAction> actions;
             actions.emplace_back(std::move(action));
-            m_actions.insert({ commitment, actions });
+            m_memoryUsage += MemoryUtil::MapNodeUsage<Commitment, std::vector<CoinAction>>()
+                + MemoryUtil::DynamicUsage(actions);
+            m_actions.insert({ commitment, std::move(actions) });
         }
     }
 
+    static size_t GetHeapUsage(const UTXO& utxo) noexcept
+    {
+        const Output& output = utxo.GetOutput();
+
+        size_t usage = MemoryUtil::SharedPtrUsage<UTXO>()
+            + MemoryUtil::DynamicUsage(output.GetExtraData());
+        if (output.GetRangeProof() != nullptr) {
+            usage += MemoryUtil::SharedPtrUsage<RangeProof>() + MemoryUtil::DynamicUsage(output.GetRangeProof()->vec());
+        }
+
+        return usage;
+    }
+
     // TODO: Handle sorting of kernels & UTXOs per block... Just use a vector of TxBody's?
     std::unordered_map<Commitment, std::vector<CoinAction>> m_actions;
+
+    mw::StateAggregates::Changes m_aggregateChanges;
+
+    // Memory owned by the map's nodes and the UTXOs they reference, tracked as actions are added.
+    size_t m_memoryUsage{ 0 };
 };
 
 //
@@ -86,13 +128,24 @@ public:
     using Ptr = std::shared_ptr<ICoinsView>;
     using CPtr = std::shared_ptr<const ICoinsView>;
 
-    ICoinsView(const mw::Header::CPtr& pHeader)
-        : m_pHeader(pHeader) { }
+    ICoinsView(const mw::Header::CPtr& pHeader, const mw::StateAggregates::CPtr& pAggregates = nullptr)
+        : m_pHeader(pHeader), m_pAggregates(pAggregates) { }
     virtual ~ICoinsView() = default;
 
     void SetBestHeader(const mw::Header::CPtr& pHeader) noexcept { m_pHeader = pHeader; }
     mw::Header::CPtr GetBestHeader() const noexcept { return m_pHeader; }
 
+    //
+    // The running totals (UTXO sum, kernel excess sum, pegged supply) as of the best header.
+    // These are nullptr when they aren't being tracked, e.g. for a database written before they existed.
+    //
+    void SetAggregates(const mw::StateAggregates::CPtr& pAggregates) noexcept { m_pAggregates = pAggregates; }
+    virtual mw::StateAggregates::CPtr GetAggregates() const { return m_pAggregates; }
+    virtual bool HasAggregates() const noexcept { return m_pAggregates != nullptr; }
+
+    // The pegged supply as of the best header, without summing the UTXOs and kernels. Requires HasAggregates().
+    virtual uint64_t GetPeggedSupply() const { return m_pAggregates->GetPeggedSupply(); }
+
     // Virtual functions
     virtual std::vector<UTXO::CPtr> GetUTXOs(const Commitment& commitment) const = 0;
     virtual void WriteBatch(
@@ -111,6 +164,7 @@ protected:
 
 private:
     mw::Header::CPtr m_pHeader;
+    mw::StateAggregates::CPtr m_pAggregates;
 };
 
 class CoinsViewCache : public mw::ICoinsView
@@ -127,23 +181,75 @@ public:
         m_pOutputPMMR(std::make_unique<mmr::MMRCache>(pBase->GetOutputPMMR())),
         m_pRangeProofPMMR(std::make_unique<mmr::MMRCache>(pBase->GetRangeProofPMMR())),
         m_pUpdates(std::make_shared<CoinsViewUpdates>()) { }
+    ~CoinsViewCache();
 
     std::vector<UTXO::CPtr> GetUTXOs(const Commitment& commitment) const final;
     mw::BlockUndo::CPtr ApplyBlock(const mw::Block::Ptr& pBlock);
     void UndoBlock(const mw::BlockUndo::CPtr& pUndo);
+
+    //
+    // Undoes multiple blocks, ordered from the current tip backwards.
+    // The UTXO changes are undone block by block, but the MMRs and leafset are rewound
+    // only once, to the state before the last (oldest) block.
+    //
+    void UndoBlocks(const std::vector<mw::BlockUndo::CPtr>& undos);
     void WriteBatch(
         const libmw::IDBBatch::UPtr& pBatch,
         const CoinsViewUpdates& updates,
         const mw::Header::CPtr& pHeader
     ) final;
     void Flush(const libmw::IDBBatch::UPtr& pBatch = nullptr);
+
+    //
+    // Starts flushing the cache's changes to the base view on a background thread, and returns
+    // without waiting for the write to finish. The cache stays fully usable in the meantime:
+    // reads of data still being written are served from an immutable snapshot of the changes.
+    // Each flush is written in its own batch, so it's only supported when the base is a CoinsViewDB.
+    // Otherwise, this falls back to a synchronous Flush.
+    //
+    // The base view must not be read directly until WaitForFlush returns.
+    // Blocks if too many flushes are already waiting to be written.
+    //
+    // If a flush fails, the base view and MMR files are left partly written, so the cache stops flushing for good:
+    // later flushes are skipped, and every call to Flush, FlushAsync or WaitForFlush rethrows the error.
+    //
+    void FlushAsync();
+
+    //
+    // Blocks until all flushes started by FlushAsync have been written to the base view.
+    // Rethrows the error if a flush failed.
+    //
+    void WaitForFlush();
+
     mw::Block::Ptr BuildNextBlock(const uint64_t height, const std::vector<mw::Transaction::CPtr>& transactions);
 
+    //
+    // Builds the next block from a transaction that was already aggregated (see Aggregation::Aggregate).
+    // Like the overload above, this applies the block to the cache, so it can only be called once per cache.
+    // The block is marked as validated when 'validated' is true.
+    //
+    mw::Block::Ptr BuildNextBlock(const uint64_t height, const mw::Transaction::CPtr& pTransaction, const bool validated);
+
     mmr::ILeafSet::Ptr GetLeafSet() const noexcept final { return m_pLeafSet; }
     mmr::IMMR::Ptr GetKernelMMR() const noexcept final { return m_pKernelMMR; }
     mmr::IMMR::Ptr GetOutputPMMR() const noexcept final { return m_pOutputPMMR; }
     mmr::IMMR::Ptr GetRangeProofPMMR() const noexcept final { return m_pRangeProofPMMR; }
 
+    //
+    // Blocks only record their changes to the running totals, and flushing passes those changes on to the base.
+    // They're summed when the totals are asked for, or when they reach the database,
+    // so connecting blocks one at a time doesn't re-sum the totals after each one.
+    //
+    mw::StateAggregates::CPtr GetAggregates() const final;
+    bool HasAggregates() const noexcept final { return m_pBase->HasAggregates(); }
+    uint64_t GetPeggedSupply() const final;
+
+    //
+    // Returns the approximate number of bytes of memory held by the cache's unflushed changes.
+    // This is tracked incrementally, so it's cheap enough to check after every block.
+    //
+    size_t GetMemoryUsage() const noexcept;
+
 private:
     void AddUTXO(const uint64_t header_height, const Output& output);
     UTXO SpendUTXO(const Commitment& commitment);
@@ -157,6 +263,36 @@ private:
 
     CoinsViewUpdates::Ptr m_pUpdates;
     //std::unordered_map<Commitment, std::vector<Action>> m_actions;
+
+    // The last totals returned by GetAggregates(), until there are more changes.
+    mutable mw::StateAggregates::CPtr m_pAggregates;
+
+    //
+    // Async flushing
+    //
+    struct PendingFlush
+    {
+        CoinsViewUpdates::Ptr pUpdates;
+        mw::Header::CPtr pHeader;
+        mmr::LeafSetCache::Snapshot::CPtr pLeafSet;
+        mmr::MMRCache::Snapshot::CPtr pKernelMMR;
+        mmr::MMRCache::Snapshot::CPtr pOutputPMMR;
+        mmr::MMRCache::Snapshot::CPtr pRangeProofPMMR;
+
+        // Set once pUpdates is in the base, so GetUTXOs stops applying them. Guarded by m_flushMutex.
+        bool updatesWritten;
+        std::atomic_bool complete;
+    };
+
+    void ReleaseCompletedFlushes();
+
+    TaskQueue::UPtr m_pFlushQueue;
+    std::deque<std::shared_ptr<PendingFlush>> m_pendingFlushes;
+    mutable std::shared_mutex m_flushMutex;
+
+    // Set by the flush thread when a flush fails. The failed flush's snapshots are never released.
+    std::atomic_bool m_flushFailed{ false };
+    std::exception_ptr m_pFlushError;
 };
 
 class CoinsViewDB : public mw::ICoinsView
@@ -168,8 +304,9 @@ public:
         const mmr::LeafSet::Ptr& pLeafSet,
         const mmr::MMR::Ptr& pKernelMMR,
         const mmr::MMR::Ptr& pOutputPMMR,
-        const mmr::MMR::Ptr& pRangeProofPMMR
-    ) : ICoinsView(pBestHeader),
+        const mmr::MMR::Ptr& pRangeProofPMMR,
+        const mw::StateAggregates::CPtr& pAggregates
+    ) : ICoinsView(pBestHeader, pAggregates),
         m_pDatabase(pDBWrapper),
         m_pLeafSet(pLeafSet),
         m_pKernelMMR(pKernelMMR),
@@ -202,6 +339,79 @@ private:
     mmr::MMR::Ptr m_pRangeProofPMMR;
 };
 
-// TODO: CoinsViewMempool
+//
+// A view of the UTXO set as it would be after all unconfirmed transactions in the mempool are included.
+// Transactions are indexed by the outputs they create and the inputs they spend, so double spends
+// are detected without touching the base view, and transactions may spend outputs of other unconfirmed transactions.
+//
+// This is read-only with respect to the base: MMRs are never modified, and WriteBatch is unsupported.
+// Unconfirmed UTXOs don't have a leaf index yet, and have a block height of UNCONFIRMED_HEIGHT.
+//
+class CoinsViewMempool : public mw::ICoinsView
+{
+public:
+    using Ptr = std::shared_ptr<CoinsViewMempool>;
+    using CPtr = std::shared_ptr<const CoinsViewMempool>;
+
+    static constexpr uint64_t UNCONFIRMED_HEIGHT = std::numeric_limits<uint64_t>::max();
+
+    CoinsViewMempool(const ICoinsView::Ptr& pBase)
+        : ICoinsView(pBase->GetBestHeader()), m_pBase(pBase) { }
+
+    std::vector<UTXO::CPtr> GetUTXOs(const Commitment& commitment) const final;
+    void WriteBatch(
+        const libmw::IDBBatch::UPtr& pBatch,
+        const CoinsViewUpdates& updates,
+        const mw::Header::CPtr& pHeader
+    ) final;
+
+    mmr::ILeafSet::Ptr GetLeafSet() const noexcept final { return m_pBase->GetLeafSet(); }
+    mmr::IMMR::Ptr GetKernelMMR() const noexcept final { return m_pBase->GetKernelMMR(); }
+    mmr::IMMR::Ptr GetOutputPMMR() const noexcept final { return m_pBase->GetOutputPMMR(); }
+    mmr::IMMR::Ptr GetRangeProofPMMR() const noexcept final { return m_pBase->GetRangeProofPMMR(); }
+
+    //
+    // Adds the transaction if all of its inputs are unspent, either in the base or in the mempool.
+    // Throws a ValidationException (UTXO_MISSING or DOUBLE_SPEND) without modifying the mempool otherwise.
+    // Performs no other validation, so the transaction must already have been checked.
+    //
+    void AddTransaction(const mw::Transaction::CPtr& pTransaction);
+
+    //
+    // Removes the transaction, along with any unconfirmed transactions that spend its outputs.
+    // Returns the removed transactions.
+    //
+    std::vector<mw::Transaction::CPtr> RemoveTransaction(const mw::Hash& txHash);
+
+    //
+    // Call after the block is connected to the base view.
+    // Removes transactions that were included in the block, and transactions that conflict with it,
+    // along with any unconfirmed transactions that spend outputs of those conflicting transactions.
+    // Returns the removed transactions.
+    //
+    std::vector<mw::Transaction::CPtr> RemoveForBlock(const mw::Block::CPtr& pBlock);
+
+    bool HasTransaction(const mw::Hash& txHash) const noexcept { return m_transactions.find(txHash) != m_transactions.cend(); }
+    size_t GetNumTransactions() const noexcept { return m_transactions.size(); }
+    std::vector<mw::Transaction::CPtr> GetTransactions() const;
+
+private:
+    struct CreatedOutput
+    {
+        mw::Hash txHash;
+        UTXO::CPtr pUTXO;
+    };
+
+    void RemoveTransaction(const mw::Hash& txHash, const bool removeDescendants, std::vector<mw::Transaction::CPtr>& removed);
+
+    ICoinsView::Ptr m_pBase;
+
+    std::unordered_map<mw::Hash, mw::Transaction::CPtr> m_transactions;
+
+    // Indexes of the unconfirmed transactions' inputs, outputs, and kernels, to the transactions' hashes.
+    std::unordered_map<Commitment, mw::Hash> m_spentBy;
+    std::unordered_map<Commitment, CreatedOutput> m_createdBy;
+    std::unordered_map<mw::Hash, mw::Hash> m_kernels;
+};
 
 END_NAMESPACE
\ No newline at end of file
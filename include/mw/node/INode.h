@@ -8,6 +8,7 @@
 #include <mw/models/block/Header.h>
 #include <mw/models/block/Block.h>
 #include <mw/models/block/BlockUndo.h>
+#include <mw/models/block/CompactBlockUndo.h>
 #include <mw/models/tx/Transaction.h>
 #include <mw/models/tx/PegInCoin.h>
 #include <mw/models/tx/PegOutCoin.h>
@@ -43,11 +44,54 @@ public:
     //
     virtual mw::BlockUndo::CPtr ConnectBlock(const mw::Block::Ptr& pBlock, const ICoinsView::Ptr& pView) = 0;
 
+    //
+    // Applies the blocks, in order, to a single cache on top of the supplied ICoinsView,
+    // and flushes that cache to the view once all blocks have been applied.
+    // The results are identical to calling ConnectBlock for each block, but without a flush per block.
+    // Consumer is required to call ValidateBlock on each block first.
+    //
+    // If maxCacheBytes is non-zero, the cache is also flushed whenever its memory usage exceeds it.
+    // This allows syncing directly against the CoinsViewDB with a bounded amount of memory.
+    //
+    // Returns the BlockUndo for each block, in the same order as the blocks.
+    // If a block fails to connect, every block before it is still connected to the view, and a
+    // ConnectBlocksException carrying their BlockUndos (and the failed block's exception) is thrown.
+    //
+    virtual std::vector<mw::BlockUndo::CPtr> ConnectBlocks(
+        const std::vector<mw::Block::Ptr>& blocks,
+        const ICoinsView::Ptr& pView,
+        const size_t maxCacheBytes
+    ) = 0;
+
     virtual void DisconnectBlock(
         const mw::BlockUndo::CPtr& pUndoData,
         const ICoinsView::Ptr& pView
     ) = 0;
 
+    //
+    // Disconnects the blocks using the supplied BlockUndos, which must be ordered from the
+    // current tip backwards. The MMRs and leafset are rewound directly to the fork point,
+    // so the roots are only validated, and the view only flushed, once.
+    // The results are identical to calling DisconnectBlock for each BlockUndo.
+    //
+    virtual void DisconnectBlocks(
+        const std::vector<mw::BlockUndo::CPtr>& undos,
+        const ICoinsView::Ptr& pView
+    ) = 0;
+
+    //
+    // Rebuilds the full BlockUndo from a CompactBlockUndo, reading each spent output and rangeproof
+    // back from the supplied ICoinsView's MMRs. This must be called before the block is disconnected.
+    // Leaves are verified against the MMR hashes, so if an output's data has been pruned from the MMRs,
+    // the output is instead looked up in the block it was created in, using pBlockStore.
+    // Throws NotFoundException if a spent output can't be found either way.
+    //
+    virtual mw::BlockUndo::CPtr ExpandUndo(
+        const mw::CompactBlockUndo::CPtr& pCompactUndo,
+        const ICoinsView::Ptr& pView,
+        const mw::IBlockStore* pBlockStore
+    ) const = 0;
+
     virtual mw::ICoinsView::Ptr ApplyState(
         const libmw::IDBWrapper::Ptr& pDBWrapper,
         const mw::IBlockStore& blockStore,
@@ -62,11 +106,18 @@ public:
 // Creates an instance of the node.
 // This will fail if an instance is already running.
 //
+// The state's running totals, saved with the best header, are checked against the header's total offset,
+// which takes constant time. When auditState is true, the entire UTXO set is also re-summed to make sure
+// the totals are right. The same audit runs automatically when no totals are saved for the best header,
+// e.g. for databases written before they were tracked, so they're tracked from then on.
+// Throws a ValidationException if the state doesn't balance.
+//
 INode::Ptr InitializeNode(
     const FilePath& datadir,
     const std::string& hrp,
     const mw::Header::CPtr& pBestHeader,
-    const libmw::IDBWrapper::Ptr& pDBWrapper
+    const libmw::IDBWrapper::Ptr& pDBWrapper,
+    const bool auditState = false
 );
 
 END_NAMESPACE
\ No newline at end of file
@@ -1,11 +1,26 @@
 #pragma once
 
 #include <mw/models/block/Block.h>
+#include <mw/common/ThreadPool.h>
 
+#include <chrono>
+#include <string>
+#include <utility>
+
+//
+// Validates a block, running the independent stages (cut-through, kernel signatures, rangeproofs, pegs, ...)
+// concurrently on a thread pool, with the calling thread running stages too. Once any stage fails,
+// the stages that haven't started are skipped, and Validate throws that stage's error after the running ones finish.
+// Since the caller takes part, Validate may be called from one of the pool's own threads.
+//
 class BlockValidator
 {
 public:
-    BlockValidator() = default;
+    // The time spent in each stage that succeeded during the last call to Validate, in completion order.
+    using Timings = std::vector<std::pair<std::string, std::chrono::microseconds>>;
+
+    BlockValidator(ThreadPool& pool = ThreadPool::GetShared())
+        : m_pool(pool) { }
 
     void Validate(
         const mw::Block::Ptr& pBlock,
@@ -13,14 +28,19 @@ public:
         const std::vector<PegOutCoin>& pegOutCoins
     );
 
+    const Timings& GetTimings() const noexcept { return m_timings; }
+
 private:
-    void ValidatePegInCoins(
+    static void ValidatePegInCoins(
         const mw::Block::CPtr& pBlock,
         const std::vector<PegInCoin>& pegInCoins
     );
 
-    void ValidatePegOutCoins(
+    static void ValidatePegOutCoins(
         const mw::Block::CPtr& pBlock,
         const std::vector<PegOutCoin>& pegOutCoins
     );
-};
\ No newline at end of file
+
+    ThreadPool& m_pool;
+    Timings m_timings;
+};
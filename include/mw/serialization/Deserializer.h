@@ -8,21 +8,41 @@
 #include <mw/exceptions/DeserializationException.h>
 #include <mw/traits/Serializable.h>
 
+#include <array>
 #include <vector>
 #include <string>
 #include <cstring>
 #include <cstdint>
 #include <algorithm>
-
+#include <type_traits>
+
+//
+// Reads serialized data, with integers big-endian (unless ReadLE is used).
+//
+// Vectors passed in are owned by the deserializer, so they can be temporaries.
+// To read from memory owned by someone else (e.g. a network buffer or a memory-mapped file) without copying it,
+// use the (pointer, size) constructor, in which case the memory must outlive the deserializer.
+//
 class Deserializer
 {
 public:
-    Deserializer(const std::vector<uint8_t>& bytes) : m_index(0), m_bytes(bytes) { }
-    Deserializer(std::vector<uint8_t>&& bytes) : m_index(0), m_bytes(std::move(bytes)) { }
-
+    Deserializer(const uint8_t* pData, const size_t size)
+        : m_pData(pData), m_size(size), m_index(0) { }
+    Deserializer(const std::vector<uint8_t>& bytes)
+        : m_owned(bytes), m_pData(m_owned.data()), m_size(m_owned.size()), m_index(0) { }
+    Deserializer(std::vector<uint8_t>&& bytes)
+        : m_owned(std::move(bytes)), m_pData(m_owned.data()), m_size(m_owned.size()), m_index(0) { }
+
+    // m_pData may point into m_owned, so copying would leave the copy pointing at the original's buffer.
+    Deserializer(const Deserializer&) = delete;
+    Deserializer& operator=(const Deserializer&) = delete;
+
+    // Only for integers. Everything else has its own Deserialize.
     template<typename T>
     T Read()
     {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+
         T value;
         ReadBigEndian<T>(value);
         return value;
@@ -31,6 +51,8 @@ public:
     template<typename T>
     T ReadLE()
     {
+        static_assert(std::is_integral_v<T> || std::is_enum_v<T>);
+
         T value;
         ReadLittleEndian<T>(value);
         return value;
@@ -39,23 +61,11 @@ public:
     std::string ReadVarStr()
     {
         const uint64_t stringLength = Read<uint64_t>();
-        if (stringLength == 0)
-        {
-            return "";
-        }
-
-        if (m_index + stringLength > m_bytes.size())
-        {
-            ThrowDeserialization("Attempted to read past end of buffer.");
-        }
-
-        std::vector<uint8_t> temp(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + stringLength);
-        m_index += stringLength;
-
-        return std::string((char*)temp.data(), stringLength);
+        const uint8_t* pString = ReadBytes(stringLength);
+        return std::string((const char*)pString, stringLength);
     }
 
-    template <class T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
+    template <class T>
     std::vector<T> ReadVec()
     {
         const uint64_t num_entries = Read<uint64_t>();
@@ -69,84 +79,66 @@ public:
 
     std::vector<uint8_t> ReadVector(const uint64_t numBytes)
     {
-        if (m_index + numBytes > m_bytes.size())
-        {
-            ThrowDeserialization("Attempted to read past end of buffer.");
-        }
-
-        const size_t index = m_index;
-        m_index += numBytes;
-
-        return std::vector<uint8_t>(m_bytes.cbegin() + index, m_bytes.cbegin() + index + numBytes);
+        const uint8_t* pBytes = ReadBytes(numBytes);
+        return std::vector<uint8_t>(pBytes, pBytes + numBytes);
     }
 
     template<size_t T>
     std::array<uint8_t, T> ReadArray()
     {
-        if (m_index + T > m_bytes.size())
+        const uint8_t* pBytes = ReadBytes(T);
+
+        std::array<uint8_t, T> arr;
+        memcpy(arr.data(), pBytes, T);
+        return arr;
+    }
+
+    //
+    // Returns a pointer to the next numBytes, and skips past them.
+    // The pointer is only valid for as long as the deserializer's memory is.
+    //
+    const uint8_t* ReadBytes(const uint64_t numBytes)
+    {
+        if (numBytes > GetRemainingSize())
         {
             ThrowDeserialization("Attempted to read past end of buffer.");
         }
 
-        const size_t index = m_index;
-        m_index += T;
-
-        std::array<uint8_t, T> arr;
-        std::copy(m_bytes.begin() + index, m_bytes.begin() + index + T, arr.begin());
-        return arr;
+        const uint8_t* pBytes = m_pData + m_index;
+        m_index += numBytes;
+        return pBytes;
     }
 
     size_t GetRemainingSize() const
     {
-        return m_bytes.size() - m_index;
+        return m_size - m_index;
     }
 
 private:
     template<class T>
     void ReadBigEndian(T& t)
     {
-        if (m_index + sizeof(T) > m_bytes.size())
-        {
-            ThrowDeserialization("Attempted to read past end of buffer.");
-        }
-
-        if (EndianUtil::IsBigEndian())
-        {
-            memcpy(&t, &m_bytes[m_index], sizeof(T));
+        memcpy(&t, ReadBytes(sizeof(T)), sizeof(T));
+        if constexpr (std::is_enum_v<T>) {
+            t = (T)EndianUtil::ToBigEndian((std::underlying_type_t<T>)t);
+        } else {
+            t = EndianUtil::ToBigEndian(t);
         }
-        else
-        {
-            std::vector<uint8_t> temp;
-            temp.resize(sizeof(T));
-            std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-            memcpy(&t, temp.data(), sizeof(T));
-        }
-
-        m_index += sizeof(T);
     }
 
     template<class T>
     void ReadLittleEndian(T& t)
     {
-        if (m_index + sizeof(T) > m_bytes.size())
-        {
-            ThrowDeserialization("Attempted to read past end of Deserializer.");
-        }
-
-        if (EndianUtil::IsBigEndian())
-        {
-            std::vector<uint8_t> temp((size_t)sizeof(T));
-            std::reverse_copy(m_bytes.cbegin() + m_index, m_bytes.cbegin() + m_index + sizeof(T), temp.begin());
-            memcpy(&t, temp.data(), sizeof(T));
+        memcpy(&t, ReadBytes(sizeof(T)), sizeof(T));
+        if constexpr (std::is_enum_v<T>) {
+            t = (T)EndianUtil::ToLittleEndian((std::underlying_type_t<T>)t);
+        } else {
+            t = EndianUtil::ToLittleEndian(t);
         }
-        else
-        {
-            memcpy(&t, &m_bytes[m_index], sizeof(T));
-        }
-
-        m_index += sizeof(T);
     }
 
+    std::vector<uint8_t> m_owned;
+    const uint8_t* m_pData;
+    size_t m_size;
     size_t m_index;
-    std::vector<uint8_t> m_bytes;
-};
+};
\ No newline at end of file
@@ -110,7 +110,7 @@ public:
     }
 
     template<class T>
-    typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>, T> GetRequired(const std::string& key) const
+    typename std::enable_if_t<Traits::is_jsonable_v<T>, T> GetRequired(const std::string& key) const
     {
         auto iter = m_json.find(key);
         if (iter != m_json.end())
@@ -122,7 +122,7 @@ public:
     }
 
     template<class T>
-    typename std::enable_if_t<!std::is_base_of_v<Traits::IJsonable, T>, T> GetRequired(const std::string& key) const
+    typename std::enable_if_t<!Traits::is_jsonable_v<T>, T> GetRequired(const std::string& key) const
     {
         auto iter = m_json.find(key);
         if (iter != m_json.end())
@@ -134,7 +134,7 @@ public:
     }
 
     template<class T>
-    std::vector<typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>, T>> GetRequiredVec(const std::string& key) const
+    std::vector<typename std::enable_if_t<Traits::is_jsonable_v<T>, T>> GetRequiredVec(const std::string& key) const
     {
         auto iter = m_json.find(key);
         if (iter != m_json.end())
@@ -155,7 +155,7 @@ public:
     }
 
     template<class T>
-    std::vector<typename std::enable_if_t<!std::is_base_of_v<Traits::IJsonable, T>, T>> GetRequiredVec(const std::string& key) const
+    std::vector<typename std::enable_if_t<!Traits::is_jsonable_v<T>, T>> GetRequiredVec(const std::string& key) const
     {
         auto iter = m_json.find(key);
         if (iter != m_json.end())
@@ -6,7 +6,6 @@
 
 #include <mw/util/EndianUtil.h>
 #include <mw/traits/Serializable.h>
-#include <support/allocators/secure.h>
 #include <mw/serialization/Deserializer.h>
 
 #include <cstdint>
@@ -14,77 +13,73 @@
 #include <string>
 #include <array>
 #include <algorithm>
-
+#include <cstring>
+
+//
+// Builds a byte vector, writing integers big-endian (unless AppendLE is used).
+//
+// Serializers created with SizeOnly() don't write anything; they just count the bytes that would be written,
+// so a buffer can be reserved up front (see Traits::ISerializable::GetSerializedSize()).
+//
 class Serializer
 {
 public:
     Serializer() = default;
     Serializer(const size_t expectedSize) { m_serialized.reserve(expectedSize); }
-    ~Serializer() { memory_cleanse(m_serialized.data(), m_serialized.size()); }
+
+    Serializer(const Serializer&) = default;
+    Serializer(Serializer&&) noexcept = default;
+    Serializer& operator=(const Serializer&) = delete;
+    Serializer& operator=(Serializer&&) = delete;
+
+    static Serializer SizeOnly()
+    {
+        Serializer serializer;
+        serializer.m_sizeOnly = true;
+        return serializer;
+    }
 
     template <class T, typename SFINAE = typename std::enable_if_t<std::is_integral_v<T>>>
     Serializer& Append(const T& t)
     {
-        std::vector<uint8_t> temp(sizeof(T));
-        memcpy(temp.data(), &t, sizeof(T));
-
-        if (EndianUtil::IsBigEndian())
-        {
-            m_serialized.insert(m_serialized.end(), temp.cbegin(), temp.cend());
-        }
-        else
-        {
-            m_serialized.insert(m_serialized.end(), temp.crbegin(), temp.crend());
-        }
-
-        return *this;
+        const T bigEndian = EndianUtil::ToBigEndian(t);
+        return Write((const uint8_t*)&bigEndian, sizeof(T));
     }
 
     template <class T, typename SFINAE = typename std::enable_if_t<std::is_integral_v<T>>>
     Serializer& AppendLE(const T& t)
     {
-        std::vector<uint8_t> temp(sizeof(T));
-        memcpy(temp.data(), &t, sizeof(T));
-
-        if (EndianUtil::IsBigEndian())
-        {
-            m_serialized.insert(m_serialized.end(), temp.crbegin(), temp.crend());
-        }
-        else
-        {
-            m_serialized.insert(m_serialized.end(), temp.cbegin(), temp.cend());
-        }
-
-        return *this;
+        const T littleEndian = EndianUtil::ToLittleEndian(t);
+        return Write((const uint8_t*)&littleEndian, sizeof(T));
     }
 
     Serializer& Append(const std::vector<uint8_t>& vectorToAppend)
     {
-        m_serialized.insert(m_serialized.end(), vectorToAppend.cbegin(), vectorToAppend.cend());
-        return *this;
+        return Write(vectorToAppend.data(), vectorToAppend.size());
     }
 
     template <size_t T>
     Serializer& Append(const std::array<uint8_t, T>& arr)
     {
-        m_serialized.insert(m_serialized.end(), arr.cbegin(), arr.cend());
-        return *this;
+        return Write(arr.data(), T);
     }
 
     // TODO: Should we care about unicode, where chars are larger than 1 byte?
     Serializer& Append(const std::string& varString)
     {
         Append<uint64_t>(varString.length());
-        m_serialized.insert(m_serialized.end(), varString.cbegin(), varString.cend());
-        return *this;
+        return Write((const uint8_t*)varString.data(), varString.length());
     }
 
     Serializer& Append(const char* str)
     {
-        return Append(std::string(str));
+        const size_t length = strlen(str);
+        Append<uint64_t>(length);
+        return Write((const uint8_t*)str, length);
     }
 
-    Serializer& Append(const Traits::ISerializable& serializable)
+    template <class T>
+    std::enable_if_t<Traits::is_serializable_v<T>, Serializer&> Append(const T& serializable)
     {
         return serializable.Serialize(*this);
     }
@@ -94,7 +89,7 @@ public:
         return pSerializable->Serialize(*this);
     }
 
-    template <class T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
+    template <class T, typename SFINAE = typename std::enable_if_t<Traits::is_serializable_v<T>>>
     Serializer& AppendVec(const std::vector<T>& vec)
     {
         Append<uint64_t>(vec.size());
@@ -106,7 +101,7 @@ public:
         return *this;
     }
 
-    template <class T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::ISerializable, T>>>
+    template <class T, typename SFINAE = typename std::enable_if_t<Traits::is_serializable_v<T>>>
     Serializer& AppendVec(const std::vector<std::shared_ptr<const T>>& vec)
     {
         Append<uint64_t>(vec.size());
@@ -117,13 +112,30 @@ public:
         return *this;
     }
 
-    const std::vector<uint8_t>& vec() const { return m_serialized; }
+    const std::vector<uint8_t>& vec() const& { return m_serialized; }
+
+    // Moves the buffer out, e.g. std::move(serializer).vec().
+    std::vector<uint8_t> vec() && { return std::move(m_serialized); }
+
     const uint8_t* data() const { return m_serialized.data(); }
-    size_t size() const { return m_serialized.size(); }
+    size_t size() const { return m_sizeOnly ? m_size : m_serialized.size(); }
 
     uint8_t& operator[] (const size_t x) { return m_serialized[x]; }
     const uint8_t& operator[] (const size_t x) const { return m_serialized[x]; }
 
 private:
+    Serializer& Write(const uint8_t* pData, const size_t length)
+    {
+        if (m_sizeOnly) {
+            m_size += length;
+        } else {
+            m_serialized.insert(m_serialized.end(), pData, pData + length);
+        }
+
+        return *this;
+    }
+
     std::vector<uint8_t> m_serialized;
+    bool m_sizeOnly{ false };
+    size_t m_size{ 0 };
 };
\ No newline at end of file
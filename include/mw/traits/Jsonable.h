@@ -17,42 +17,54 @@ namespace Traits
 
         virtual json ToJSON() const noexcept = 0;
     };
+
+    //
+    // True for any type with a ToJSON() method, whether or not it derives from IJsonable.
+    //
+    template<class T, class = void>
+    struct is_jsonable : std::false_type { };
+
+    template<class T>
+    struct is_jsonable<T, std::void_t<decltype(std::declval<const T&>().ToJSON())>> : std::true_type { };
+
+    template<class T>
+    inline constexpr bool is_jsonable_v = is_jsonable<T>::value;
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void to_json(BasicJsonType& j, const T& value) {
     j = value.ToJSON();
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void to_json(BasicJsonType& j, const std::shared_ptr<const T>& value) {
     assert(value != nullptr);
     j = value->ToJSON();
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void to_json(BasicJsonType& j, const std::unique_ptr<const T>& value) {
     assert(value != nullptr);
     j = value->ToJSON();
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void from_json(const BasicJsonType& j, T& value) {
     value = T::FromJSON(Json(j));
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void from_json(const BasicJsonType& j, std::shared_ptr<const T>& value) {
     value = T::FromJSON(Json(j));
 }
 
 template <typename BasicJsonType,
-    typename T, typename SFINAE = typename std::enable_if_t<std::is_base_of_v<Traits::IJsonable, T>>>
+    typename T, typename SFINAE = typename std::enable_if_t<Traits::is_jsonable_v<T>>>
 static void from_json(const BasicJsonType& j, std::unique_ptr<const T>& value) {
     value = T::FromJSON(Json(j));
 }
@@ -5,6 +5,8 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <string>
+#include <type_traits>
+#include <utility>
 
 namespace Traits
 {
@@ -15,4 +17,16 @@ namespace Traits
 
         virtual std::string Format() const = 0;
     };
+
+    //
+    // True for any type with a Format() method, whether or not it derives from IPrintable.
+    //
+    template<class T, class = void>
+    struct is_printable : std::false_type { };
+
+    template<class T>
+    struct is_printable<T, std::void_t<decltype(std::declval<const T&>().Format())>> : std::true_type { };
+
+    template<class T>
+    inline constexpr bool is_printable_v = is_printable<T>::value;
 }
\ No newline at end of file
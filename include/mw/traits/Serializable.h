@@ -5,6 +5,8 @@
 // file LICENSE or http://www.opensource.org/licenses/mit-license.php.
 
 #include <cstdint>
+#include <type_traits>
+#include <utility>
 #include <vector>
 
 // Forward Declarations
@@ -23,8 +25,27 @@ namespace Traits
         virtual Serializer& Serialize(Serializer& serializer) const noexcept = 0;
 
         //
-        // Serializes object into a byte vector.
+        // Serializes object into a byte vector, which is sized exactly once (using GetSerializedSize()).
         //
         std::vector<uint8_t> Serialized() const noexcept;
+
+        //
+        // Returns the number of bytes Serialize() appends, without writing them anywhere.
+        //
+        size_t GetSerializedSize() const noexcept;
     };
+
+    //
+    // True for any type with a Serialize(Serializer&) method, whether or not it derives from ISerializable.
+    // Small value types (hashes, commitments, signatures) skip the interface so they stay trivially copyable.
+    //
+    template<class T, class = void>
+    struct is_serializable : std::false_type { };
+
+    template<class T>
+    struct is_serializable<T, std::void_t<decltype(std::declval<const T&>().Serialize(std::declval<Serializer&>()))>>
+        : std::true_type { };
+
+    template<class T>
+    inline constexpr bool is_serializable_v = is_serializable<T>::value;
 }
\ No newline at end of file
@@ -7,6 +7,11 @@
 #include <string>
 #include <cstring>
 #include <cstdint>
+#include <type_traits>
+
+#if defined(_MSC_VER)
+#include <stdlib.h>
+#endif
 
 //
 // A header-only utility for determining and changing endianness of data.
@@ -25,31 +30,72 @@ public:
         return bint.c[0] == 1;
     }
 
-    // In Visual Studio, _byteswap_ushort could be used.
     static uint16_t changeEndianness16(const uint16_t val) noexcept
     {
+#if defined(_MSC_VER)
+        return _byteswap_ushort(val);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap16(val);
+#else
         return (val << 8) |          // left-shift always fills with zeros
             ((val >> 8) & 0x00ff); // right-shift sign-extends, so force to zero
+#endif
     }
 
-    // In Visual Studio, _byteswap_ulong could be used.
     static uint32_t changeEndianness32(const uint32_t val) noexcept
     {
+#if defined(_MSC_VER)
+        return _byteswap_ulong(val);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap32(val);
+#else
         return (val << 24) |
             ((val << 8) & 0x00ff0000) |
             ((val >> 8) & 0x0000ff00) |
             ((val >> 24) & 0x000000ff);
+#endif
     }
 
     static uint64_t changeEndianness64(const uint64_t val) noexcept
     {
+#if defined(_MSC_VER)
+        return _byteswap_uint64(val);
+#elif defined(__GNUC__) || defined(__clang__)
+        return __builtin_bswap64(val);
+#else
         uint64_t x = val;
         x = (x & 0x00000000FFFFFFFF) << 32 | (x & 0xFFFFFFFF00000000) >> 32;
         x = (x & 0x0000FFFF0000FFFF) << 16 | (x & 0xFFFF0000FFFF0000) >> 16;
         x = (x & 0x00FF00FF00FF00FF) << 8 | (x & 0xFF00FF00FF00FF00) >> 8;
         return x;
+#endif
+    }
+
+    //
+    // Reverses the bytes of any integer type, e.g. for converting between big and little endian.
+    //
+    template<typename T, typename SFINAE = typename std::enable_if_t<std::is_integral_v<T>>>
+    static T ByteSwap(const T val) noexcept
+    {
+        using U = std::make_unsigned_t<T>;
+        if constexpr (sizeof(T) == 1) {
+            return val;
+        } else if constexpr (sizeof(T) == 2) {
+            return (T)changeEndianness16((U)val);
+        } else if constexpr (sizeof(T) == 4) {
+            return (T)changeEndianness32((U)val);
+        } else {
+            static_assert(sizeof(T) == 8, "Unsupported integer size");
+            return (T)changeEndianness64((U)val);
+        }
     }
 
+    template<typename T>
+    static T ToBigEndian(const T val) noexcept { return IsBigEndian() ? val : ByteSwap(val); }
+
+    template<typename T>
+    static T ToLittleEndian(const T val) noexcept { return IsBigEndian() ? ByteSwap(val) : val; }
+
     static uint16_t GetBigEndian16(const uint16_t val) noexcept
     {
         if (IsBigEndian())
@@ -100,6 +146,14 @@ public:
         return changeEndianness64(val);
     }
 
+    static uint16_t ReadBE16(const uint8_t* ptr)
+    {
+        uint16_t x;
+        memcpy((char*)&x, ptr, 2);
+
+        return GetBigEndian16(x);
+    }
+
     static uint32_t ReadBE32(const uint8_t* ptr)
     {
         uint32_t x;
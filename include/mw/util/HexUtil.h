@@ -44,13 +44,21 @@ public:
 
     static std::string ToHex(const std::vector<uint8_t>& data)
     {
-        std::ostringstream stream;
-        for (const uint8_t byte : data)
+        return ToHex(data.data(), data.size());
+    }
+
+    static std::string ToHex(const uint8_t* pData, const size_t numBytes)
+    {
+        static constexpr char HEX_CHARS[] = "0123456789abcdef";
+
+        std::string hex(numBytes * 2, '0');
+        for (size_t i = 0; i < numBytes; i++)
         {
-            stream << std::hex << std::setfill('0') << std::setw(2) << std::nouppercase << (int)byte;
+            hex[2 * i] = HEX_CHARS[pData[i] >> 4];
+            hex[(2 * i) + 1] = HEX_CHARS[pData[i] & 0x0F];
         }
 
-        return stream.str();
+        return hex;
     }
 
     static std::string ToHex(const std::vector<uint8_t>& data, const size_t numBytes)
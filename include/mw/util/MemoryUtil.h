@@ -0,0 +1,67 @@
+#pragma once
+
+// Copyright (c) 2020 The Litecoin Developers
+// Distributed under the MIT software license, see the accompanying
+// file LICENSE or http://www.opensource.org/licenses/mit-license.php.
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <unordered_map>
+
+//
+// Estimates of the heap memory held by containers, in the spirit of memusage.h in the main codebase.
+// These only account for memory owned directly by the container, not memory owned by its elements.
+//
+class MemoryUtil
+{
+public:
+    //
+    // Approximates the number of bytes malloc actually reserves for an allocation of the given size.
+    // Assumes 16-byte alignment and 8 bytes of bookkeeping overhead, which is typical for 64-bit glibc.
+    //
+    static size_t MallocUsage(const size_t alloc) noexcept
+    {
+        if (alloc == 0) {
+            return 0;
+        }
+
+        return ((alloc + 31) >> 4) << 4;
+    }
+
+    template<typename T, typename A>
+    static size_t DynamicUsage(const std::vector<T, A>& vec) noexcept
+    {
+        return MallocUsage(vec.capacity() * sizeof(T));
+    }
+
+    //
+    // The memory used by an object allocated with std::make_shared, including its control block.
+    //
+    template<typename T>
+    static size_t SharedPtrUsage() noexcept
+    {
+        return MallocUsage(sizeof(T) + (2 * sizeof(int)) + sizeof(void*));
+    }
+
+    //
+    // The memory used by a single node of an std::unordered_map, excluding the bucket array.
+    //
+    template<typename K, typename V>
+    static size_t MapNodeUsage() noexcept
+    {
+        return MallocUsage(sizeof(std::pair<const K, V>) + sizeof(void*) + sizeof(size_t));
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    static size_t BucketUsage(const std::unordered_map<K, V, H, E, A>& map) noexcept
+    {
+        return MallocUsage(map.bucket_count() * sizeof(void*));
+    }
+
+    template<typename K, typename V, typename H, typename E, typename A>
+    static size_t DynamicUsage(const std::unordered_map<K, V, H, E, A>& map) noexcept
+    {
+        return (MapNodeUsage<K, V>() * map.size()) + BucketUsage(map);
+    }
+};
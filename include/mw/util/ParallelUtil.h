@@ -0,0 +1,65 @@
+#pragma once
+
+#include <mw/common/ThreadPool.h>
+#include <mw/util/ThreadUtil.h>
+
+#include <algorithm>
+#include <vector>
+
+//
+// Helpers for splitting work across cores. The work itself runs on the shared ThreadPool.
+// On single-core machines, or when there's too little work to split, everything runs on the calling thread.
+//
+class ParallelUtil
+{
+public:
+    //
+    // Returns how many threads to split numItems across, so that each gets at least minPerThread items.
+    //
+    static size_t NumThreads(const size_t numItems, const size_t minPerThread) noexcept
+    {
+        const size_t num_cores = (size_t)std::max(ThreadUtil::GetNumCores(), 1);
+        return std::max<size_t>(1, std::min(num_cores, numItems / std::max<size_t>(minPerThread, 1)));
+    }
+
+    //
+    // Sorts each of NumThreads() chunks in parallel, then merges neighbouring chunks, also in parallel.
+    // Not stable, just like std::sort.
+    //
+    template<typename T, typename Compare>
+    static void Sort(std::vector<T>& vec, const Compare& comp, const size_t minPerThread = 4096)
+    {
+        const size_t num_chunks = NumThreads(vec.size(), minPerThread);
+        if (num_chunks <= 1) {
+            std::sort(vec.begin(), vec.end(), comp);
+            return;
+        }
+
+        std::vector<size_t> bounds(num_chunks + 1);
+        for (size_t i = 0; i <= num_chunks; i++) {
+            bounds[i] = (vec.size() * i) / num_chunks;
+        }
+
+        ThreadPool::GetShared().ForEach(num_chunks, [&vec, &bounds, &comp](const size_t i) {
+            std::sort(vec.begin() + bounds[i], vec.begin() + bounds[i + 1], comp);
+        });
+
+        for (size_t width = 1; width < num_chunks; width *= 2) {
+            std::vector<size_t> merges;
+            for (size_t i = 0; i + width < num_chunks; i += 2 * width) {
+                merges.push_back(i);
+            }
+
+            ThreadPool::GetShared().ForEach(merges.size(), [&vec, &bounds, &comp, &merges, width, num_chunks](const size_t m) {
+                const size_t first = merges[m];
+                const size_t last = std::min(first + (2 * width), num_chunks);
+                std::inplace_merge(
+                    vec.begin() + bounds[first],
+                    vec.begin() + bounds[first + width],
+                    vec.begin() + bounds[last],
+                    comp
+                );
+            });
+        }
+    }
+};
@@ -132,7 +132,8 @@ private:
         return StringUtil::ToUTF8(x);
     }
 
-    static std::string ConvertArg(const Traits::IPrintable& x)
+    template <class T>
+    static std::enable_if_t<Traits::is_printable_v<T>, std::string> ConvertArg(const T& x)
     {
         return x.Format();
     }
@@ -2,71 +2,128 @@
 #include "ConversionUtil.h"
 
 #include <mw/crypto/Random.h>
+#include <mw/crypto/ScratchSpacePool.h>
+#include <mw/crypto/VerificationCache.h>
 #include <mw/exceptions/CryptoException.h>
 #include <mw/util/VectorUtil.h>
+#include <mw/util/ParallelUtil.h>
+#include <mw/common/Logger.h>
+#include <mw/common/ThreadPool.h>
 
-const uint64_t MAX_WIDTH = 1 << 20;
-const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
+// Below this, splitting a batch costs more in lost multi-exponentiation savings than it gains in parallelism.
+const size_t MIN_PROOFS_PER_BATCH = 8;
 
-bool Bulletproofs::VerifyBulletproofs(const std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>>& rangeProofs) const
+bool Bulletproofs::VerifyBulletproofs(const std::vector<ProofData>& rangeProofs) const
+{
+    VerificationCache& cache = VerificationCache::GetRangeProofCache();
+
+    std::vector<const ProofData*> unverified;
+    std::vector<VerificationCache::Key> unverifiedKeys;
+    unverified.reserve(rangeProofs.size());
+    unverifiedKeys.reserve(rangeProofs.size());
+    for (const ProofData& rangeProof : rangeProofs)
+    {
+        VerificationCache::Key key = cache.NewKey()
+            .Append(std::get<0>(rangeProof).data(), std::get<0>(rangeProof).size())
+            .Append(std::get<1>(rangeProof)->vec())
+            .Append(std::get<2>(rangeProof))
+            .Build();
+        if (!cache.Contains(key)) {
+            unverified.push_back(&rangeProof);
+            unverifiedKeys.push_back(key);
+        }
+    }
+
+    if (unverified.empty()) {
+        return true;
+    }
+
+    // Split the proofs into one sub-batch per core. Each is verified with its own scratch space,
+    // using the shared read-only context, so the sub-batches don't contend with each other.
+    const size_t num_batches = ParallelUtil::NumThreads(unverified.size(), MIN_PROOFS_PER_BATCH);
+    std::vector<size_t> bounds(num_batches + 1);
+    for (size_t i = 0; i <= num_batches; i++) {
+        bounds[i] = (unverified.size() * i) / num_batches;
+    }
+
+    std::vector<uint8_t> batchValid(num_batches, 0);
+    ThreadPool::GetShared().ForEach(num_batches, [this, &unverified, &bounds, &batchValid](const size_t i) {
+        batchValid[i] = VerifyBatch(unverified.cbegin() + bounds[i], unverified.cbegin() + bounds[i + 1]) ? 1 : 0;
+    });
+
+    bool all_valid = true;
+    for (size_t i = 0; i < num_batches; i++)
+    {
+        auto begin = unverified.cbegin() + bounds[i];
+        auto end = unverified.cbegin() + bounds[i + 1];
+        if (batchValid[i] == 1) {
+            std::for_each(
+                unverifiedKeys.cbegin() + bounds[i], unverifiedKeys.cbegin() + bounds[i + 1],
+                [&cache](const VerificationCache::Key& key) { cache.Insert(key); }
+            );
+        } else {
+            all_valid = false;
+
+            const size_t invalid_idx = FindInvalid(begin, end);
+            LOG_WARNING_F("Invalid rangeproof for commitment {}", std::get<0>(*unverified[bounds[i] + invalid_idx]));
+        }
+    }
+
+    return all_valid;
+}
+
+bool Bulletproofs::VerifyBatch(
+    std::vector<const ProofData*>::const_iterator begin,
+    std::vector<const ProofData*>::const_iterator end) const
 {
     const size_t numBits = 64;
-    const size_t proofLength = std::get<1>(rangeProofs.front())->size();
+    const size_t numProofs = std::distance(begin, end);
+    if (numProofs == 0) {
+        return true;
+    }
+
+    const size_t proofLength = std::get<1>(**begin)->size();
 
-    std::vector<Commitment> commitments;
     std::vector<secp256k1_pedersen_commitment> secpCommitments;
-    commitments.reserve(rangeProofs.size());
+    secpCommitments.reserve(numProofs);
 
     std::vector<const uint8_t*> bulletproofPointers;
-    bulletproofPointers.reserve(rangeProofs.size());
+    bulletproofPointers.reserve(numProofs);
 
     std::vector<const uint8_t*> extraData;
-    extraData.reserve(rangeProofs.size());
+    extraData.reserve(numProofs);
 
     std::vector<size_t> extraDataLen;
-    extraDataLen.reserve(rangeProofs.size());
+    extraDataLen.reserve(numProofs);
 
-    for (const auto& rangeProof : rangeProofs)
+    for (auto iter = begin; iter != end; iter++)
     {
-        if (!m_cache.WasAlreadyVerified(rangeProof)) {
-            commitments.push_back(std::get<0>(rangeProof));
-            secpCommitments.push_back(ConversionUtil(m_context).ToSecp256k1(std::get<0>(rangeProof)));
-            bulletproofPointers.emplace_back(std::get<1>(rangeProof)->data());
-
-            const std::vector<uint8_t>& extra = std::get<2>(rangeProof);
-            if (!extra.empty()) {
-                extraData.push_back(extra.data());
-                extraDataLen.push_back(extra.size());
-            } else {
-                extraData.push_back(nullptr);
-                extraDataLen.push_back(0);
-            }
+        const ProofData& rangeProof = **iter;
+        secpCommitments.push_back(ConversionUtil(m_context).ToSecp256k1(std::get<0>(rangeProof)));
+        bulletproofPointers.emplace_back(std::get<1>(rangeProof)->data());
+
+        const std::vector<uint8_t>& extra = std::get<2>(rangeProof);
+        if (!extra.empty()) {
+            extraData.push_back(extra.data());
+            extraDataLen.push_back(extra.size());
+        } else {
+            extraData.push_back(nullptr);
+            extraDataLen.push_back(0);
         }
     }
 
-    if (commitments.empty()) {
-        return true;
-    }
-
     // array of generator multiplied by value in pedersen commitments (cannot be NULL)
-    std::vector<secp256k1_generator> valueGenerators;
-    for (size_t i = 0; i < commitments.size(); i++)
-    {
-        valueGenerators.push_back(secp256k1_generator_const_h);
-    }
+    std::vector<secp256k1_generator> valueGenerators(numProofs, secp256k1_generator_const_h);
 
     std::vector<secp256k1_pedersen_commitment*> commitmentPointers = VectorUtil::ToPointerVec(secpCommitments);
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(
-        m_context.Read()->Get(),
-        SCRATCH_SPACE_SIZE
-    );
+    ScratchSpacePool::Handle scratch = ScratchSpacePool::GetShared().Acquire(m_context.Get());
     const int result = secp256k1_bulletproof_rangeproof_verify_multi(
-        m_context.Read()->Get(),
-        pScratchSpace,
-        m_context.Read()->GetGenerators(),
+        m_context.Get(),
+        scratch.Get(),
+        m_context.GetGenerators(),
         bulletproofPointers.data(),
-        commitments.size(),
+        numProofs,
         proofLength,
         NULL,
         commitmentPointers.data(),
@@ -76,16 +133,28 @@ bool Bulletproofs::VerifyBulletproofs(const std::vector<std::tuple<Commitment, R
         extraData.data(),
         extraDataLen.data()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
-    if (result == 1) {
-        for (const auto& proof_tuple : rangeProofs)
-        {
-            m_cache.AddToCache(proof_tuple);
+    return result == 1;
+}
+
+size_t Bulletproofs::FindInvalid(
+    std::vector<const ProofData*>::const_iterator begin,
+    std::vector<const ProofData*>::const_iterator end) const
+{
+    // Halve the range until a single invalid proof is left.
+    size_t offset = 0;
+    while (std::distance(begin, end) > 1)
+    {
+        auto middle = begin + (std::distance(begin, end) / 2);
+        if (!VerifyBatch(begin, middle)) {
+            end = middle;
+        } else {
+            offset += std::distance(begin, middle);
+            begin = middle;
         }
     }
 
-    return result == 1;
+    return offset;
 }
 
 RangeProof::CPtr Bulletproofs::GenerateRangeProof(
@@ -95,19 +164,19 @@ RangeProof::CPtr Bulletproofs::GenerateRangeProof(
     const SecretKey& rewindNonce,
     const ProofMessage& proofMessage)
 {
-    auto contextWriter = m_context.Write();
-    secp256k1_context* pContext = contextWriter->Randomized();
+    secp256k1_context* pContext = m_context.Randomized();
 
     std::vector<uint8_t> proofBytes(RangeProof::MAX_SIZE, 0);
     size_t proofLen = RangeProof::MAX_SIZE;
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(pContext, SCRATCH_SPACE_SIZE);
+    // Taken from the shared context's scratch spaces, since the thread's context is destroyed with the thread.
+    ScratchSpacePool::Handle scratch = ScratchSpacePool::GetShared().Acquire(m_context.Get());
 
     std::vector<const uint8_t*> blindingFactors({ key.data() });
     int result = secp256k1_bulletproof_rangeproof_prove(
         pContext,
-        pScratchSpace,
-        contextWriter->GetGenerators(),
+        scratch.Get(),
+        m_context.GetGenerators(),
         &proofBytes[0],
         &proofLen,
         NULL,
@@ -126,14 +195,13 @@ RangeProof::CPtr Bulletproofs::GenerateRangeProof(
         0,
         proofMessage.data()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
     if (result != 1) {
         ThrowCrypto_F("secp256k1_bulletproof_rangeproof_prove failed with error: {}", result);
     }
 
     proofBytes.resize(proofLen);
-    return std::make_shared<RangeProof>(std::move(proofBytes));
+    return ObjectPool::MakeShared<RangeProof>(std::move(proofBytes));
 }
 
 std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(
@@ -148,7 +216,7 @@ std::unique_ptr<RewoundProof> Bulletproofs::RewindProof(
     std::vector<uint8_t> message(20, 0);
 
     int result = secp256k1_bulletproof_rangeproof_rewind(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &value,
         blindingFactor.data(),
         rangeProof.data(),
@@ -1,7 +1,6 @@
 #pragma once
 
 #include "Context.h"
-#include "BulletproofsCache.h"
 
 #include <mw/models/crypto/Commitment.h>
 #include <mw/models/crypto/RangeProof.h>
@@ -12,12 +11,17 @@
 class Bulletproofs
 {
 public:
-    Bulletproofs(Locked<Context>& context) : m_context(context) { }
+    Bulletproofs(const Context& context) : m_context(context) { }
     ~Bulletproofs() = default;
 
-    bool VerifyBulletproofs(
-        const std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>>& rangeProofs
-    ) const;
+    using ProofData = std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>;
+
+    //
+    // Verifies the proofs in per-core sub-batches, in parallel.
+    // Proofs found in the shared VerificationCache are skipped, and the ones that verify are added to it.
+    // If any sub-batch fails, it's bisected to find and log the offending proof.
+    //
+    bool VerifyBulletproofs(const std::vector<ProofData>& rangeProofs) const;
 
     RangeProof::CPtr GenerateRangeProof(
         const uint64_t amount,
@@ -34,8 +38,16 @@ public:
     ) const;
 
 private:
-    Locked<Context> m_context;
+    bool VerifyBatch(
+        std::vector<const ProofData*>::const_iterator begin,
+        std::vector<const ProofData*>::const_iterator end
+    ) const;
+
+    // Returns the offset from begin of the first invalid proof, assuming the range contains one.
+    size_t FindInvalid(
+        std::vector<const ProofData*>::const_iterator begin,
+        std::vector<const ProofData*>::const_iterator end
+    ) const;
 
-    secp256k1_bulletproof_generators* m_pGenerators;
-    mutable BulletProofsCache m_cache;
+    const Context& m_context;
 };
\ No newline at end of file
@@ -0,0 +1,152 @@
+#include <mw/crypto/CommitmentSum.h>
+#include <mw/common/ThreadPool.h>
+#include <mw/exceptions/CryptoException.h>
+#include <mw/util/ParallelUtil.h>
+#include <mw/util/VectorUtil.h>
+
+#include "Context.h"
+#include "ConversionUtil.h"
+#include "PointCache.h"
+
+#include <boost/optional.hpp>
+
+// Fewer commitments than this per thread aren't worth a thread.
+static const size_t MIN_PER_THREAD = 1024;
+
+// A partial sum. boost::none is the point at infinity, which secp256k1_pubkey can't represent.
+using PartialSum = boost::optional<secp256k1_pubkey>;
+
+//
+// Uses parsed commitments already in the PointCache (e.g. those of a block that was just validated),
+// but doesn't add to it. There can be millions of commitments, each only seen once, which would evict everything else.
+//
+static PartialSum SumRange(const Commitment* pBegin, const Commitment* pEnd, const bool negate)
+{
+    const Context& context = Context::GetShared();
+
+    std::vector<secp256k1_pubkey> pubkeys;
+    pubkeys.reserve(pEnd - pBegin);
+    for (const Commitment* pCommitment = pBegin; pCommitment != pEnd; pCommitment++)
+    {
+        PointCache::ParsedCommitment parsed;
+        if (PointCache::GetShared().Find(*pCommitment, parsed)) {
+            pubkeys.push_back(parsed.pubkey);
+        } else {
+            if (secp256k1_pedersen_commitment_parse(context.Get(), &parsed.commitment, pCommitment->data()) != 1) {
+                ThrowCrypto_F("Failed to parse commitment: {}", *pCommitment);
+            }
+
+            pubkeys.emplace_back();
+            if (secp256k1_pedersen_commitment_to_pubkey(context.Get(), &pubkeys.back(), &parsed.commitment) != 1) {
+                ThrowCrypto_F("Failed to convert commitment ({}) to pubkey", *pCommitment);
+            }
+        }
+
+        if (negate && secp256k1_ec_pubkey_negate(context.Get(), &pubkeys.back()) != 1) {
+            ThrowCrypto("secp256k1_ec_pubkey_negate error");
+        }
+    }
+
+    if (pubkeys.empty()) {
+        return boost::none;
+    }
+
+    // Combining valid pubkeys only fails when the sum is the point at infinity.
+    std::vector<secp256k1_pubkey*> pubkeyPtrs = VectorUtil::ToPointerVec(pubkeys);
+    secp256k1_pubkey sum;
+    if (secp256k1_ec_pubkey_combine(context.Get(), &sum, pubkeyPtrs.data(), pubkeyPtrs.size()) != 1) {
+        return boost::none;
+    }
+
+    return sum;
+}
+
+static PartialSum Combine(const PartialSum& lhs, const PartialSum& rhs)
+{
+    if (!lhs) {
+        return rhs;
+    } else if (!rhs) {
+        return lhs;
+    }
+
+    const secp256k1_pubkey* pubkeys[2] = { &lhs.get(), &rhs.get() };
+    secp256k1_pubkey sum;
+    if (secp256k1_ec_pubkey_combine(Context::GetShared().Get(), &sum, pubkeys, 2) != 1) {
+        return boost::none;
+    }
+
+    return sum;
+}
+
+// Splits the commitments into one chunk per thread, and returns each chunk's sum.
+static void SumChunks(const std::vector<Commitment>& commitments, const bool negate, std::vector<PartialSum>& partials)
+{
+    const size_t num_chunks = ParallelUtil::NumThreads(commitments.size(), MIN_PER_THREAD);
+    const size_t first_partial = partials.size();
+    partials.resize(first_partial + num_chunks);
+
+    ThreadPool::GetShared().ForEach(num_chunks, [&commitments, &partials, negate, num_chunks, first_partial](const size_t i) {
+        const size_t begin = (commitments.size() * i) / num_chunks;
+        const size_t end = (commitments.size() * (i + 1)) / num_chunks;
+        partials[first_partial + i] = SumRange(commitments.data() + begin, commitments.data() + end, negate);
+    });
+}
+
+CommitmentSum::CommitmentSum(const size_t batchSize)
+    : m_batchSize(std::max<size_t>(batchSize, 1))
+{
+    m_positive.reserve(m_batchSize);
+}
+
+void CommitmentSum::Add(const Commitment& commitment)
+{
+    m_positive.push_back(commitment);
+    if (m_positive.size() + m_negative.size() >= m_batchSize) {
+        Flush();
+    }
+}
+
+void CommitmentSum::Subtract(const Commitment& commitment)
+{
+    m_negative.push_back(commitment);
+    if (m_positive.size() + m_negative.size() >= m_batchSize) {
+        Flush();
+    }
+}
+
+const Commitment& CommitmentSum::Total()
+{
+    Flush();
+    return m_total;
+}
+
+void CommitmentSum::Flush()
+{
+    if (m_positive.empty() && m_negative.empty()) {
+        return;
+    }
+
+    // A zero total is a placeholder for the point at infinity, not a commitment, so it's left out.
+    std::vector<PartialSum> partials;
+    if (!m_total.IsZero()) {
+        partials.push_back(SumRange(&m_total, &m_total + 1, false));
+    }
+
+    SumChunks(m_positive, false, partials);
+    SumChunks(m_negative, true, partials);
+    m_positive.clear();
+    m_negative.clear();
+
+    // Combine neighbouring partial sums until only one is left.
+    // There's only one per thread, so this is cheap enough to do on the calling thread.
+    while (partials.size() > 1) {
+        std::vector<PartialSum> combined;
+        for (size_t i = 0; i < partials.size(); i += 2) {
+            combined.push_back(i + 1 < partials.size() ? Combine(partials[i], partials[i + 1]) : partials[i]);
+        }
+
+        partials = std::move(combined);
+    }
+
+    m_total = partials.front() ? ConversionUtil(Context::GetShared()).ToCommitment(partials.front().get()) : Commitment();
+}
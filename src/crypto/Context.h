@@ -1,44 +1,105 @@
 #pragma once
 
-#include <mw/common/Lock.h>
 #include <mw/crypto/Random.h>
 #include <mw/models/crypto/SecretKey.h>
 #include <mw/exceptions/CryptoException.h>
 #include <mw/crypto/secp256k1.h>
 
+//
+// Holds the secp256k1 contexts used by the crypto modules.
+// There's a single instance, shared by every module and built on first use (see GetShared()),
+// so startup only pays for the precomputed tables once, and only if crypto is actually needed.
+//
+// Verification only reads from a context, so Get() returns a context that's shared by all threads
+// and never modified after construction, which means no locking is needed.
+// Signing and proving randomize the context first (to blind against side channels), so Randomized()
+// instead returns a copy of the context that's private to the calling thread.
+//
+// The bulletproof generators are immutable, so they're created once and shared.
+//
 class Context
 {
 public:
-    Context()
+    static const Context& GetShared()
     {
-        m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
-        m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, 256);
+        static const Context context;
+        return context;
     }
 
     ~Context()
     {
-        secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
         secp256k1_context_destroy(m_pContext);
     }
 
-    secp256k1_context* Randomized()
+    Context(const Context&) = delete;
+    Context& operator=(const Context&) = delete;
+
+    //
+    // Returns a freshly randomized context that's only used by the calling thread.
+    // The pointer remains valid for the lifetime of the thread.
+    //
+    secp256k1_context* Randomized() const
     {
+        thread_local ThreadContext threadContext(m_pContext);
+
         const SecretKey randomSeed = Random::CSPRNG<32>();
-        const int randomizeResult = secp256k1_context_randomize(m_pContext, randomSeed.data());
+        const int randomizeResult = secp256k1_context_randomize(threadContext.Get(), randomSeed.data());
         if (randomizeResult != 1)
         {
             ThrowCrypto("Context randomization failed.");
         }
 
-        return m_pContext;
+        return threadContext.Get();
     }
 
-    secp256k1_context* Get() noexcept { return m_pContext; }
     const secp256k1_context* Get() const noexcept { return m_pContext; }
 
-    const secp256k1_bulletproof_generators* GetGenerators() const noexcept { return m_pGenerators; }
+    const secp256k1_bulletproof_generators* GetGenerators() const noexcept
+    {
+        static const Generators generators;
+        return generators.Get();
+    }
 
 private:
+    Context()
+    {
+        m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_SIGN | SECP256K1_CONTEXT_VERIFY);
+    }
+
+    class ThreadContext
+    {
+    public:
+        ThreadContext(const secp256k1_context* pShared)
+            : m_pContext(secp256k1_context_clone(pShared)) { }
+        ~ThreadContext() { secp256k1_context_destroy(m_pContext); }
+
+        secp256k1_context* Get() const noexcept { return m_pContext; }
+
+    private:
+        secp256k1_context* m_pContext;
+    };
+
+    class Generators
+    {
+    public:
+        Generators()
+        {
+            m_pContext = secp256k1_context_create(SECP256K1_CONTEXT_NONE);
+            m_pGenerators = secp256k1_bulletproof_generators_create(m_pContext, &secp256k1_generator_const_g, 256);
+        }
+
+        ~Generators()
+        {
+            secp256k1_bulletproof_generators_destroy(m_pContext, m_pGenerators);
+            secp256k1_context_destroy(m_pContext);
+        }
+
+        const secp256k1_bulletproof_generators* Get() const noexcept { return m_pGenerators; }
+
+    private:
+        secp256k1_context* m_pContext;
+        secp256k1_bulletproof_generators* m_pGenerators;
+    };
+
     secp256k1_context* m_pContext;
-    secp256k1_bulletproof_generators* m_pGenerators;
-};
\ No newline at end of file
+};
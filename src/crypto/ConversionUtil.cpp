@@ -1,24 +1,11 @@
 #include "ConversionUtil.h"
+#include "PointCache.h"
 
 #include <mw/exceptions/CryptoException.h>
 
 PublicKey ConversionUtil::ToPublicKey(const Commitment& commitment) const
 {
-    secp256k1_pedersen_commitment parsedCommitment = ToSecp256k1(commitment);
-
-    secp256k1_pubkey pubkey;
-    const int pubkeyResult = secp256k1_pedersen_commitment_to_pubkey(
-        m_context.Read()->Get(),
-        &pubkey,
-        &parsedCommitment
-    );
-
-    if (pubkeyResult != 1)
-    {
-        ThrowCrypto_F("Failed to convert commitment ({}) to pubkey", commitment);
-    }
-
-    return ToPublicKey(pubkey);
+    return ToPublicKey(PointCache::GetShared().Parse(m_context, commitment).pubkey);
 }
 
 PublicKey ConversionUtil::ToPublicKey(const secp256k1_pubkey& pubkey) const
@@ -26,7 +13,7 @@ PublicKey ConversionUtil::ToPublicKey(const secp256k1_pubkey& pubkey) const
     PublicKey result;
     size_t length = result.size();
     const int serializeResult = secp256k1_ec_pubkey_serialize(
-        m_context.Read()->Get(),
+        m_context.Get(),
         result.data(),
         &length,
         &pubkey,
@@ -42,19 +29,7 @@ PublicKey ConversionUtil::ToPublicKey(const secp256k1_pubkey& pubkey) const
 
 secp256k1_pubkey ConversionUtil::ToSecp256k1(const PublicKey& publicKey) const
 {
-    secp256k1_pubkey parsedPubkey;
-    const int pubkeyResult = secp256k1_ec_pubkey_parse(
-        m_context.Read()->Get(),
-        &parsedPubkey,
-        publicKey.data(),
-        publicKey.size()
-    );
-    if (pubkeyResult != 1)
-    {
-        ThrowCrypto_F("Failed to parse pubkey: {}", publicKey);
-    }
-
-    return parsedPubkey;
+    return PointCache::GetShared().Parse(m_context, publicKey);
 }
 
 std::vector<secp256k1_pubkey> ConversionUtil::ToSecp256k1(const std::vector<PublicKey>& publicKeys) const
@@ -72,25 +47,14 @@ std::vector<secp256k1_pubkey> ConversionUtil::ToSecp256k1(const std::vector<Publ
 
 secp256k1_pedersen_commitment ConversionUtil::ToSecp256k1(const Commitment& commitment) const
 {
-    secp256k1_pedersen_commitment parsedCommitment;
-    const int commitmentResult = secp256k1_pedersen_commitment_parse(
-        m_context.Read()->Get(),
-        &parsedCommitment,
-        commitment.data()
-    );
-    if (commitmentResult != 1)
-    {
-        ThrowCrypto_F("Failed to parse commitment: {}", commitment);
-    }
-
-    return parsedCommitment;
+    return PointCache::GetShared().Parse(m_context, commitment).commitment;
 }
 
 Commitment ConversionUtil::ToCommitment(const secp256k1_pedersen_commitment& commitment) const
 {
     Commitment out;
     const int serializedResult = secp256k1_pedersen_commitment_serialize(
-        m_context.Read()->Get(),
+        m_context.Get(),
         out.data(),
         &commitment
     );
@@ -102,6 +66,58 @@ Commitment ConversionUtil::ToCommitment(const secp256k1_pedersen_commitment& com
     return out;
 }
 
+Commitment ConversionUtil::ToCommitment(const secp256k1_pubkey& pubkey) const
+{
+    // A commitment holds the same x coordinate as the pubkey, but its prefix encodes whether y is a
+    // quadratic residue rather than whether it's odd. Since there's no API for checking that directly,
+    // try the 0x08 prefix and see whether it gives back the same point.
+    PublicKey publicKey = ToPublicKey(pubkey);
+
+    Commitment commitment;
+    commitment.data()[0] = 0x08;
+    std::copy(publicKey.data() + 1, publicKey.data() + publicKey.size(), commitment.data() + 1);
+
+    secp256k1_pedersen_commitment parsedCommitment;
+    secp256k1_pubkey candidate;
+    if (secp256k1_pedersen_commitment_parse(m_context.Get(), &parsedCommitment, commitment.data()) != 1
+        || secp256k1_pedersen_commitment_to_pubkey(m_context.Get(), &candidate, &parsedCommitment) != 1)
+    {
+        ThrowCrypto("Failed to convert pubkey to commitment.");
+    }
+
+    if (ToPublicKey(candidate).GetBigInt() != publicKey.GetBigInt()) {
+        commitment.data()[0] = 0x09;
+    }
+
+    return commitment;
+}
+
+std::vector<secp256k1_pubkey> ConversionUtil::ToPubKeys(const std::vector<Commitment>& commitments) const
+{
+    std::vector<secp256k1_pubkey> out;
+    out.reserve(commitments.size());
+    std::transform(
+        commitments.cbegin(), commitments.cend(),
+        std::back_inserter(out),
+        [this](const Commitment& commit) { return PointCache::GetShared().Parse(m_context, commit).pubkey; }
+    );
+
+    return out;
+}
+
+std::vector<secp256k1_pubkey> ConversionUtil::ToPubKeys(const std::vector<const Commitment*>& commitments) const
+{
+    std::vector<secp256k1_pubkey> out;
+    out.reserve(commitments.size());
+    std::transform(
+        commitments.cbegin(), commitments.cend(),
+        std::back_inserter(out),
+        [this](const Commitment* pCommit) { return PointCache::GetShared().Parse(m_context, *pCommit).pubkey; }
+    );
+
+    return out;
+}
+
 std::vector<secp256k1_pedersen_commitment> ConversionUtil::ToSecp256k1(const std::vector<Commitment>& commitments) const
 {
     std::vector<secp256k1_pedersen_commitment> out;
@@ -119,7 +135,7 @@ secp256k1_ecdsa_signature ConversionUtil::ToSecp256k1(const CompactSignature& si
 {
     secp256k1_ecdsa_signature secpSig;
     const int parseSignatureResult = secp256k1_ecdsa_signature_parse_compact(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &secpSig,
         signature.data()
     );
@@ -148,7 +164,7 @@ secp256k1_schnorrsig ConversionUtil::ToSecp256k1(const Signature& signature) con
 {
     secp256k1_schnorrsig secpSig;
     const int parseSignatureResult = secp256k1_schnorrsig_parse(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &secpSig,
         signature.data()
     );
@@ -184,7 +200,7 @@ CompactSignature ConversionUtil::ToCompact(const secp256k1_ecdsa_signature& sign
 {
     CompactSignature sig64;
     const int serializedResult = secp256k1_ecdsa_signature_serialize_compact(
-        m_context.Read()->Get(),
+        m_context.Get(),
         sig64.data(),
         &signature
     );
@@ -199,7 +215,7 @@ CompactSignature ConversionUtil::ToCompact(const secp256k1_ecdsa_signature& sign
 Signature ConversionUtil::ToSignature(const secp256k1_schnorrsig& signature) const
 {
     Signature out;
-    const int serializedResult = secp256k1_schnorrsig_serialize(m_context.Read()->Get(), out.data(), &signature);
+    const int serializedResult = secp256k1_schnorrsig_serialize(m_context.Get(), out.data(), &signature);
     if (serializedResult != 1)
     {
         ThrowCrypto("Failed to serialize signature.");
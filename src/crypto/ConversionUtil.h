@@ -6,14 +6,19 @@
 #include <mw/models/crypto/PublicKey.h>
 #include <mw/models/crypto/Signature.h>
 
+//
+// Converts between our types and secp256k1's.
+// Commitments and public keys are parsed through the shared PointCache, so each point is only decompressed once.
+//
 class ConversionUtil
 {
 public:
-    ConversionUtil(const Locked<Context>& context) : m_context(context) { }
+    ConversionUtil(const Context& context) : m_context(context) { }
 
     PublicKey ToPublicKey(const Commitment& commitment) const;
     PublicKey ToPublicKey(const secp256k1_pubkey& pubkey) const;
     Commitment ToCommitment(const secp256k1_pedersen_commitment& commitment) const;
+    Commitment ToCommitment(const secp256k1_pubkey& pubkey) const;
     CompactSignature ToCompact(const Signature& signature) const;
     CompactSignature ToCompact(const secp256k1_ecdsa_signature& signature) const;
 
@@ -23,6 +28,12 @@ public:
     secp256k1_pedersen_commitment ToSecp256k1(const Commitment& commitment) const;
     std::vector<secp256k1_pedersen_commitment> ToSecp256k1(const std::vector<Commitment>& commitments) const;
 
+    //
+    // Converts commitments straight to parsed public keys, without serializing and re-parsing them.
+    //
+    std::vector<secp256k1_pubkey> ToPubKeys(const std::vector<Commitment>& commitments) const;
+    std::vector<secp256k1_pubkey> ToPubKeys(const std::vector<const Commitment*>& commitments) const;
+
     secp256k1_ecdsa_signature ToSecp256k1(const CompactSignature& signature) const;
     std::vector<secp256k1_ecdsa_signature> ToSecp256k1(const std::vector<CompactSignature>& signatures) const;
 
@@ -31,5 +42,5 @@ public:
     Signature ToSignature(const secp256k1_schnorrsig& signature) const;
 
 private:
-    Locked<Context> m_context;
+    const Context& m_context;
 };
\ No newline at end of file
@@ -24,7 +24,6 @@
 #pragma comment(lib, "crypt32")
 #endif
 
-Locked<Context> SECP256K1_CONTEXT(std::make_shared<Context>());
 
 //BigInt<32> Crypto::Blake2b(const std::vector<uint8_t>& input)
 //{
@@ -103,14 +102,14 @@ BigInt<64> Crypto::HMAC_SHA512(
 
 Commitment Crypto::CommitTransparent(const uint64_t value)
 {
-    return Pedersen(SECP256K1_CONTEXT).PedersenCommit(value, BigInt<32>::ValueOf(0));
+    return Pedersen(Context::GetShared()).PedersenCommit(value, BigInt<32>::ValueOf(0));
 }
 
 Commitment Crypto::CommitBlinded(
     const uint64_t value,
     const BlindingFactor& blindingFactor)
 {
-    return Pedersen(SECP256K1_CONTEXT).PedersenCommit(value, blindingFactor);
+    return Pedersen(Context::GetShared()).PedersenCommit(value, blindingFactor);
 }
 
 Commitment Crypto::AddCommitments(
@@ -137,7 +136,7 @@ Commitment Crypto::AddCommitments(
         }
     );
 
-    return Pedersen(SECP256K1_CONTEXT).PedersenCommitSum(
+    return Pedersen(Context::GetShared()).PedersenCommitSum(
         sanitizedPositive,
         sanitizedNegative
     );
@@ -174,20 +173,20 @@ BlindingFactor Crypto::AddBlindingFactors(
         return zeroBlindingFactor;
     }
 
-    return Pedersen(SECP256K1_CONTEXT).PedersenBlindSum(sanitizedPositive, sanitizedNegative);
+    return Pedersen(Context::GetShared()).PedersenBlindSum(sanitizedPositive, sanitizedNegative);
 }
 
 SecretKey Crypto::BlindSwitch(const SecretKey& secretKey, const uint64_t amount)
 {
-    return Pedersen(SECP256K1_CONTEXT).BlindSwitch(secretKey, amount);
+    return Pedersen(Context::GetShared()).BlindSwitch(secretKey, amount);
 }
 
 SecretKey Crypto::AddPrivateKeys(const SecretKey& secretKey1, const SecretKey& secretKey2)
 {
-    SecretKey result(secretKey1.vec());
+    SecretKey result = secretKey1;
 
     const int tweakResult = secp256k1_ec_privkey_tweak_add(
-        SECP256K1_CONTEXT.Read()->Get(),
+        Context::GetShared().Get(),
         (uint8_t*)result.data(),
         secretKey2.data()
     );
@@ -206,7 +205,7 @@ RangeProof::CPtr Crypto::GenerateRangeProof(
     const SecretKey& rewindNonce,
     const ProofMessage& proofMessage)
 {
-    return Bulletproofs(SECP256K1_CONTEXT).GenerateRangeProof(
+    return Bulletproofs(Context::GetShared()).GenerateRangeProof(
         amount,
         key,
         privateNonce,
@@ -220,13 +219,13 @@ std::unique_ptr<RewoundProof> Crypto::RewindRangeProof(
     const RangeProof& rangeProof,
     const SecretKey& nonce)
 {
-    return Bulletproofs(SECP256K1_CONTEXT).RewindProof(commitment, rangeProof, nonce);
+    return Bulletproofs(Context::GetShared()).RewindProof(commitment, rangeProof, nonce);
 }
 
 bool Crypto::VerifyRangeProofs(
     const std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>>& rangeProofs)
 {
-    return Bulletproofs(SECP256K1_CONTEXT).VerifyBulletproofs(rangeProofs);
+    return Bulletproofs(Context::GetShared()).VerifyBulletproofs(rangeProofs);
 }
 
 std::vector<uint8_t> Crypto::AES256_Encrypt(
@@ -277,17 +276,17 @@ SecureVector Crypto::AES256_Decrypt(
 
 PublicKey Crypto::CalculatePublicKey(const SecretKey& privateKey)
 {
-    return PublicKeys(SECP256K1_CONTEXT).CalculatePublicKey(privateKey);
+    return PublicKeys(Context::GetShared()).CalculatePublicKey(privateKey);
 }
 
 PublicKey Crypto::AddPublicKeys(const std::vector<PublicKey>& publicKeys)
 {
-    return PublicKeys(SECP256K1_CONTEXT).PublicKeySum(publicKeys);
+    return PublicKeys(Context::GetShared()).PublicKeySum(publicKeys);
 }
 
 PublicKey Crypto::ToPublicKey(const Commitment& commitment)
 {
-    return ConversionUtil(SECP256K1_CONTEXT).ToPublicKey(commitment);
+    return ConversionUtil(Context::GetShared()).ToPublicKey(commitment);
 }
 
 Signature Crypto::BuildSignature(
@@ -307,7 +306,7 @@ CompactSignature Crypto::CalculatePartialSignature(
     const PublicKey& sumPubNonces,
     const mw::Hash& message)
 {
-    return MuSig(SECP256K1_CONTEXT).CalculatePartialSignature(
+    return MuSig(Context::GetShared()).CalculatePartialSignature(
         secretKey,
         secretNonce,
         sumPubKeys,
@@ -320,7 +319,7 @@ Signature Crypto::AggregateSignatures(
     const std::vector<CompactSignature>& signatures,
     const PublicKey& sumPubNonces)
 {
-    return MuSig(SECP256K1_CONTEXT).AggregateSignatures(signatures, sumPubNonces);
+    return MuSig(Context::GetShared()).AggregateSignatures(signatures, sumPubNonces);
 }
 
 bool Crypto::VerifyPartialSignature(
@@ -330,7 +329,7 @@ bool Crypto::VerifyPartialSignature(
     const PublicKey& sumPubNonces,
     const mw::Hash& message)
 {
-    return MuSig(SECP256K1_CONTEXT).VerifyPartialSignature(
+    return MuSig(Context::GetShared()).VerifyPartialSignature(
         partialSignature,
         publicKey,
         sumPubKeys,
@@ -353,5 +352,5 @@ bool Crypto::VerifyAggregateSignature(
 
 SecretKey Crypto::GenerateSecureNonce()
 {
-    return MuSig(SECP256K1_CONTEXT).GenerateSecureNonce();
+    return MuSig(Context::GetShared()).GenerateSecureNonce();
 }
\ No newline at end of file
@@ -14,7 +14,7 @@ SecretKey MuSig::GenerateSecureNonce() const
     SecretKey nonce;
     const SecretKey seed = Random::CSPRNG<32>();
     const int result = secp256k1_aggsig_export_secnonce_single(
-        m_context.Read()->Get(),
+        m_context.Get(),
         nonce.data(),
         seed.data()
     );
@@ -40,7 +40,7 @@ CompactSignature MuSig::CalculatePartialSignature(
 
     secp256k1_ecdsa_signature signature;
     const int signedResult = secp256k1_aggsig_sign_single(
-        m_context.Write()->Randomized(),
+        m_context.Randomized(),
         signature.data,
         message.data(),
         secretKey.data(),
@@ -73,7 +73,7 @@ bool MuSig::VerifyPartialSignature(
     secp256k1_pubkey sumNoncesPubKey = ConversionUtil(m_context).ToSecp256k1(sumPubNonces);
 
     const int verifyResult = secp256k1_aggsig_verify_single(
-        m_context.Read()->Get(),
+        m_context.Get(),
         signature.data,
         message.data(),
         &sumNoncesPubKey,
@@ -99,7 +99,7 @@ Signature MuSig::AggregateSignatures(
 
     secp256k1_ecdsa_signature aggregatedSignature;
     const int result = secp256k1_aggsig_add_signatures_single(
-        m_context.Read()->Get(),
+        m_context.Get(),
         aggregatedSignature.data,
         (const unsigned char**)signaturePtrs.data(),
         signaturePtrs.size(),
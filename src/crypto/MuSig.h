@@ -11,7 +11,7 @@
 class MuSig
 {
 public:
-    MuSig(Locked<Context>& context) : m_context(context) { }
+    MuSig(const Context& context) : m_context(context) { }
     ~MuSig() = default;
 
     SecretKey GenerateSecureNonce() const;
@@ -38,5 +38,5 @@ public:
     ) const;
 
 private:
-    Locked<Context> m_context;
+    const Context& m_context;
 };
\ No newline at end of file
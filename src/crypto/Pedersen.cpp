@@ -9,7 +9,7 @@ Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor&
 {
     secp256k1_pedersen_commitment commitment;
     const int result = secp256k1_pedersen_commit(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &commitment,
         blindingFactor.data(),
         value,
@@ -26,20 +26,27 @@ Commitment Pedersen::PedersenCommit(const uint64_t value, const BlindingFactor&
 
 Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive, const std::vector<Commitment>& negative) const
 {
-    std::vector<secp256k1_pedersen_commitment> positiveCommitments = ConversionUtil(m_context).ToSecp256k1(positive);
-    std::vector<secp256k1_pedersen_commitment*> positivePtrs = VectorUtil::ToPointerVec(positiveCommitments);
+    // Commitments are summed as public keys, since the parsed public keys are cached (see PointCache),
+    // whereas secp256k1_pedersen_commit_sum would decompress every commitment again.
+    std::vector<secp256k1_pubkey> pubkeys = ConversionUtil(m_context).ToPubKeys(positive);
+    for (const secp256k1_pubkey& negativeKey : ConversionUtil(m_context).ToPubKeys(negative))
+    {
+        pubkeys.push_back(negativeKey);
+        if (secp256k1_ec_pubkey_negate(m_context.Get(), &pubkeys.back()) != 1)
+        {
+            ThrowCrypto("secp256k1_pedersen_commit_sum error");
+        }
+    }
 
-    std::vector<secp256k1_pedersen_commitment> negativeCommitments = ConversionUtil(m_context).ToSecp256k1(negative);
-    std::vector<secp256k1_pedersen_commitment*> negativePtrs = VectorUtil::ToPointerVec(negativeCommitments);
+    std::vector<secp256k1_pubkey*> pubkeyPtrs = VectorUtil::ToPointerVec(pubkeys);
 
-    secp256k1_pedersen_commitment commitment;
-    const int result = secp256k1_pedersen_commit_sum(
-        m_context.Read()->Get(),
-        &commitment,
-        positivePtrs.empty() ? nullptr : positivePtrs.data(),
-        positivePtrs.size(),
-        negativePtrs.empty() ? nullptr : negativePtrs.data(),
-        negativePtrs.size()
+    // Like secp256k1_pedersen_commit_sum, fails if the sum is the point at infinity.
+    secp256k1_pubkey sum;
+    const int result = pubkeyPtrs.empty() ? 0 : secp256k1_ec_pubkey_combine(
+        m_context.Get(),
+        &sum,
+        pubkeyPtrs.data(),
+        pubkeyPtrs.size()
     );
 
     if (result != 1)
@@ -47,7 +54,7 @@ Commitment Pedersen::PedersenCommitSum(const std::vector<Commitment>& positive,
         ThrowCrypto("secp256k1_pedersen_commit_sum error");
     }
 
-    return ConversionUtil(m_context).ToCommitment(commitment);
+    return ConversionUtil(m_context).ToCommitment(sum);
 }
 
 BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& positive, const std::vector<BlindingFactor>& negative) const
@@ -65,7 +72,7 @@ BlindingFactor Pedersen::PedersenBlindSum(const std::vector<BlindingFactor>& pos
 
     BlindingFactor blindingFactor;
     const int result = secp256k1_pedersen_blind_sum(
-        m_context.Read()->Get(),
+        m_context.Get(),
         blindingFactor.data(),
         blindingFactors.data(),
         blindingFactors.size(),
@@ -83,7 +90,7 @@ SecretKey Pedersen::BlindSwitch(const SecretKey& blindingFactor, const uint64_t
 {
     SecretKey blindSwitch;
     const int result = secp256k1_blind_switch(
-        m_context.Read()->Get(),
+        m_context.Get(),
         blindSwitch.data(),
         blindingFactor.data(),
         amount,
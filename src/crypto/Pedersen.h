@@ -9,7 +9,7 @@
 class Pedersen
 {
 public:
-    Pedersen(Locked<Context>& context) : m_context(context) { }
+    Pedersen(const Context& context) : m_context(context) { }
     ~Pedersen() = default;
 
     Commitment PedersenCommit(
@@ -33,5 +33,5 @@ public:
     ) const;
 
 private:
-    Locked<Context> m_context;
+    const Context& m_context;
 };
\ No newline at end of file
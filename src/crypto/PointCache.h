@@ -0,0 +1,117 @@
+#pragma once
+
+#include "Context.h"
+
+#include <mw/common/ShardedFifoCache.h>
+#include <mw/models/crypto/Commitment.h>
+#include <mw/models/crypto/PublicKey.h>
+#include <mw/exceptions/CryptoException.h>
+#include <mw/crypto/Random.h>
+#include <crypto/siphash.h>
+
+#include <cstring>
+
+//
+// Remembers the parsed (decompressed) forms of commitments and public keys, so decompressing a point,
+// which costs a field square root, happens once per point rather than every time the point is used.
+//
+// Parsing a commitment also converts it to a public key. Schnorr verification and commitment sums work on
+// those directly, and loading a secp256k1_pubkey is just a copy.
+//
+// Commitments (0x08/0x09 prefix) and compressed public keys (0x02/0x03 prefix) can't have the same bytes,
+// so both share one table. Shards and buckets are chosen by a salted SipHash, since the points come from the network.
+// Invalid points are never cached.
+//
+class PointCache
+{
+public:
+    static constexpr size_t DEFAULT_CAPACITY = 100'000;
+    static constexpr size_t NUM_SHARDS = 16;
+
+    struct ParsedCommitment
+    {
+        secp256k1_pedersen_commitment commitment;
+        secp256k1_pubkey pubkey;
+    };
+
+    static PointCache& GetShared()
+    {
+        static PointCache cache(DEFAULT_CAPACITY);
+        return cache;
+    }
+
+    explicit PointCache(const size_t capacity)
+        : m_cache(capacity, NUM_SHARDS, RandomHasher()) { }
+
+    ParsedCommitment Parse(const Context& context, const Commitment& commitment)
+    {
+        ParsedCommitment parsed;
+        if (m_cache.Find(commitment.GetBigInt(), parsed)) {
+            return parsed;
+        }
+
+        if (secp256k1_pedersen_commitment_parse(context.Get(), &parsed.commitment, commitment.data()) != 1) {
+            ThrowCrypto_F("Failed to parse commitment: {}", commitment);
+        }
+
+        if (secp256k1_pedersen_commitment_to_pubkey(context.Get(), &parsed.pubkey, &parsed.commitment) != 1) {
+            ThrowCrypto_F("Failed to convert commitment ({}) to pubkey", commitment);
+        }
+
+        m_cache.Insert(commitment.GetBigInt(), parsed);
+        return parsed;
+    }
+
+    secp256k1_pubkey Parse(const Context& context, const PublicKey& publicKey)
+    {
+        // Only the pubkey is used for public keys.
+        ParsedCommitment parsed;
+        if (m_cache.Find(publicKey.GetBigInt(), parsed)) {
+            return parsed.pubkey;
+        }
+
+        if (secp256k1_ec_pubkey_parse(context.Get(), &parsed.pubkey, publicKey.data(), publicKey.size()) != 1) {
+            ThrowCrypto_F("Failed to parse pubkey: {}", publicKey);
+        }
+
+        m_cache.Insert(publicKey.GetBigInt(), parsed);
+        return parsed.pubkey;
+    }
+
+    //
+    // Looks up a commitment without parsing or caching it on a miss.
+    //
+    bool Find(const Commitment& commitment, ParsedCommitment& parsed)
+    {
+        return m_cache.Find(commitment.GetBigInt(), parsed);
+    }
+
+    void SetCapacity(const size_t capacity) { m_cache.SetCapacity(capacity); }
+    size_t GetSize() const { return m_cache.GetSize(); }
+
+private:
+    using Key = BigInt<33>;
+
+    struct KeyHasher
+    {
+        uint64_t k0;
+        uint64_t k1;
+
+        size_t operator()(const Key& key) const noexcept
+        {
+            return (size_t)CSipHasher(k0, k1).Write(key.data(), key.size()).Finalize();
+        }
+    };
+
+    static KeyHasher RandomHasher()
+    {
+        const secret_key_t<16> salt = Random::CSPRNG<16>();
+
+        KeyHasher hasher;
+        memcpy(&hasher.k0, salt.data(), sizeof(hasher.k0));
+        memcpy(&hasher.k1, salt.data() + sizeof(hasher.k0), sizeof(hasher.k1));
+        return hasher;
+    }
+
+    ShardedFifoCache<Key, ParsedCommitment, KeyHasher> m_cache;
+};
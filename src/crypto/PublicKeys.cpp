@@ -6,7 +6,7 @@
 
 PublicKey PublicKeys::CalculatePublicKey(const SecretKey& privateKey) const
 {
-    const int verifyResult = secp256k1_ec_seckey_verify(m_context.Read()->Get(), privateKey.data());
+    const int verifyResult = secp256k1_ec_seckey_verify(m_context.Get(), privateKey.data());
     if (verifyResult != 1)
     {
         ThrowCrypto("Failed to verify secret key");
@@ -14,7 +14,7 @@ PublicKey PublicKeys::CalculatePublicKey(const SecretKey& privateKey) const
 
     secp256k1_pubkey pubkey;
     const int createResult = secp256k1_ec_pubkey_create(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &pubkey,
         privateKey.data()
     );
@@ -33,7 +33,7 @@ PublicKey PublicKeys::PublicKeySum(const std::vector<PublicKey>& publicKeys) con
 
     secp256k1_pubkey pubkey;
     const int pubKeysCombined = secp256k1_ec_pubkey_combine(
-        m_context.Read()->Get(),
+        m_context.Get(),
         &pubkey,
         pubkeyPtrs.data(),
         pubkeyPtrs.size()
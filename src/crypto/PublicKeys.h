@@ -8,12 +8,12 @@
 class PublicKeys
 {
 public:
-    PublicKeys(Locked<Context>& context) : m_context(context) { }
+    PublicKeys(const Context& context) : m_context(context) { }
     ~PublicKeys() = default;
 
     PublicKey CalculatePublicKey(const SecretKey& privateKey) const;
     PublicKey PublicKeySum(const std::vector<PublicKey>& publicKeys) const;
 
 private:
-    Locked<Context> m_context;
+    const Context& m_context;
 };
\ No newline at end of file
@@ -3,13 +3,11 @@
 #include "ConversionUtil.h"
 
 #include <mw/common/Logger.h>
+#include <mw/crypto/ScratchSpacePool.h>
+#include <mw/crypto/VerificationCache.h>
 #include <mw/exceptions/CryptoException.h>
 #include <mw/util/VectorUtil.h>
 
-Locked<Context> SCHNORR_CONTEXT(std::make_shared<Context>());
-
-const uint64_t MAX_WIDTH = 1 << 20;
-const size_t SCRATCH_SPACE_SIZE = 256 * MAX_WIDTH;
 
 Signature Schnorr::Sign(
     const SecretKey& secretKey,
@@ -17,7 +15,7 @@ Signature Schnorr::Sign(
 {
     secp256k1_schnorrsig signature;
     const int signedResult = secp256k1_schnorrsig_sign(
-        SCHNORR_CONTEXT.Write()->Randomized(),
+        Context::GetShared().Randomized(),
         &signature,
         nullptr,
         message.data(),
@@ -29,7 +27,7 @@ Signature Schnorr::Sign(
         ThrowCrypto("Failed to sign message.");
     }
 
-    return ConversionUtil(SCHNORR_CONTEXT).ToSignature(signature);
+    return ConversionUtil(Context::GetShared()).ToSignature(signature);
 }
 
 bool Schnorr::Verify(
@@ -37,10 +35,10 @@ bool Schnorr::Verify(
     const PublicKey& sumPubKeys,
     const mw::Hash& message)
 {
-    secp256k1_pubkey parsedPubKey = ConversionUtil(SCHNORR_CONTEXT).ToSecp256k1(sumPubKeys);
+    secp256k1_pubkey parsedPubKey = ConversionUtil(Context::GetShared()).ToSecp256k1(sumPubKeys);
 
     const int verifyResult = secp256k1_aggsig_verify_single(
-        SCHNORR_CONTEXT.Read()->Get(),
+        Context::GetShared().Get(),
         signature.data(),
         message.data(),
         nullptr,
@@ -55,18 +53,44 @@ bool Schnorr::Verify(
 
 bool Schnorr::BatchVerify(const std::vector<std::tuple<Signature, Commitment, mw::Hash>>& signatures)
 {
+    VerificationCache& cache = VerificationCache::GetSignatureCache();
+
     std::vector<const Signature*> signature_ptrs;
     std::vector<const Commitment*> commitment_ptrs;
     std::vector<const mw::Hash*> message_ptrs;
+    std::vector<VerificationCache::Key> keys;
 
+    // Only the signatures that haven't already been verified need to be batched.
     for (const auto& signature : signatures)
     {
+        VerificationCache::Key key = cache.NewKey()
+            .Append(std::get<0>(signature).data(), std::get<0>(signature).size())
+            .Append(std::get<1>(signature).data(), std::get<1>(signature).size())
+            .Append(std::get<2>(signature).data(), std::get<2>(signature).size())
+            .Build();
+        if (cache.Contains(key)) {
+            continue;
+        }
+
         signature_ptrs.push_back(&std::get<0>(signature));
         commitment_ptrs.push_back(&std::get<1>(signature));
         message_ptrs.push_back(&std::get<2>(signature));
+        keys.push_back(key);
+    }
+
+    if (signature_ptrs.empty()) {
+        return true;
+    }
+
+    if (!BatchVerify(signature_ptrs, commitment_ptrs, message_ptrs)) {
+        return false;
+    }
+
+    for (const VerificationCache::Key& key : keys) {
+        cache.Insert(key);
     }
 
-    return BatchVerify(signature_ptrs, commitment_ptrs, message_ptrs);
+    return true;
 }
 
 bool Schnorr::BatchVerify(
@@ -77,19 +101,11 @@ bool Schnorr::BatchVerify(
     assert(signatures.size() == commitments.size());
     assert(commitments.size() == messages.size());
 
-    std::vector<secp256k1_pubkey> parsedPubKeys;
-    std::transform(
-        commitments.cbegin(), commitments.cend(),
-        std::back_inserter(parsedPubKeys),
-        [](const Commitment* commitment) -> secp256k1_pubkey {
-            PublicKey publicKey = ConversionUtil(SCHNORR_CONTEXT).ToPublicKey(*commitment);
-            return ConversionUtil(SCHNORR_CONTEXT).ToSecp256k1(publicKey);
-        }
-    );
+    std::vector<secp256k1_pubkey> parsedPubKeys = ConversionUtil(Context::GetShared()).ToPubKeys(commitments);
 
     std::vector<secp256k1_pubkey*> pubKeyPtrs = VectorUtil::ToPointerVec(parsedPubKeys);
 
-    std::vector<secp256k1_schnorrsig> parsedSignatures = ConversionUtil(SCHNORR_CONTEXT).ToSecp256k1(signatures);
+    std::vector<secp256k1_schnorrsig> parsedSignatures = ConversionUtil(Context::GetShared()).ToSecp256k1(signatures);
     std::vector<secp256k1_schnorrsig*> signaturePtrs = VectorUtil::ToPointerVec(parsedSignatures);
 
     std::vector<const unsigned char*> messageData;
@@ -99,19 +115,15 @@ bool Schnorr::BatchVerify(
         [](const mw::Hash* pMessage) { return pMessage->data(); }
     );
 
-    secp256k1_scratch_space* pScratchSpace = secp256k1_scratch_space_create(
-        SCHNORR_CONTEXT.Read()->Get(),
-        SCRATCH_SPACE_SIZE
-    );
+    ScratchSpacePool::Handle scratch = ScratchSpacePool::GetShared().Acquire(Context::GetShared().Get());
     const int verifyResult = secp256k1_schnorrsig_verify_batch(
-        SCHNORR_CONTEXT.Read()->Get(),
-        pScratchSpace,
+        Context::GetShared().Get(),
+        scratch.Get(),
         signaturePtrs.data(),
         messageData.data(),
         pubKeyPtrs.data(),
         signatures.size()
     );
-    secp256k1_scratch_space_destroy(pScratchSpace);
 
     return verifyResult == 1;
 }
\ No newline at end of file
@@ -2,6 +2,10 @@
 #include "common/Database.h"
 
 static const DBTable UTXO_TABLE = { 'U', DBTable::Options({ true /* allowDuplicates */ }) };
+static const DBTable AGGREGATES_TABLE = { 'A' };
+
+// There's only ever one set of running totals, for the last flushed header, so they're always written to the same key.
+static const std::string AGGREGATES_KEY = "tip";
 
 CoinDB::CoinDB(libmw::IDBWrapper* pDBWrapper, libmw::IDBBatch* pBatch)
     : m_pDatabase(std::make_unique<Database>(pDBWrapper, pBatch))
@@ -52,4 +56,33 @@ void CoinDB::RemoveUTXOs(const std::vector<Commitment>& commitments)
 void CoinDB::RemoveAllUTXOs()
 {
     m_pDatabase->DeleteAll(UTXO_TABLE);
-}
\ No newline at end of file
+}
+
+void CoinDB::ForEachUTXO(const std::function<void(const UTXO&)>& fn) const
+{
+    auto iter = m_pDatabase->m_pDB->NewIterator();
+    iter->Seek(UTXO_TABLE.BuildKey(""));
+
+    std::string key;
+    while (iter->GetKey(key) && !key.empty() && key.front() == UTXO_TABLE.GetPrefix())
+    {
+        std::vector<uint8_t> value;
+        if (m_pDatabase->m_pDB->Read(key, value)) {
+            Deserializer deserializer(std::move(value));
+            fn(UTXO::Deserialize(deserializer));
+        }
+
+        iter->Next();
+    }
+}
+
+mw::StateAggregates::CPtr CoinDB::GetAggregates() const
+{
+    auto pEntry = m_pDatabase->Get<mw::StateAggregates>(AGGREGATES_TABLE, AGGREGATES_KEY);
+    return pEntry != nullptr ? pEntry->item : nullptr;
+}
+
+void CoinDB::WriteAggregates(const mw::StateAggregates::CPtr& pAggregates)
+{
+    m_pDatabase->Put(AGGREGATES_TABLE, std::vector<DBEntry<mw::StateAggregates>>{ DBEntry<mw::StateAggregates>(AGGREGATES_KEY, pAggregates) });
+}
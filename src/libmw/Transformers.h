@@ -1,6 +1,8 @@
 #pragma once
 
 #include <libmw/libmw.h>
+#include <mw/models/block/Block.h>
+#include <mw/models/block/BlockUndo.h>
 #include <mw/models/tx/PegInCoin.h>
 #include <mw/models/tx/PegOutCoin.h>
 #include <mw/models/tx/Transaction.h>
@@ -39,4 +41,40 @@ static std::vector<mw::Transaction::CPtr> TransformTxs(const std::vector<libmw::
     );
 
     return transactions;
+}
+
+static std::vector<mw::Block::Ptr> TransformBlocks(const std::vector<libmw::BlockRef>& blockRefs)
+{
+    std::vector<mw::Block::Ptr> blocks;
+    std::transform(
+        blockRefs.cbegin(), blockRefs.cend(),
+        std::back_inserter(blocks),
+        [](const libmw::BlockRef& block) { return block.pBlock; }
+    );
+
+    return blocks;
+}
+
+static std::vector<mw::BlockUndo::CPtr> TransformBlockUndoRefs(const std::vector<libmw::BlockUndoRef>& undoRefs)
+{
+    std::vector<mw::BlockUndo::CPtr> undos;
+    std::transform(
+        undoRefs.cbegin(), undoRefs.cend(),
+        std::back_inserter(undos),
+        [](const libmw::BlockUndoRef& undo) { return undo.pUndo; }
+    );
+
+    return undos;
+}
+
+static std::vector<libmw::BlockUndoRef> TransformBlockUndos(const std::vector<mw::BlockUndo::CPtr>& undos)
+{
+    std::vector<libmw::BlockUndoRef> undoRefs;
+    std::transform(
+        undos.cbegin(), undos.cend(),
+        std::back_inserter(undoRefs),
+        [](const mw::BlockUndo::CPtr& pUndo) { return libmw::BlockUndoRef{ pUndo }; }
+    );
+
+    return undoRefs;
 }
\ No newline at end of file
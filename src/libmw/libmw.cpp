@@ -6,8 +6,11 @@
 
 #include <mw/models/block/Block.h>
 #include <mw/models/block/BlockUndo.h>
+#include <mw/models/block/BlockView.h>
+#include <mw/models/block/CompactBlockUndo.h>
 #include <mw/models/tx/Transaction.h>
 #include <mw/models/tx/UTXO.h>
+#include <mw/consensus/TxValidator.h>
 #include <mw/node/INode.h>
 
 static mw::INode::Ptr NODE = nullptr;
@@ -16,8 +19,8 @@ LIBMW_NAMESPACE
 
 EXPORT libmw::HeaderRef DeserializeHeader(const std::vector<uint8_t>& bytes)
 {
-    Deserializer deserializer{ bytes };
-    auto pHeader = std::make_shared<mw::Header>(mw::Header::Deserialize(deserializer));
+    Deserializer deserializer{ bytes.data(), bytes.size() };
+    auto pHeader = ObjectPool::MakeShared<mw::Header>(mw::Header::Deserialize(deserializer));
     return libmw::HeaderRef{ pHeader };
 }
 
@@ -28,9 +31,13 @@ EXPORT std::vector<uint8_t> SerializeHeader(const libmw::HeaderRef& header)
 
 EXPORT libmw::BlockRef DeserializeBlock(const std::vector<uint8_t>& bytes)
 {
-    Deserializer deserializer{ bytes };
-    auto pBlock = std::make_shared<mw::Block>(mw::Block::Deserialize(deserializer));
-    return libmw::BlockRef{ pBlock };
+    return DeserializeBlock(bytes.data(), bytes.size());
+}
+
+EXPORT libmw::BlockRef DeserializeBlock(const uint8_t* pBytes, const size_t length)
+{
+    // Large blocks are decoded and hashed across the shared thread pool.
+    return libmw::BlockRef{ mw::BlockView::Decode(pBytes, length) };
 }
 
 EXPORT std::vector<uint8_t> SerializeBlock(const libmw::BlockRef& block)
@@ -40,7 +47,7 @@ EXPORT std::vector<uint8_t> SerializeBlock(const libmw::BlockRef& block)
 
 EXPORT libmw::BlockUndoRef DeserializeBlockUndo(const std::vector<uint8_t>& bytes)
 {
-    Deserializer deserializer{ bytes };
+    Deserializer deserializer{ bytes.data(), bytes.size() };
     auto pBlockUndo = std::make_shared<mw::BlockUndo>(mw::BlockUndo::Deserialize(deserializer));
     return libmw::BlockUndoRef{ pBlockUndo };
 }
@@ -50,6 +57,11 @@ EXPORT std::vector<uint8_t> SerializeBlockUndo(const libmw::BlockUndoRef& blockU
     return blockUndo.pUndo->Serialized();
 }
 
+EXPORT std::vector<uint8_t> SerializeCompactBlockUndo(const libmw::BlockUndoRef& blockUndo)
+{
+    return mw::CompactBlockUndo::FromUndo(*blockUndo.pUndo).Serialized();
+}
+
 EXPORT std::vector<PegOut> TxRef::GetPegouts() const noexcept
 {
     std::vector<PegOut> pegouts;
@@ -72,7 +84,12 @@ EXPORT uint64_t TxRef::GetTotalFee() const noexcept
 
 EXPORT libmw::TxRef DeserializeTx(const std::vector<uint8_t>& bytes)
 {
-    Deserializer deserializer{ bytes };
+    return DeserializeTx(bytes.data(), bytes.size());
+}
+
+EXPORT libmw::TxRef DeserializeTx(const uint8_t* pBytes, const size_t length)
+{
+    Deserializer deserializer{ pBytes, length };
     auto pTx = std::make_shared<mw::Transaction>(mw::Transaction::Deserialize(deserializer));
     return libmw::TxRef{ pTx };
 }
@@ -96,9 +113,10 @@ NODE_NAMESPACE
 EXPORT libmw::CoinsViewRef Initialize(
     const libmw::ChainParams& chainParams,
     const libmw::HeaderRef& header,
-    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper)
+    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper,
+    const bool auditState)
 {
-    NODE = mw::InitializeNode(FilePath{ chainParams.dataDirectory }, chainParams.hrp, header.pHeader, pDBWrapper);
+    NODE = mw::InitializeNode(FilePath{ chainParams.dataDirectory }, chainParams.hrp, header.pHeader, pDBWrapper, auditState);
 
     return libmw::CoinsViewRef{ NODE->GetDBView() };
 }
@@ -135,11 +153,41 @@ EXPORT libmw::BlockUndoRef ConnectBlock(const libmw::BlockRef& block, const Coin
     return libmw::BlockUndoRef{ NODE->ConnectBlock(block.pBlock, view.pCoinsView) };
 }
 
+EXPORT std::vector<libmw::BlockUndoRef> ConnectBlocks(
+    const std::vector<libmw::BlockRef>& blocks,
+    const CoinsViewRef& view,
+    const uint64_t maxCacheBytes)
+{
+    auto undos = NODE->ConnectBlocks(TransformBlocks(blocks), view.pCoinsView, (size_t)maxCacheBytes);
+    return TransformBlockUndos(undos);
+}
+
 EXPORT void DisconnectBlock(const libmw::BlockUndoRef& undoData, const CoinsViewRef& view)
 {
     NODE->DisconnectBlock(undoData.pUndo, view.pCoinsView);
 }
 
+EXPORT void DisconnectBlocks(const std::vector<libmw::BlockUndoRef>& undos, const CoinsViewRef& view)
+{
+    NODE->DisconnectBlocks(TransformBlockUndoRefs(undos), view.pCoinsView);
+}
+
+EXPORT libmw::BlockUndoRef ExpandCompactBlockUndo(
+    const std::vector<uint8_t>& bytes,
+    const libmw::CoinsViewRef& view,
+    const libmw::IBlockStore::Ptr& pBlockStore)
+{
+    Deserializer deserializer{ bytes.data(), bytes.size() };
+    auto pCompactUndo = std::make_shared<mw::CompactBlockUndo>(mw::CompactBlockUndo::Deserialize(deserializer));
+
+    if (pBlockStore != nullptr) {
+        BlockStoreWrapper blockStore(pBlockStore.get());
+        return libmw::BlockUndoRef{ NODE->ExpandUndo(pCompactUndo, view.pCoinsView, &blockStore) };
+    }
+
+    return libmw::BlockUndoRef{ NODE->ExpandUndo(pCompactUndo, view.pCoinsView, nullptr) };
+}
+
 EXPORT libmw::BlockRef BuildNextBlock(
     const uint64_t height,
     const libmw::CoinsViewRef& view,
@@ -164,9 +212,35 @@ EXPORT void FlushCache(const libmw::CoinsViewRef& view, const std::unique_ptr<li
     pViewCache->Flush(pBatch);
 }
 
+EXPORT void FlushCacheAsync(const libmw::CoinsViewRef& view)
+{
+    auto pViewCache = dynamic_cast<mw::CoinsViewCache*>(view.pCoinsView.get());
+    assert(pViewCache != nullptr);
+
+    pViewCache->FlushAsync();
+}
+
+EXPORT void WaitForFlush(const libmw::CoinsViewRef& view)
+{
+    auto pViewCache = dynamic_cast<mw::CoinsViewCache*>(view.pCoinsView.get());
+    assert(pViewCache != nullptr);
+
+    pViewCache->WaitForFlush();
+}
+
+EXPORT uint64_t GetCacheMemoryUsage(const libmw::CoinsViewRef& view)
+{
+    auto pViewCache = dynamic_cast<mw::CoinsViewCache*>(view.pCoinsView.get());
+    if (pViewCache == nullptr) {
+        return 0;
+    }
+
+    return pViewCache->GetMemoryUsage();
+}
+
 EXPORT libmw::StateRef DeserializeState(const std::vector<uint8_t>& bytes)
 {
-    Deserializer deserializer{ bytes };
+    Deserializer deserializer{ bytes.data(), bytes.size() };
     mw::State state = mw::State::Deserialize(deserializer);
     return { std::make_shared<mw::State>(std::move(state)) };
 }
@@ -183,7 +257,7 @@ EXPORT libmw::StateRef SnapshotState(const libmw::CoinsViewRef& view, const libm
 
 EXPORT void CheckTransaction(const libmw::TxRef& transaction)
 {
-    // TODO: Implement
+    TransactionValidator().Validate(transaction.pTransaction);
 }
 
 END_NAMESPACE
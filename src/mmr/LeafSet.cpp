@@ -25,21 +25,29 @@ LeafSet::Ptr LeafSet::Open(const FilePath& leafset_dir)
 
 void LeafSet::ApplyUpdates(const mmr::LeafIndex& nextLeafIdx, const std::unordered_map<uint64_t, uint8_t>& modifiedBytes)
 {
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+
 	for (auto byte : modifiedBytes) {
 		m_modifiedBytes[byte.first + 8] = byte.second;
 	}
 
     // In case of rewind, make sure to clear everything above the new next
     for (size_t idx = nextLeafIdx.Get(); idx < m_nextLeafIdx.Get(); idx++) {
-        Remove(mmr::LeafIndex::At(idx));
+        WriteByte(idx / 8, ReadByte(idx / 8) & (0xff ^ BitToByte(idx % 8)));
     }
 
     m_nextLeafIdx = nextLeafIdx;
 
-    Flush();
+    WriteToFile();
 }
 
 void LeafSet::Flush()
+{
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    WriteToFile();
+}
+
+void LeafSet::WriteToFile()
 {
     m_mmap.Unmap();
 
@@ -57,6 +65,18 @@ void LeafSet::Flush()
 }
 
 uint8_t LeafSet::GetByte(const uint64_t byteIdx) const
+{
+    std::shared_lock<std::shared_mutex> lock(m_mutex);
+    return ReadByte(byteIdx);
+}
+
+void LeafSet::SetByte(const uint64_t byteIdx, const uint8_t value)
+{
+    std::unique_lock<std::shared_mutex> lock(m_mutex);
+    WriteByte(byteIdx, value);
+}
+
+uint8_t LeafSet::ReadByte(const uint64_t byteIdx) const
 {
     // Offset by 8 bytes, since first 8 bytes in file represent the next leaf index
     const uint64_t byteIdxWithOffset = byteIdx + 8;
@@ -74,7 +94,7 @@ uint8_t LeafSet::GetByte(const uint64_t byteIdx) const
     return 0;
 }
 
-void LeafSet::SetByte(const uint64_t byteIdx, const uint8_t value)
+void LeafSet::WriteByte(const uint64_t byteIdx, const uint8_t value)
 {
 	m_modifiedBytes[byteIdx + 8] = value;
 }
@@ -27,8 +27,40 @@ void LeafSetCache::ApplyUpdates(const mmr::LeafIndex& nextLeafIdx, const std::un
 
 void LeafSetCache::Flush()
 {
+	assert(m_snapshots.empty());
+
 	m_pBacked->ApplyUpdates(m_nextLeafIdx, m_modifiedBytes);
-	m_modifiedBytes.clear();
+	std::unordered_map<uint64_t, uint8_t>().swap(m_modifiedBytes);
+}
+
+size_t LeafSetCache::GetMemoryUsage() const noexcept
+{
+	size_t usage = MemoryUtil::DynamicUsage(m_modifiedBytes);
+	for (const Snapshot::CPtr& pSnapshot : m_snapshots) {
+		usage += MemoryUtil::DynamicUsage(pSnapshot->modifiedBytes);
+	}
+
+	return usage;
+}
+
+LeafSetCache::Snapshot::CPtr LeafSetCache::TakeSnapshot()
+{
+	auto pSnapshot = std::make_shared<const Snapshot>(Snapshot{ m_nextLeafIdx, std::move(m_modifiedBytes) });
+	m_modifiedBytes = std::unordered_map<uint64_t, uint8_t>();
+	m_snapshots.push_back(pSnapshot);
+
+	return pSnapshot;
+}
+
+void LeafSetCache::WriteSnapshot(const Snapshot& snapshot) const
+{
+	m_pBacked->ApplyUpdates(snapshot.nextLeafIdx, snapshot.modifiedBytes);
+}
+
+void LeafSetCache::ReleaseSnapshot()
+{
+	assert(!m_snapshots.empty());
+	m_snapshots.pop_front();
 }
 
 uint8_t LeafSetCache::GetByte(const uint64_t byteIdx) const
@@ -39,6 +71,16 @@ uint8_t LeafSetCache::GetByte(const uint64_t byteIdx) const
 		return iter->second;
 	}
 
+	for (auto snapshot_iter = m_snapshots.crbegin(); snapshot_iter != m_snapshots.crend(); snapshot_iter++)
+	{
+		const auto& snapshotBytes = (*snapshot_iter)->modifiedBytes;
+		auto byte_iter = snapshotBytes.find(byteIdx);
+		if (byte_iter != snapshotBytes.cend())
+		{
+			return byte_iter->second;
+		}
+	}
+
 	return m_pBacked->GetByte(byteIdx);
 }
 
@@ -5,6 +5,7 @@ using namespace mmr;
 
 LeafIndex MMR::AddLeaf(std::vector<uint8_t>&& data)
 {
+    std::unique_lock<std::shared_mutex> lock(*m_pMutex);
     const LeafIndex leafIdx = m_pBackend->GetNextLeaf();
     m_pBackend->AddLeaf(Leaf::Create(leafIdx, std::move(data)));
     return leafIdx;
@@ -12,11 +13,13 @@ LeafIndex MMR::AddLeaf(std::vector<uint8_t>&& data)
 
 uint64_t MMR::GetNumLeaves() const noexcept
 {
+    std::shared_lock<std::shared_mutex> lock(*m_pMutex);
     return m_pBackend->GetNumLeaves();
 }
 
 uint64_t MMR::GetNumNodes() const noexcept
 {
+    std::shared_lock<std::shared_mutex> lock(*m_pMutex);
     const uint64_t numLeaves = m_pBackend->GetNumLeaves();
     if (numLeaves == 0)
     {
@@ -82,11 +85,13 @@ void MMR::Rewind(const uint64_t numNodes)
     const Index nextIdx = Index::At(numNodes);
     assert(nextIdx.IsLeaf());
 
+    std::unique_lock<std::shared_mutex> lock(*m_pMutex);
     m_pBackend->Rewind(LeafIndex(nextIdx.GetLeafIndex(), nextIdx.GetPosition()));
 }
 
 void MMR::BatchWrite(const LeafIndex& firstLeafIdx, const std::vector<Leaf>& leaves)
 {
+    std::unique_lock<std::shared_mutex> lock(*m_pMutex);
     m_pBackend->Rewind(firstLeafIdx);
     for (const Leaf& leaf : leaves)
     {
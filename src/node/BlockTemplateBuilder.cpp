@@ -0,0 +1,275 @@
+#include <mw/node/BlockTemplateBuilder.h>
+#include <mw/crypto/Crypto.h>
+#include <mw/common/Logger.h>
+
+MW_NAMESPACE
+
+void BlockTemplateBuilder::AddTransaction(const mw::Transaction::CPtr& pTransaction)
+{
+    assert(pTransaction != nullptr);
+
+    const mw::Hash& txHash = pTransaction->GetHash();
+    if (m_candidates.find(txHash) != m_candidates.cend()) {
+        return;
+    }
+
+    Candidate candidate;
+    candidate.pTransaction = pTransaction;
+    candidate.weight = pTransaction->GetBody().GetWeight();
+    candidate.fee = pTransaction->GetTotalFee();
+    candidate.feeRate = candidate.weight > 0 ? (double)candidate.fee / candidate.weight : 0.0;
+
+    for (const Input& input : pTransaction->GetInputs()) {
+        if (m_pBase->GetUTXOs(input.GetCommitment()).empty()) {
+            candidate.unconfirmedInputs.push_back(input.GetCommitment());
+        }
+
+        m_spentBy[input.GetCommitment()].insert(txHash);
+    }
+
+    const FeeRateKey key{ candidate.feeRate, txHash };
+    const Candidate& added = m_candidates.insert({ txHash, std::move(candidate) }).first->second;
+    m_byFeeRate.insert(key);
+
+    if (TrySelect(added) || m_reselect || added.weight > m_maxWeight) {
+        return;
+    }
+
+    // It didn't fit, but it may be worth more than a selected transaction with a lower fee rate.
+    for (auto iter = m_byFeeRate.crbegin(); iter != m_byFeeRate.crend() && iter->second != txHash; iter++) {
+        if (IsSelected(iter->second)) {
+            m_reselect = true;
+            break;
+        }
+    }
+}
+
+void BlockTemplateBuilder::RemoveTransaction(const mw::Hash& txHash)
+{
+    auto iter = m_candidates.find(txHash);
+    if (iter == m_candidates.end()) {
+        return;
+    }
+
+    const Candidate& candidate = iter->second;
+    if (IsSelected(txHash)) {
+        Deselect(candidate);
+        m_reselect = true;
+    }
+
+    for (const Input& input : candidate.pTransaction->GetInputs()) {
+        auto spent_iter = m_spentBy.find(input.GetCommitment());
+        if (spent_iter != m_spentBy.end()) {
+            spent_iter->second.erase(txHash);
+            if (spent_iter->second.empty()) {
+                m_spentBy.erase(spent_iter);
+            }
+        }
+    }
+
+    m_byFeeRate.erase(FeeRateKey{ candidate.feeRate, txHash });
+    m_candidates.erase(iter);
+}
+
+mw::Block::Ptr BlockTemplateBuilder::GetTemplate()
+{
+    if (m_reselect) {
+        Reselect();
+    }
+
+    if (m_pTemplate != nullptr) {
+        return m_pTemplate;
+    }
+
+    std::vector<Input> inputs;
+    inputs.reserve(m_inputs.size());
+    for (const auto& entry : m_inputs) {
+        inputs.push_back(entry.second);
+    }
+
+    std::vector<Output> outputs;
+    outputs.reserve(m_outputs.size());
+    for (const auto& entry : m_outputs) {
+        outputs.push_back(entry.second);
+    }
+
+    std::vector<Kernel> kernels;
+    kernels.reserve(m_kernels.size());
+    for (const auto& entry : m_kernels) {
+        kernels.push_back(entry.second);
+    }
+
+    auto pTransaction = std::make_shared<mw::Transaction>(
+        BlindingFactor(m_offset),
+        TxBody{ std::move(inputs), std::move(outputs), std::move(kernels) }
+    );
+
+    LOG_TRACE_F("Building template with {} transactions", m_selected.size());
+    auto pCache = std::make_shared<CoinsViewCache>(m_pBase);
+    m_pTemplate = pCache->BuildNextBlock(m_height, pTransaction, m_numUnvalidated == 0);
+    return m_pTemplate;
+}
+
+bool BlockTemplateBuilder::TrySelect(const Candidate& candidate)
+{
+    if (IsSelected(candidate.pTransaction->GetHash()) || m_weight + candidate.weight > m_maxWeight) {
+        return false;
+    }
+
+    for (const Commitment& commitment : candidate.unconfirmedInputs) {
+        if (m_selectedOutputs.find(commitment) == m_selectedOutputs.cend()) {
+            return false;
+        }
+    }
+
+    // Conflicts with a selected transaction spending the same output.
+    for (const Input& input : candidate.pTransaction->GetInputs()) {
+        if (m_selectedSpends.find(input.GetCommitment()) != m_selectedSpends.cend()) {
+            return false;
+        }
+    }
+
+    // Creates an output or kernel that's already selected, which would count its offset and fee twice.
+    for (const Output& output : candidate.pTransaction->GetOutputs()) {
+        if (m_selectedOutputs.find(output.GetCommitment()) != m_selectedOutputs.cend()) {
+            return false;
+        }
+    }
+
+    for (const Kernel& kernel : candidate.pTransaction->GetKernels()) {
+        if (m_kernels.find(kernel.GetHash()) != m_kernels.cend()) {
+            return false;
+        }
+    }
+
+    Select(candidate);
+    SelectDependents(*candidate.pTransaction);
+    return true;
+}
+
+void BlockTemplateBuilder::Select(const Candidate& candidate)
+{
+    const mw::Transaction& transaction = *candidate.pTransaction;
+
+    for (const Input& input : transaction.GetInputs()) {
+        m_selectedSpends.insert(input.GetCommitment());
+
+        auto output_iter = m_selectedOutputs.find(input.GetCommitment());
+        if (output_iter != m_selectedOutputs.end()) {
+            m_outputs.erase(output_iter->second->GetHash());
+            m_cutThrough.insert(input.GetCommitment());
+        } else {
+            m_inputs.insert({ input.GetHash(), input });
+        }
+    }
+
+    for (const Output& output : transaction.GetOutputs()) {
+        m_selectedOutputs.insert({ output.GetCommitment(), &output });
+        m_outputs.insert({ output.GetHash(), output });
+    }
+
+    for (const Kernel& kernel : transaction.GetKernels()) {
+        m_kernels.insert({ kernel.GetHash(), kernel });
+    }
+
+    m_offset = Crypto::AddBlindingFactors({ m_offset, transaction.GetOffset() });
+    m_weight += candidate.weight;
+    m_totalFee += candidate.fee;
+    if (!transaction.WasValidated()) {
+        ++m_numUnvalidated;
+    }
+
+    m_selected.insert(transaction.GetHash());
+    m_pTemplate = nullptr;
+}
+
+void BlockTemplateBuilder::Deselect(const Candidate& candidate)
+{
+    const mw::Transaction& transaction = *candidate.pTransaction;
+
+    // Anything spending this transaction's outputs can't be included without it.
+    DeselectDependents(transaction);
+
+    for (const Output& output : transaction.GetOutputs()) {
+        m_selectedOutputs.erase(output.GetCommitment());
+        m_outputs.erase(output.GetHash());
+    }
+
+    for (const Input& input : transaction.GetInputs()) {
+        m_selectedSpends.erase(input.GetCommitment());
+
+        if (m_cutThrough.erase(input.GetCommitment()) > 0) {
+            const Output* pOutput = m_selectedOutputs.at(input.GetCommitment());
+            m_outputs.insert({ pOutput->GetHash(), *pOutput });
+        } else {
+            m_inputs.erase(input.GetHash());
+        }
+    }
+
+    for (const Kernel& kernel : transaction.GetKernels()) {
+        m_kernels.erase(kernel.GetHash());
+    }
+
+    m_offset = Crypto::AddBlindingFactors({ m_offset }, { transaction.GetOffset() });
+    m_weight -= candidate.weight;
+    m_totalFee -= candidate.fee;
+    if (!transaction.WasValidated()) {
+        --m_numUnvalidated;
+    }
+
+    m_selected.erase(transaction.GetHash());
+    m_pTemplate = nullptr;
+}
+
+void BlockTemplateBuilder::SelectDependents(const mw::Transaction& transaction)
+{
+    for (const Output& output : transaction.GetOutputs()) {
+        auto iter = m_spentBy.find(output.GetCommitment());
+        if (iter != m_spentBy.cend()) {
+            for (const mw::Hash& spender : iter->second) {
+                TrySelect(m_candidates.at(spender));
+            }
+        }
+    }
+}
+
+void BlockTemplateBuilder::DeselectDependents(const mw::Transaction& transaction)
+{
+    for (const Output& output : transaction.GetOutputs()) {
+        auto iter = m_spentBy.find(output.GetCommitment());
+        if (iter != m_spentBy.cend()) {
+            // At most one spender is selected.
+            for (const mw::Hash& spender : iter->second) {
+                if (IsSelected(spender)) {
+                    Deselect(m_candidates.at(spender));
+                    break;
+                }
+            }
+        }
+    }
+}
+
+void BlockTemplateBuilder::Reselect()
+{
+    m_selected.clear();
+    m_selectedOutputs.clear();
+    m_selectedSpends.clear();
+    m_cutThrough.clear();
+    m_inputs.clear();
+    m_outputs.clear();
+    m_kernels.clear();
+    m_offset = BlindingFactor();
+    m_weight = 0;
+    m_totalFee = 0;
+    m_numUnvalidated = 0;
+    m_pTemplate = nullptr;
+    m_reselect = false;
+
+    for (const FeeRateKey& key : m_byFeeRate) {
+        TrySelect(m_candidates.at(key.second));
+    }
+
+    LOG_DEBUG_F("Selected {} of {} transactions, weight {}", m_selected.size(), m_candidates.size(), m_weight);
+}
+
+END_NAMESPACE
@@ -5,11 +5,9 @@
 
 MW_NAMESPACE
 
-std::vector<UTXO::CPtr> CoinsViewCache::GetUTXOs(const Commitment& commitment) const
+static void ApplyActions(const CoinsViewUpdates& updates, const Commitment& commitment, std::vector<UTXO::CPtr>& utxos)
 {
-    std::vector<UTXO::CPtr> utxos = m_pBase->GetUTXOs(commitment);
-
-    const std::vector<CoinAction>& actions = m_pUpdates->GetActions(commitment);
+    const std::vector<CoinAction>& actions = updates.GetActions(commitment);
     for (const CoinAction& action : actions) {
         if (action.pUTXO != nullptr) {
             utxos.push_back(action.pUTXO);
@@ -18,7 +16,30 @@ std::vector<UTXO::CPtr> CoinsViewCache::GetUTXOs(const Commitment& commitment) c
             utxos.pop_back();
         }
     }
+}
+
+CoinsViewCache::~CoinsViewCache()
+{
+    // Finishes any flushes that are still being written, since they reference this cache.
+    m_pFlushQueue.reset();
+}
+
+std::vector<UTXO::CPtr> CoinsViewCache::GetUTXOs(const Commitment& commitment) const
+{
+    std::vector<UTXO::CPtr> utxos;
+    {
+        // Updates that are being flushed must be applied on top of the base,
+        // up until they've been written to it.
+        std::shared_lock<std::shared_mutex> lock(m_flushMutex);
+        utxos = m_pBase->GetUTXOs(commitment);
+        for (const auto& pPendingFlush : m_pendingFlushes) {
+            if (!pPendingFlush->updatesWritten) {
+                ApplyActions(*pPendingFlush->pUpdates, commitment, utxos);
+            }
+        }
+    }
 
+    ApplyActions(*m_pUpdates, commitment, utxos);
     return utxos;
 }
 
@@ -26,15 +47,33 @@ mw::BlockUndo::CPtr CoinsViewCache::ApplyBlock(const mw::Block::Ptr& pBlock)
 {
     assert(pBlock != nullptr);
 
+    const ObjectPool::Stats poolStatsBefore = ObjectPool::GetThreadStats();
+
+    // Checked before anything is applied, rather than when the totals are summed at flush time.
+    if (HasAggregates()) {
+        uint64_t pegged_in = 0;
+        uint64_t pegged_out = 0;
+        for (const Kernel& kernel : pBlock->GetKernels()) {
+            pegged_in += kernel.GetPeggedIn();
+            pegged_out += kernel.GetPeggedOut();
+        }
+
+        if (GetPeggedSupply() + pegged_in < pegged_out) {
+            LOG_ERROR_F("Block {} pegs out more than the pegged supply", pBlock);
+            ThrowValidation(EConsensusError::BLOCK_SUMS);
+        }
+    }
+
     auto pPreviousHeader = GetBestHeader();
     SetBestHeader(pBlock->GetHeader());
 
     std::for_each(
         pBlock->GetKernels().cbegin(), pBlock->GetKernels().cend(),
-        [this](const Kernel& kernel) { m_pKernelMMR->Add(kernel); }
+        [this](const Kernel& kernel) { m_pKernelMMR->Add(kernel.GetSerialized()); }
     );
 
     std::vector<UTXO> coinsSpent;
+    coinsSpent.reserve(pBlock->GetInputs().size());
     std::for_each(
         pBlock->GetInputs().cbegin(), pBlock->GetInputs().cend(),
         [this, &coinsSpent](const Input& input) {
@@ -44,6 +83,7 @@ mw::BlockUndo::CPtr CoinsViewCache::ApplyBlock(const mw::Block::Ptr& pBlock)
     );
 
     std::vector<Commitment> coinsAdded;
+    coinsAdded.reserve(pBlock->GetOutputs().size());
     std::for_each(
         pBlock->GetOutputs().cbegin(), pBlock->GetOutputs().cend(),
         [this, &pBlock, &coinsAdded](const Output& output) {
@@ -54,24 +94,85 @@ mw::BlockUndo::CPtr CoinsViewCache::ApplyBlock(const mw::Block::Ptr& pBlock)
 
     ValidateMMRs(pBlock->GetHeader());
 
-    return std::make_shared<mw::BlockUndo>(pPreviousHeader, std::move(coinsSpent), std::move(coinsAdded));
+    if (HasAggregates()) {
+        mw::StateAggregates::Changes& changes = m_pUpdates->GetAggregateChanges();
+        for (const Input& input : pBlock->GetInputs()) {
+            changes.utxosRemoved.push_back(input.GetCommitment());
+        }
+
+        for (const Kernel& kernel : pBlock->GetKernels()) {
+            changes.AddKernel(kernel);
+        }
+
+        changes.utxosAdded.insert(changes.utxosAdded.end(), coinsAdded.cbegin(), coinsAdded.cend());
+        m_pAggregates = nullptr;
+    }
+
+    auto pUndo = std::make_shared<mw::BlockUndo>(pPreviousHeader, std::move(coinsSpent), std::move(coinsAdded));
+
+    const ObjectPool::Stats poolStats = ObjectPool::GetThreadStats() - poolStatsBefore;
+    LOG_DEBUG_F(
+        "Applied block {}: {} pooled objects created ({} from the heap), {} released",
+        pBlock,
+        poolStats.GetTotal(),
+        poolStats.allocated,
+        poolStats.released
+    );
+
+    return pUndo;
 }
 
 void CoinsViewCache::UndoBlock(const mw::BlockUndo::CPtr& pUndo)
 {
-    assert(pUndo != nullptr);
+    UndoBlocks({ pUndo });
+}
 
-    for (const Commitment& coinToRemove : pUndo->GetCoinsAdded()) {
-        m_pUpdates->SpendUTXO(coinToRemove);
+void CoinsViewCache::UndoBlocks(const std::vector<mw::BlockUndo::CPtr>& undos)
+{
+    if (undos.empty()) {
+        return;
     }
 
+    // The MMR snapshots of pending flushes can't be rewound.
+    WaitForFlush();
+
+    // Leaves spent by a block that were created by an earlier block being undone are also
+    // in leavesToAdd, but the rewind removes everything created after the fork point anyway.
     std::vector<mmr::LeafIndex> leavesToAdd;
-    for (const UTXO& coinToAdd : pUndo->GetCoinsSpent()) {
-        leavesToAdd.push_back(coinToAdd.GetLeafIndex());
-        m_pUpdates->AddUTXO(std::make_shared<UTXO>(coinToAdd));
+    for (const mw::BlockUndo::CPtr& pUndo : undos) {
+        assert(pUndo != nullptr);
+
+        for (const Commitment& coinToRemove : pUndo->GetCoinsAdded()) {
+            m_pUpdates->SpendUTXO(coinToRemove);
+        }
+
+        for (const UTXO& coinToAdd : pUndo->GetCoinsSpent()) {
+            leavesToAdd.push_back(coinToAdd.GetLeafIndex());
+            m_pUpdates->AddUTXO(ObjectPool::MakeShared<UTXO>(coinToAdd));
+        }
+
+        if (HasAggregates()) {
+            mw::StateAggregates::Changes& changes = m_pUpdates->GetAggregateChanges();
+            const std::vector<Commitment>& coinsAdded = pUndo->GetCoinsAdded();
+            changes.utxosRemoved.insert(changes.utxosRemoved.end(), coinsAdded.cbegin(), coinsAdded.cend());
+            for (const UTXO& coinSpent : pUndo->GetCoinsSpent()) {
+                changes.utxosAdded.push_back(coinSpent.GetCommitment());
+            }
+        }
+    }
+
+    auto pHeader = undos.back()->GetPreviousHeader();
+
+    // The undo data doesn't include kernels, so the ones being removed are read back from the kernel MMR before it's rewound.
+    if (HasAggregates()) {
+        for (uint64_t i = pHeader->GetNumKernels(); i < m_pKernelMMR->GetNumLeaves(); i++) {
+            Deserializer deserializer{ m_pKernelMMR->GetLeaf(mmr::LeafIndex::At(i)).vec() };
+            m_pUpdates->GetAggregateChanges().RemoveKernel(Kernel::Deserialize(deserializer));
+        }
+
+        m_pAggregates = nullptr;
     }
 
-    auto pHeader = pUndo->GetPreviousHeader();
     m_pLeafSet->Rewind(pHeader->GetNumTXOs(), leavesToAdd);
     m_pKernelMMR->Rewind(pHeader->GetNumKernels());
     m_pOutputPMMR->Rewind(pHeader->GetNumTXOs());
@@ -87,9 +188,21 @@ mw::Block::Ptr CoinsViewCache::BuildNextBlock(const uint64_t height, const std::
     LOG_TRACE_F("Building block with {} transactions", transactions.size());
     auto pTransaction = Aggregation::Aggregate(transactions);
 
+    // Aggregation only performs cut-through, which can't invalidate anything,
+    // so a block made up of validated transactions is valid too, as long as they fit in a block together.
+    const bool all_validated = std::all_of(
+        transactions.cbegin(), transactions.cend(),
+        [](const mw::Transaction::CPtr& pTx) { return pTx->WasValidated(); }
+    ) && pTransaction->GetBody().GetWeight() <= Consensus::MAX_BLOCK_WEIGHT;
+
+    return BuildNextBlock(height, pTransaction, all_validated);
+}
+
+mw::Block::Ptr CoinsViewCache::BuildNextBlock(const uint64_t height, const mw::Transaction::CPtr& pTransaction, const bool validated)
+{
     std::for_each(
         pTransaction->GetKernels().cbegin(), pTransaction->GetKernels().cend(),
-        [this](const Kernel& kernel) { m_pKernelMMR->Add(kernel); }
+        [this](const Kernel& kernel) { m_pKernelMMR->Add(kernel.GetSerialized()); }
     );
 
     std::for_each(
@@ -118,7 +231,7 @@ mw::Block::Ptr CoinsViewCache::BuildNextBlock(const uint64_t height, const std::
         });
     }
 
-    auto pHeader = std::make_shared<mw::Header>(
+    auto pHeader = ObjectPool::MakeShared<mw::Header>(
         height,
         std::move(output_root),
         std::move(rangeproof_root),
@@ -129,7 +242,12 @@ mw::Block::Ptr CoinsViewCache::BuildNextBlock(const uint64_t height, const std::
         kernel_mmr_size
     );
 
-    return std::make_shared<mw::Block>(pHeader, pTransaction->GetBody());
+    auto pBlock = std::make_shared<mw::Block>(pHeader, pTransaction->GetBody());
+    if (validated) {
+        pBlock->MarkAsValidated();
+    }
+
+    return pBlock;
 }
 
 void CoinsViewCache::AddUTXO(const uint64_t header_height, const Output& output)
@@ -140,7 +258,7 @@ void CoinsViewCache::AddUTXO(const uint64_t header_height, const Output& output)
 
     m_pLeafSet->Add(leafIdx);
 
-    auto pUTXO = std::make_shared<UTXO>(header_height, std::move(leafIdx), output);
+    auto pUTXO = ObjectPool::MakeShared<UTXO>(header_height, std::move(leafIdx), output);
 
     m_pUpdates->AddUTXO(pUTXO);
 }
@@ -161,6 +279,8 @@ UTXO CoinsViewCache::SpendUTXO(const Commitment& commitment)
 void CoinsViewCache::WriteBatch(const std::unique_ptr<libmw::IDBBatch>&, const CoinsViewUpdates& updates, const mw::Header::CPtr& pHeader)
 {
     SetBestHeader(pHeader);
+    m_pUpdates->GetAggregateChanges().Append(updates.GetAggregateChanges());
+    m_pAggregates = nullptr;
 
     for (const auto& actions : updates.GetActions()) {
         const Commitment& commitment = actions.first;
@@ -174,8 +294,78 @@ void CoinsViewCache::WriteBatch(const std::unique_ptr<libmw::IDBBatch>&, const C
     }
 }
 
+size_t CoinsViewCache::GetMemoryUsage() const noexcept
+{
+    size_t usage = m_pUpdates->GetMemoryUsage()
+        + m_pLeafSet->GetMemoryUsage()
+        + m_pKernelMMR->GetMemoryUsage()
+        + m_pOutputPMMR->GetMemoryUsage()
+        + m_pRangeProofPMMR->GetMemoryUsage();
+    for (const auto& pPendingFlush : m_pendingFlushes) {
+        usage += pPendingFlush->pUpdates->GetMemoryUsage();
+    }
+
+    return usage;
+}
+
+mw::StateAggregates::CPtr CoinsViewCache::GetAggregates() const
+{
+    if (m_pAggregates != nullptr) {
+        return m_pAggregates;
+    }
+
+    mw::StateAggregates::Changes changes;
+    mw::StateAggregates::CPtr pBaseAggregates;
+    {
+        // Like UTXOs, changes that are being flushed must be applied on top of the base until they've been written to it.
+        std::shared_lock<std::shared_mutex> lock(m_flushMutex);
+        pBaseAggregates = m_pBase->GetAggregates();
+        for (const auto& pPendingFlush : m_pendingFlushes) {
+            if (!pPendingFlush->updatesWritten) {
+                changes.Append(pPendingFlush->pUpdates->GetAggregateChanges());
+            }
+        }
+    }
+
+    if (pBaseAggregates == nullptr) {
+        return nullptr;
+    }
+
+    changes.Append(m_pUpdates->GetAggregateChanges());
+
+    const mw::Hash header_hash = GetBestHeader() != nullptr ? GetBestHeader()->GetHash() : ZERO_HASH;
+    m_pAggregates = std::make_shared<mw::StateAggregates>(pBaseAggregates->Apply(header_hash, changes));
+    return m_pAggregates;
+}
+
+uint64_t CoinsViewCache::GetPeggedSupply() const
+{
+    if (m_pAggregates != nullptr) {
+        return m_pAggregates->GetPeggedSupply();
+    }
+
+    mw::StateAggregates::Changes changes;
+    uint64_t supply = 0;
+    {
+        std::shared_lock<std::shared_mutex> lock(m_flushMutex);
+        supply = m_pBase->GetPeggedSupply();
+        for (const auto& pPendingFlush : m_pendingFlushes) {
+            if (!pPendingFlush->updatesWritten) {
+                const mw::StateAggregates::Changes& pending = pPendingFlush->pUpdates->GetAggregateChanges();
+                changes.supplyAdded += pending.supplyAdded;
+                changes.supplyRemoved += pending.supplyRemoved;
+            }
+        }
+    }
+
+    const mw::StateAggregates::Changes& own = m_pUpdates->GetAggregateChanges();
+    return supply + changes.supplyAdded + own.supplyAdded - changes.supplyRemoved - own.supplyRemoved;
+}
+
 void CoinsViewCache::Flush(const std::unique_ptr<libmw::IDBBatch>& pBatch)
 {
+    WaitForFlush();
+
     m_pBase->WriteBatch(pBatch, *m_pUpdates, GetBestHeader());
 
     m_pLeafSet->Flush();
@@ -185,4 +375,97 @@ void CoinsViewCache::Flush(const std::unique_ptr<libmw::IDBBatch>& pBatch)
     m_pUpdates->Clear();
 }
 
+void CoinsViewCache::FlushAsync()
+{
+    if (dynamic_cast<CoinsViewDB*>(m_pBase.get()) == nullptr) {
+        Flush(nullptr);
+        return;
+    }
+
+    if (m_flushFailed || m_pFlushError != nullptr) {
+        WaitForFlush(); // Rethrows the error.
+    }
+
+    ReleaseCompletedFlushes();
+
+    auto pPendingFlush = std::make_shared<PendingFlush>();
+    pPendingFlush->pUpdates = m_pUpdates;
+    pPendingFlush->pHeader = GetBestHeader();
+    pPendingFlush->pLeafSet = m_pLeafSet->TakeSnapshot();
+    pPendingFlush->pKernelMMR = m_pKernelMMR->TakeSnapshot();
+    pPendingFlush->pOutputPMMR = m_pOutputPMMR->TakeSnapshot();
+    pPendingFlush->pRangeProofPMMR = m_pRangeProofPMMR->TakeSnapshot();
+    pPendingFlush->updatesWritten = false;
+    pPendingFlush->complete = false;
+    m_pendingFlushes.push_back(pPendingFlush);
+
+    m_pUpdates = std::make_shared<CoinsViewUpdates>();
+
+    if (m_pFlushQueue == nullptr) {
+        // Allows 1 flush to wait while another is being written, before FlushAsync starts blocking.
+        m_pFlushQueue = TaskQueue::Create(1);
+    }
+
+    m_pFlushQueue->Enqueue([this, pPendingFlush]() {
+        // Nothing is written on top of a failed flush. Its updates stay pending, so reads remain consistent.
+        if (m_flushFailed) {
+            return;
+        }
+
+        try
+        {
+            {
+                std::unique_lock<std::shared_mutex> lock(m_flushMutex);
+                m_pBase->WriteBatch(nullptr, *pPendingFlush->pUpdates, pPendingFlush->pHeader);
+                pPendingFlush->updatesWritten = true;
+            }
+
+            m_pLeafSet->WriteSnapshot(*pPendingFlush->pLeafSet);
+            m_pKernelMMR->WriteSnapshot(*pPendingFlush->pKernelMMR);
+            m_pOutputPMMR->WriteSnapshot(*pPendingFlush->pOutputPMMR);
+            m_pRangeProofPMMR->WriteSnapshot(*pPendingFlush->pRangeProofPMMR);
+            pPendingFlush->complete = true;
+        }
+        catch (...)
+        {
+            m_flushFailed = true;
+            throw;
+        }
+    });
+}
+
+void CoinsViewCache::WaitForFlush()
+{
+    if (m_pFlushQueue != nullptr) {
+        try
+        {
+            m_pFlushQueue->Wait();
+        }
+        catch (...)
+        {
+            // TaskQueue only rethrows an error once, so it's kept here for every later call.
+            if (m_pFlushError == nullptr) {
+                m_pFlushError = std::current_exception();
+            }
+        }
+
+        ReleaseCompletedFlushes();
+    }
+
+    if (m_pFlushError != nullptr) {
+        std::rethrow_exception(m_pFlushError);
+    }
+}
+
+void CoinsViewCache::ReleaseCompletedFlushes()
+{
+    while (!m_pendingFlushes.empty() && m_pendingFlushes.front()->complete) {
+        m_pLeafSet->ReleaseSnapshot();
+        m_pKernelMMR->ReleaseSnapshot();
+        m_pOutputPMMR->ReleaseSnapshot();
+        m_pRangeProofPMMR->ReleaseSnapshot();
+        m_pendingFlushes.pop_front();
+    }
+}
+
 END_NAMESPACE
\ No newline at end of file
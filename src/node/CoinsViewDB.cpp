@@ -35,15 +35,11 @@ void CoinsViewDB::AddUTXO(CoinDB& coinDB, const Output& output)
 
     m_pLeafSet->Add(leafIdx);
 
-    AddUTXO(coinDB, std::make_shared<UTXO>(GetBestHeader()->GetHeight(), std::move(leafIdx), output));
+    AddUTXO(coinDB, ObjectPool::MakeShared<UTXO>(GetBestHeader()->GetHeight(), std::move(leafIdx), output));
 }
 
 void CoinsViewDB::AddUTXO(CoinDB& coinDB, const UTXO::CPtr& pUTXO)
 {
-    const Commitment& commitment = pUTXO->GetOutput().GetCommitment();
-    std::vector<UTXO::CPtr> utxos = GetUTXOs(coinDB, commitment);
-    utxos.push_back(pUTXO);
-
     coinDB.AddUTXOs(std::vector<UTXO::CPtr>{ pUTXO });
 }
 
@@ -60,10 +56,24 @@ void CoinsViewDB::SpendUTXO(CoinDB& coinDB, const Commitment& commitment)
 
 void CoinsViewDB::WriteBatch(const std::unique_ptr<libmw::IDBBatch>& pBatch, const CoinsViewUpdates& updates, const mw::Header::CPtr& pHeader)
 {
-    assert(pBatch != nullptr);
-    SetBestHeader(pHeader);
+    if (pBatch == nullptr) {
+        // No batch was supplied, so write the updates in a batch of our own.
+        auto pOwnBatch = m_pDatabase->CreateBatch();
+        WriteBatch(pOwnBatch, updates, pHeader);
+        pOwnBatch->Commit();
+        return;
+    }
 
     CoinDB coinDB(m_pDatabase.get(), pBatch.get());
+    if (HasAggregates()) {
+        const mw::Hash header_hash = pHeader != nullptr ? pHeader->GetHash() : ZERO_HASH;
+        auto pAggregates = std::make_shared<mw::StateAggregates>(GetAggregates()->Apply(header_hash, updates.GetAggregateChanges()));
+        coinDB.WriteAggregates(pAggregates);
+        SetAggregates(pAggregates);
+    }
+
+    SetBestHeader(pHeader);
+
     for (const auto& actions : updates.GetActions()) {
         const Commitment& commitment = actions.first;
         for (const auto& action : actions.second) {
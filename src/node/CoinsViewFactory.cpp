@@ -5,9 +5,10 @@
 #include <mw/crypto/Schnorr.h>
 #include <mw/consensus/BlockSumValidator.h>
 #include <mw/db/CoinDB.h>
+#include <mw/util/ParallelUtil.h>
 
 static const size_t KERNEL_BATCH_SIZE = 512;
-static const size_t PROOF_BATCH_SIZE = 512;
+static const size_t PROOF_BATCH_SIZE = 512; // Per core. Each batch is split across all cores when verifying.
 
 mw::CoinsViewDB::Ptr CoinsViewFactory::CreateDBView(
 	const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper,
@@ -52,16 +53,15 @@ mw::CoinsViewDB::Ptr CoinsViewFactory::CreateDBView(
 	);
 
 	// Block sum validation
-	BlockSumValidator::ValidateState(
-		utxos,
-		kernels,
-		pStateHeader->GetOffset()
+	auto pAggregates = std::make_shared<mw::StateAggregates>(
+		BlockSumValidator::ValidateState(pStateHeader, utxos, kernels)
 	);
 
 	// Add UTXOs to database
 	auto pBatch = pDBWrapper->CreateBatch();
 	CoinDB coinDB(pDBWrapper.get(), pBatch.get());
 	coinDB.AddUTXOs(utxos);
+	coinDB.WriteAggregates(pAggregates);
 	pBatch->Commit();
 
 	return std::make_shared<mw::CoinsViewDB>(
@@ -70,10 +70,26 @@ mw::CoinsViewDB::Ptr CoinsViewFactory::CreateDBView(
 		pLeafSet,
 		pKernelMMR,
 		pOutputMMR,
-		pRangeProofMMR
+		pRangeProofMMR,
+		pAggregates
 	);
 }
 
+std::shared_ptr<mmr::FileBackend> CoinsViewFactory::OpenRangeProofBackend(const FilePath& path)
+{
+	// Each leaf is a RangeProof, serialized as its 8-byte length followed by the proof.
+	mmr::FileBackend::RebuildPositionFile(path, [](const uint8_t* pData, const size_t available) -> size_t {
+		if (available < sizeof(uint64_t)) {
+			return 0;
+		}
+
+		const uint64_t proof_size = EndianUtil::ReadBE64(pData);
+		return proof_size <= RangeProof::MAX_SIZE ? sizeof(uint64_t) + (size_t)proof_size : 0;
+	});
+
+	return mmr::FileBackend::Open(path, boost::none);
+}
+
 // TODO: Also validate peg-in/peg-out transactions
 mmr::MMR::Ptr CoinsViewFactory::BuildAndValidateKernelMMR(
 	const mw::IBlockStore& blockStore,
@@ -91,7 +107,7 @@ mmr::MMR::Ptr CoinsViewFactory::BuildAndValidateKernelMMR(
 	uint64_t kernels_added = 0;
     for (const Kernel& kernel : kernels)
     {
-        pMMR->Add(kernel);
+        pMMR->Add(kernel.GetSerialized());
 		++kernels_added;
 
         // We have to loop here because some blocks may not have any new kernels.
@@ -180,9 +196,10 @@ mmr::MMR::Ptr CoinsViewFactory::BuildAndValidateRangeProofMMR(
 	const std::vector<UTXO::CPtr>& utxos)
 {
 	auto mmrPath = chainDir.GetChild("rangeproofs");
-	auto pBackend = mmr::FileBackend::Open(mmrPath, boost::optional<uint16_t>(RangeProof::MAX_SIZE));
+	auto pBackend = OpenRangeProofBackend(mmrPath);
 	mmr::MMR::Ptr pMMR = std::make_shared<mmr::MMR>(pBackend);
 
+	const size_t proof_batch_size = PROOF_BATCH_SIZE * ParallelUtil::NumThreads(SIZE_MAX, 1);
 	std::vector<std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>> proofs;
 
 	// TODO: Need parent hashes
@@ -191,7 +208,7 @@ mmr::MMR::Ptr CoinsViewFactory::BuildAndValidateRangeProofMMR(
 		pBackend->AddLeaf(mmr::Leaf::Create(pUTXO->GetLeafIndex(), pUTXO->GetRangeProof()->Serialized()));
 
 		proofs.push_back({ pUTXO->GetCommitment(), pUTXO->GetRangeProof(), pUTXO->GetExtraData() });
-		if (proofs.size() >= PROOF_BATCH_SIZE) {
+		if (proofs.size() >= proof_batch_size) {
 			if (!Crypto::VerifyRangeProofs(proofs)) {
 				ThrowValidation(EConsensusError::BULLETPROOF);
 			}
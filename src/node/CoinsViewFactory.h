@@ -5,6 +5,7 @@
 #include <mw/models/tx/UTXO.h>
 #include <mw/file/FilePath.h>
 #include <mw/mmr/MMR.h>
+#include <mw/mmr/backends/FileBackend.h>
 #include <mw/db/IBlockStore.h>
 #include <libmw/interfaces.h>
 #include <functional>
@@ -22,6 +23,13 @@ public:
         const std::vector<Kernel>& kernels
     );
 
+    //
+    // Opens the rangeproof MMR's backend, whose leaves are serialized rangeproofs of varying length.
+    // Older versions opened it as fixed-length, without a position file, so one is rebuilt from the data file if it's missing.
+    // Throws a FileException if that fails, in which case the chain directory must be deleted and resynced.
+    //
+    static std::shared_ptr<mmr::FileBackend> OpenRangeProofBackend(const FilePath& path);
+
 private:
     static mmr::MMR::Ptr BuildAndValidateKernelMMR(
         const mw::IBlockStore& blockStore,
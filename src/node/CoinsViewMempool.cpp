@@ -0,0 +1,160 @@
+#include <mw/node/CoinsView.h>
+#include <mw/exceptions/ValidationException.h>
+#include <mw/exceptions/UnimplementedException.h>
+#include <mw/common/Logger.h>
+
+#include <unordered_set>
+
+MW_NAMESPACE
+
+std::vector<UTXO::CPtr> CoinsViewMempool::GetUTXOs(const Commitment& commitment) const
+{
+    std::vector<UTXO::CPtr> utxos = m_pBase->GetUTXOs(commitment);
+
+    auto created_iter = m_createdBy.find(commitment);
+    if (created_iter != m_createdBy.cend()) {
+        utxos.push_back(created_iter->second.pUTXO);
+    }
+
+    if (m_spentBy.find(commitment) != m_spentBy.cend()) {
+        assert(!utxos.empty());
+        utxos.pop_back();
+    }
+
+    return utxos;
+}
+
+void CoinsViewMempool::WriteBatch(const libmw::IDBBatch::UPtr&, const CoinsViewUpdates&, const mw::Header::CPtr&)
+{
+    ThrowUnimplemented("CoinsViewMempool can't be flushed to");
+}
+
+void CoinsViewMempool::AddTransaction(const mw::Transaction::CPtr& pTransaction)
+{
+    assert(pTransaction != nullptr);
+
+    const mw::Hash& txHash = pTransaction->GetHash();
+    if (HasTransaction(txHash)) {
+        return;
+    }
+
+    // Check everything before modifying any of the indexes, so a failure leaves the mempool untouched.
+    std::unordered_set<Commitment> inputs;
+    for (const Input& input : pTransaction->GetInputs()) {
+        const Commitment& commitment = input.GetCommitment();
+        if (!inputs.insert(commitment).second || m_spentBy.find(commitment) != m_spentBy.cend()) {
+            ThrowValidation(EConsensusError::DOUBLE_SPEND);
+        }
+
+        if (m_createdBy.find(commitment) == m_createdBy.cend() && m_pBase->GetUTXOs(commitment).empty()) {
+            ThrowValidation(EConsensusError::UTXO_MISSING);
+        }
+    }
+
+    for (const Output& output : pTransaction->GetOutputs()) {
+        if (m_createdBy.find(output.GetCommitment()) != m_createdBy.cend()) {
+            ThrowValidation(EConsensusError::DOUBLE_SPEND);
+        }
+    }
+
+    for (const Input& input : pTransaction->GetInputs()) {
+        m_spentBy.insert({ input.GetCommitment(), txHash });
+    }
+
+    for (const Output& output : pTransaction->GetOutputs()) {
+        auto pUTXO = ObjectPool::MakeShared<UTXO>(UNCONFIRMED_HEIGHT, mmr::LeafIndex(), output);
+        m_createdBy.insert({ output.GetCommitment(), CreatedOutput{ txHash, pUTXO } });
+    }
+
+    for (const Kernel& kernel : pTransaction->GetKernels()) {
+        m_kernels.insert({ kernel.GetHash(), txHash });
+    }
+
+    m_transactions.insert({ txHash, pTransaction });
+}
+
+std::vector<mw::Transaction::CPtr> CoinsViewMempool::RemoveTransaction(const mw::Hash& txHash)
+{
+    std::vector<mw::Transaction::CPtr> removed;
+    RemoveTransaction(txHash, true, removed);
+    return removed;
+}
+
+std::vector<mw::Transaction::CPtr> CoinsViewMempool::RemoveForBlock(const mw::Block::CPtr& pBlock)
+{
+    assert(pBlock != nullptr);
+    SetBestHeader(pBlock->GetHeader());
+
+    std::vector<mw::Transaction::CPtr> removed;
+
+    // Transactions whose kernels were included are confirmed. Their outputs are now in the base,
+    // so any unconfirmed transactions spending them remain valid.
+    for (const Kernel& kernel : pBlock->GetKernels()) {
+        auto iter = m_kernels.find(kernel.GetHash());
+        if (iter != m_kernels.cend()) {
+            RemoveTransaction(mw::Hash(iter->second), false, removed);
+        }
+    }
+
+    // Any remaining transactions spending the block's inputs conflict with it, so their outputs will never exist.
+    for (const Input& input : pBlock->GetInputs()) {
+        auto iter = m_spentBy.find(input.GetCommitment());
+        if (iter != m_spentBy.cend()) {
+            RemoveTransaction(mw::Hash(iter->second), true, removed);
+        }
+    }
+
+    LOG_DEBUG_F("Removed {} transactions for block {}", removed.size(), pBlock);
+    return removed;
+}
+
+std::vector<mw::Transaction::CPtr> CoinsViewMempool::GetTransactions() const
+{
+    std::vector<mw::Transaction::CPtr> transactions;
+    transactions.reserve(m_transactions.size());
+    for (const auto& entry : m_transactions) {
+        transactions.push_back(entry.second);
+    }
+
+    return transactions;
+}
+
+void CoinsViewMempool::RemoveTransaction(const mw::Hash& txHash, const bool removeDescendants, std::vector<mw::Transaction::CPtr>& removed)
+{
+    // Descendant chains can be arbitrarily long, so they're walked with a worklist rather than by recursing.
+    std::vector<mw::Hash> toRemove{ txHash };
+    while (!toRemove.empty()) {
+        auto tx_iter = m_transactions.find(toRemove.back());
+        toRemove.pop_back();
+        if (tx_iter == m_transactions.end()) {
+            continue;
+        }
+
+        mw::Transaction::CPtr pTransaction = tx_iter->second;
+        m_transactions.erase(tx_iter);
+        removed.push_back(pTransaction);
+
+        for (const Input& input : pTransaction->GetInputs()) {
+            m_spentBy.erase(input.GetCommitment());
+        }
+
+        for (const Kernel& kernel : pTransaction->GetKernels()) {
+            m_kernels.erase(kernel.GetHash());
+        }
+
+        // Pushed in reverse, so descendants are removed in the same order the outputs are in.
+        const std::vector<Output>& outputs = pTransaction->GetOutputs();
+        for (auto output_iter = outputs.crbegin(); output_iter != outputs.crend(); output_iter++) {
+            m_createdBy.erase(output_iter->GetCommitment());
+
+            if (removeDescendants) {
+                auto spent_iter = m_spentBy.find(output_iter->GetCommitment());
+                if (spent_iter != m_spentBy.cend()) {
+                    toRemove.push_back(mw::Hash(spent_iter->second));
+                }
+            }
+        }
+    }
+}
+
+END_NAMESPACE
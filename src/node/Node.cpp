@@ -4,18 +4,87 @@
 #include <mw/config/ChainParams.h>
 #include <mw/node/validation/BlockValidator.h>
 #include <mw/consensus/Aggregation.h>
+#include <mw/consensus/BlockSumValidator.h>
+#include <mw/crypto/CommitmentSum.h>
+#include <mw/db/CoinDB.h>
 #include <mw/common/Logger.h>
+#include <mw/exceptions/ConnectBlocksException.h>
+#include <mw/exceptions/NotFoundException.h>
 #include <mw/mmr/MMR.h>
 #include <mw/mmr/backends/FileBackend.h>
 #include <unordered_map>
 
+//
+// Loads the running totals for the best header, and checks that they balance with its total offset.
+// Returns nullptr if there are none for that header, e.g. because the database was written before they were tracked.
+// Throws a ValidationException if they don't balance.
+//
+static mw::StateAggregates::CPtr LoadAggregates(const mw::Header::CPtr& pBestHeader, const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper)
+{
+    if (pBestHeader == nullptr) {
+        return std::make_shared<mw::StateAggregates>();
+    }
+
+    mw::StateAggregates::CPtr pAggregates = CoinDB(pDBWrapper.get()).GetAggregates();
+    if (pAggregates == nullptr || pAggregates->GetHeaderHash() != pBestHeader->GetHash()) {
+        LOG_WARNING_F("No running totals found for {}. Auditing the state to start tracking them.", pBestHeader);
+        return nullptr;
+    }
+
+    BlockSumValidator::ValidateAggregates(*pAggregates, pBestHeader->GetOffset());
+    return pAggregates;
+}
+
+//
+// Re-sums every UTXO in the database and every kernel in the kernel MMR, and checks that they balance.
+// This takes time proportional to the size of the UTXO set. The totals it returns replace any that were saved,
+// and are written with the next flush.
+// Throws a ValidationException if they don't balance.
+//
+static mw::StateAggregates AuditState(
+    const mw::Header::CPtr& pBestHeader,
+    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper,
+    const mmr::MMR::Ptr& pKernelsMMR)
+{
+    LOG_INFO_F("Auditing state at {}", pBestHeader);
+
+    CommitmentSum utxo_sum;
+    CoinDB(pDBWrapper.get()).ForEachUTXO([&utxo_sum](const UTXO& utxo) { utxo_sum.Add(utxo.GetCommitment()); });
+
+    CommitmentSum kernel_sum;
+    uint64_t pegged_supply = 0;
+    for (uint64_t i = 0; i < pBestHeader->GetNumKernels(); i++) {
+        Deserializer deserializer{ pKernelsMMR->GetLeaf(mmr::LeafIndex::At(i)).vec() };
+        Kernel kernel = Kernel::Deserialize(deserializer);
+        kernel_sum.Add(kernel.GetExcess());
+
+        pegged_supply += kernel.GetPeggedIn();
+        if (kernel.GetPeggedOut() > pegged_supply) {
+            ThrowValidation(EConsensusError::BLOCK_SUMS);
+        }
+
+        pegged_supply -= kernel.GetPeggedOut();
+    }
+
+    mw::StateAggregates aggregates(pBestHeader->GetHash(), utxo_sum.Total(), kernel_sum.Total(), pegged_supply);
+    BlockSumValidator::ValidateAggregates(aggregates, pBestHeader->GetOffset());
+
+    mw::StateAggregates::CPtr pSaved = CoinDB(pDBWrapper.get()).GetAggregates();
+    if (pSaved != nullptr && pSaved->GetHeaderHash() == pBestHeader->GetHash() && pSaved->Serialized() != aggregates.Serialized()) {
+        LOG_WARNING_F("Saved running totals for {} don't match the audited state. Replacing them.", pBestHeader);
+    }
+
+    return aggregates;
+}
+
 MW_NAMESPACE
 
 mw::INode::Ptr InitializeNode(
     const FilePath& datadir,
     const std::string& hrp,
     const mw::Header::CPtr& pBestHeader,
-    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper)
+    const std::shared_ptr<libmw::IDBWrapper>& pDBWrapper,
+    const bool auditState)
 {
     auto pConfig = NodeConfig::Create(datadir, { });
     LoggerAPI::Initialize(pConfig->GetDataDir().GetChild("logs").CreateDirIfMissing(), "DEBUG"); // TODO: Read config
@@ -34,17 +103,27 @@ mw::INode::Ptr InitializeNode(
     mmr::MMR::Ptr pOutputMMR = std::make_shared<mmr::MMR>(pOutputBackend);
 
     auto rangeproof_path = chain_dir.GetChild("proofs").CreateDirIfMissing();
-    auto pRangeProofBackend = mmr::FileBackend::Open(rangeproof_path, boost::optional<uint16_t>(RangeProof::MAX_SIZE));
+    auto pRangeProofBackend = CoinsViewFactory::OpenRangeProofBackend(rangeproof_path);
     mmr::MMR::Ptr pRangeProofMMR = std::make_shared<mmr::MMR>(pRangeProofBackend);
 
-    // TODO: Validate Current State
+    // Databases written before the totals were tracked have none saved, so they're audited once to get them.
+    mw::StateAggregates::CPtr pAggregates = nullptr;
+    if (!auditState || pBestHeader == nullptr) {
+        pAggregates = LoadAggregates(pBestHeader, pDBWrapper);
+    }
+
+    if (pAggregates == nullptr) {
+        pAggregates = std::make_shared<mw::StateAggregates>(AuditState(pBestHeader, pDBWrapper, pKernelsMMR));
+    }
+
     mw::CoinsViewDB::Ptr pDBView = std::make_shared<mw::CoinsViewDB>(
         pBestHeader,
         pDBWrapper,
         pLeafSet,
         pKernelsMMR,
         pOutputMMR,
-        pRangeProofMMR
+        pRangeProofMMR,
+        pAggregates
     );
 
     return std::shared_ptr<mw::INode>(new Node(pConfig, pDBView));
@@ -78,6 +157,56 @@ mw::BlockUndo::CPtr Node::ConnectBlock(const mw::Block::Ptr& pBlock, const mw::I
     return pUndo;
 }
 
+std::vector<mw::BlockUndo::CPtr> Node::ConnectBlocks(
+    const std::vector<mw::Block::Ptr>& blocks,
+    const mw::ICoinsView::Ptr& pView,
+    const size_t maxCacheBytes)
+{
+    LOG_TRACE_F("Connecting {} blocks", blocks.size());
+
+    std::vector<mw::BlockUndo::CPtr> undos;
+    undos.reserve(blocks.size());
+
+    // The number of blocks already flushed to pView.
+    size_t num_flushed = 0;
+
+    mw::CoinsViewCache::Ptr pCache = std::make_shared<mw::CoinsViewCache>(pView);
+    for (const mw::Block::Ptr& pBlock : blocks) {
+        LOG_TRACE_F("Connecting block {}", pBlock);
+        try
+        {
+            undos.push_back(pCache->ApplyBlock(pBlock));
+        }
+        catch (const std::exception& e)
+        {
+            LOG_ERROR_F("Failed to connect block {}: {}", pBlock, e.what());
+
+            // The cache may hold part of the failed block, so it's discarded, and the blocks applied
+            // since the last flush are applied again without it. That way, every block before the failed one
+            // is connected, and the caller gets all of their undos.
+            const size_t failed_index = undos.size();
+            undos.resize(num_flushed);
+            mw::CoinsViewCache::Ptr pRetryCache = std::make_shared<mw::CoinsViewCache>(pView);
+            for (size_t i = num_flushed; i < failed_index; i++) {
+                undos.push_back(pRetryCache->ApplyBlock(blocks[i]));
+            }
+
+            pRetryCache->Flush(nullptr);
+            throw ConnectBlocksException(e.what(), __FUNCTION__, std::move(undos), std::current_exception());
+        }
+
+        if (maxCacheBytes > 0 && pCache->GetMemoryUsage() > maxCacheBytes) {
+            LOG_DEBUG_F("Cache is using {} bytes. Flushing after block {}", pCache->GetMemoryUsage(), pBlock);
+            pCache->Flush(nullptr);
+            num_flushed = undos.size();
+        }
+    }
+
+    pCache->Flush(nullptr);
+
+    return undos;
+}
+
 void Node::DisconnectBlock(const mw::BlockUndo::CPtr& pUndoData, const mw::ICoinsView::Ptr& pView)
 {
     LOG_TRACE_F("Disconnecting block {}", pView->GetBestHeader());
@@ -87,6 +216,89 @@ void Node::DisconnectBlock(const mw::BlockUndo::CPtr& pUndoData, const mw::ICoin
     pCache->Flush(nullptr);
 }
 
+void Node::DisconnectBlocks(const std::vector<mw::BlockUndo::CPtr>& undos, const mw::ICoinsView::Ptr& pView)
+{
+    LOG_TRACE_F("Disconnecting {} blocks from {}", undos.size(), pView->GetBestHeader());
+
+    mw::CoinsViewCache::Ptr pCache = std::make_shared<mw::CoinsViewCache>(pView);
+    pCache->UndoBlocks(undos);
+    pCache->Flush(nullptr);
+}
+
+mw::BlockUndo::CPtr Node::ExpandUndo(
+    const mw::CompactBlockUndo::CPtr& pCompactUndo,
+    const mw::ICoinsView::Ptr& pView,
+    const mw::IBlockStore* pBlockStore) const
+{
+    assert(pCompactUndo != nullptr);
+
+    std::vector<UTXO> coinsSpent;
+    coinsSpent.reserve(pCompactUndo->GetCoinsSpent().size());
+    for (const mw::SpentCoinRef& coin : pCompactUndo->GetCoinsSpent()) {
+        boost::optional<Output> output = ReadOutputFromMMRs(coin, pView);
+        if (!output.has_value()) {
+            LOG_DEBUG_F("Output {} not available in MMRs. Looking it up in block {}", coin.GetCommitment(), coin.GetBlockHeight());
+            output = ReadOutputFromBlock(coin, pBlockStore);
+        }
+
+        coinsSpent.push_back(UTXO{ coin.GetBlockHeight(), mmr::LeafIndex(coin.GetLeafIndex()), std::move(output.value()) });
+    }
+
+    std::vector<Commitment> coinsAdded = pCompactUndo->GetCoinsAdded();
+    return std::make_shared<mw::BlockUndo>(pCompactUndo->GetPreviousHeader(), std::move(coinsSpent), std::move(coinsAdded));
+}
+
+boost::optional<Output> Node::ReadOutputFromMMRs(const mw::SpentCoinRef& coin, const mw::ICoinsView::Ptr& pView)
+{
+    try
+    {
+        // The leaf hashes commit to the data, so comparing them to the MMR's hashes
+        // detects leaves that have been pruned or overwritten.
+        mmr::Leaf outputLeaf = pView->GetOutputPMMR()->GetLeaf(coin.GetLeafIndex());
+        mmr::Leaf proofLeaf = pView->GetRangeProofPMMR()->GetLeaf(coin.GetLeafIndex());
+        if (outputLeaf.GetHash() != pView->GetOutputPMMR()->GetHash(outputLeaf.GetNodeIndex())
+            || proofLeaf.GetHash() != pView->GetRangeProofPMMR()->GetHash(proofLeaf.GetNodeIndex())) {
+            return boost::none;
+        }
+
+        Deserializer outputDeserializer{ outputLeaf.vec() };
+        OutputId outputId = OutputId::Deserialize(outputDeserializer);
+        if (outputId.GetCommitment() != coin.GetCommitment()) {
+            return boost::none;
+        }
+
+        Deserializer proofDeserializer{ proofLeaf.vec() };
+        auto pProof = ObjectPool::MakeShared<const RangeProof>(RangeProof::Deserialize(proofDeserializer));
+
+        return Output(
+            outputId.GetFeatures(),
+            Commitment(outputId.GetCommitment()),
+            std::vector<uint8_t>(coin.GetExtraData()),
+            pProof
+        );
+    }
+    catch (std::exception& e)
+    {
+        LOG_DEBUG_F("Failed to read leaf {}: {}", coin.GetLeafIndex().GetLeafIndex(), e.what());
+    }
+
+    return boost::none;
+}
+
+Output Node::ReadOutputFromBlock(const mw::SpentCoinRef& coin, const mw::IBlockStore* pBlockStore)
+{
+    if (pBlockStore != nullptr) {
+        mw::Block::CPtr pBlock = pBlockStore->GetBlock(coin.GetBlockHeight());
+        for (const Output& output : pBlock->GetOutputs()) {
+            if (output.GetCommitment() == coin.GetCommitment()) {
+                return output;
+            }
+        }
+    }
+
+    ThrowNotFound_F("Spent output {} not found", coin.GetCommitment());
+}
+
 mw::ICoinsView::Ptr Node::ApplyState(
     const libmw::IDBWrapper::Ptr& pDBWrapper,
     const mw::IBlockStore& blockStore,
@@ -2,6 +2,7 @@
 
 #include <mw/node/INode.h>
 #include <mw/common/Lock.h>
+#include <boost/optional.hpp>
 
 class Node : public mw::INode
 {
@@ -19,7 +20,18 @@ public:
     ) const final;
 
     mw::BlockUndo::CPtr ConnectBlock(const mw::Block::Ptr& pBlock, const mw::ICoinsView::Ptr& pView) final;
+    std::vector<mw::BlockUndo::CPtr> ConnectBlocks(
+        const std::vector<mw::Block::Ptr>& blocks,
+        const mw::ICoinsView::Ptr& pView,
+        const size_t maxCacheBytes
+    ) final;
     void DisconnectBlock(const mw::BlockUndo::CPtr& pUndoData, const mw::ICoinsView::Ptr& pView) final;
+    void DisconnectBlocks(const std::vector<mw::BlockUndo::CPtr>& undos, const mw::ICoinsView::Ptr& pView) final;
+    mw::BlockUndo::CPtr ExpandUndo(
+        const mw::CompactBlockUndo::CPtr& pCompactUndo,
+        const mw::ICoinsView::Ptr& pView,
+        const mw::IBlockStore* pBlockStore
+    ) const final;
 
     mw::ICoinsView::Ptr ApplyState(
         const libmw::IDBWrapper::Ptr& pDBWrapper,
@@ -31,6 +43,9 @@ public:
     ) final;
 
 private:
+    static boost::optional<Output> ReadOutputFromMMRs(const mw::SpentCoinRef& coin, const mw::ICoinsView::Ptr& pView);
+    static Output ReadOutputFromBlock(const mw::SpentCoinRef& coin, const mw::IBlockStore* pBlockStore);
+
     NodeConfig ::Ptr m_pConfig;
     mw::CoinsViewDB::Ptr m_pDBView;
 };
\ No newline at end of file
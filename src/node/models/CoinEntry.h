@@ -42,9 +42,8 @@ struct CoinEntry
         for (size_t i = 0; i < numUTXOs; i++) {
             std::vector<uint8_t> serialized;
             s >> serialized;
-            Deserializer deserializer{std::move(serialized)};
-            UTXO utxo = UTXO::Deserialize(deserializer);
-            utxos.push_back(std::make_shared<UTXO>(std::move(utxo)));
+            Deserializer deserializer{ serialized.data(), serialized.size() };
+            utxos.push_back(ObjectPool::MakeShared<UTXO>(UTXO::Deserialize(deserializer)));
         }
     }
 };
\ No newline at end of file
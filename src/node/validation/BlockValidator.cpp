@@ -1,5 +1,12 @@
 #include <mw/node/validation/BlockValidator.h>
 #include <mw/exceptions/ValidationException.h>
+#include <mw/consensus/CutThrough.h>
+#include <mw/crypto/VerificationCache.h>
+#include <mw/common/Logger.h>
+
+#include <atomic>
+#include <functional>
+#include <mutex>
 #include <unordered_map>
 
 void BlockValidator::Validate(
@@ -9,16 +16,66 @@ void BlockValidator::Validate(
 {
     assert(pBlock != nullptr);
 
-    if (pBlock->WasValidated()) {
-        return;
+    std::vector<std::pair<std::string, std::function<void()>>> stages;
+
+    // The header, weight and pegs are checked even for blocks that were already validated.
+    // Blocks built from validated transactions haven't been checked against the pegs,
+    // and each transaction only had to be within the weight limit on its own.
+    pBlock->GetHeader()->Validate();
+    stages.push_back({ "weight", [pBlock]() { pBlock->GetTxBody().ValidateWeight(); } });
+
+    const bool validate_body = !pBlock->WasValidated();
+    if (validate_body) {
+        stages.push_back({ "cut-through", [pBlock]() {
+            CutThrough::VerifyCutThrough(pBlock->GetInputs(), pBlock->GetOutputs());
+        } });
+        stages.push_back({ "kernel signatures", [pBlock]() { pBlock->GetTxBody().VerifyKernelSignatures(); } });
+        stages.push_back({ "rangeproofs", [pBlock]() { pBlock->GetTxBody().VerifyRangeProofs(); } });
     }
 
-    pBlock->Validate();
+    stages.push_back({ "peg-ins", [pBlock, pegInCoins]() { ValidatePegInCoins(pBlock, pegInCoins); } });
+    stages.push_back({ "peg-outs", [pBlock, pegOutCoins]() { ValidatePegOutCoins(pBlock, pegOutCoins); } });
+
+    // Once a stage fails, the stages that haven't started yet are skipped.
+    std::atomic_bool failed{ false };
+    std::mutex timings_mutex;
+    Timings timings;
+
+    // The calling thread runs stages too, so this can't deadlock even when called from one of the pool's threads.
+    m_pool.ForEach(stages.size(), [&stages, &failed, &timings_mutex, &timings](const size_t i) {
+        if (failed) {
+            return;
+        }
+
+        auto start = std::chrono::steady_clock::now();
+        try
+        {
+            stages[i].second();
+        }
+        catch (...)
+        {
+            failed = true;
+            throw;
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        std::unique_lock<std::mutex> lock(timings_mutex);
+        timings.push_back({ stages[i].first, elapsed });
+    });
+
+    m_timings = std::move(timings);
 
-    ValidatePegInCoins(pBlock, pegInCoins);
-    ValidatePegOutCoins(pBlock, pegOutCoins);
+    if (validate_body) {
+        pBlock->MarkAsValidated();
 
-    pBlock->MarkAsValidated();
+        // Signatures and rangeproofs of transactions already verified for the mempool are found in the caches.
+        LOG_TRACE_F(
+            "Block {} validated. Cache hit rates: signatures {}, rangeproofs {}",
+            pBlock,
+            VerificationCache::GetSignatureCache().GetStats().GetHitRate(),
+            VerificationCache::GetRangeProofCache().GetStats().GetHitRate()
+        );
+    }
 }
 
 void BlockValidator::ValidatePegInCoins(
@@ -5,8 +5,15 @@ namespace Traits
 {
     std::vector<uint8_t> ISerializable::Serialized() const noexcept
     {
-        Serializer serializer;
+        Serializer serializer(GetSerializedSize());
         Serialize(serializer);
-        return serializer.vec();
+        return std::move(serializer).vec();
+    }
+
+    size_t ISerializable::GetSerializedSize() const noexcept
+    {
+        Serializer serializer = Serializer::SizeOnly();
+        Serialize(serializer);
+        return serializer.size();
     }
 }
\ No newline at end of file
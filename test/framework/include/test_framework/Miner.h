@@ -82,7 +82,7 @@ private:
 
         auto mmr = mmr::MMR(std::make_shared<mmr::VectorBackend>());
         for (const Kernel& kernel : kernels) {
-            mmr.Add(kernel.Serialized());
+            mmr.Add(kernel.GetSerialized());
         }
 
         return mmr;
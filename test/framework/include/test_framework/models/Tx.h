@@ -19,6 +19,7 @@ public:
         std::vector<Input> inputs;
         std::vector<Output> outputs;
         std::vector<Kernel> kernels;
+        std::vector<test::TxOutput> txOutputs;
 
         Builder& SetOffset(const BlindingFactor& offsetIn)
         {
@@ -35,6 +36,7 @@ public:
         Builder& AddOutput(const test::TxOutput& output)
         {
             outputs.push_back(output.GetOutput());
+            txOutputs.push_back(output);
             return *this;
         }
 
@@ -47,13 +49,14 @@ public:
         Tx Build() const
         {
             return Tx(
-                std::make_shared<mw::Transaction>(BlindingFactor(offset), TxBody(inputs, outputs, kernels))
+                std::make_shared<mw::Transaction>(BlindingFactor(offset), TxBody(inputs, outputs, kernels)),
+                txOutputs
             );
         }
     };
 
-    Tx(const mw::Transaction::CPtr& pTransaction)
-        : m_pTransaction(pTransaction) { }
+    Tx(const mw::Transaction::CPtr& pTransaction, const std::vector<TxOutput>& txOutputs = {})
+        : m_pTransaction(pTransaction), m_txOutputs(txOutputs) { }
 
     static Tx CreatePegIn(const uint64_t amount)
     {
@@ -79,8 +82,48 @@ public:
         return Tx::Builder().SetOffset(txOffset).AddKernel(kernel).AddOutput(output).Build();
     }
 
+    //
+    // Creates a transaction spending the given outputs into new outputs with the given amounts.
+    // The output amounts should add up to the amounts being spent.
+    //
+    static Tx CreateSpend(const std::vector<TxOutput>& inputs, const std::vector<uint64_t>& amounts, const uint64_t fee = 0)
+    {
+        BlindingFactor txOffset = Random().CSPRNG<32>();
+
+        Tx::Builder builder;
+        builder.SetOffset(txOffset);
+
+        std::vector<BlindingFactor> inputBFs({ txOffset });
+        for (const TxOutput& input : inputs) {
+            builder.AddInput(Input(input.GetOutput().GetFeatures(), Commitment(input.GetOutput().GetCommitment())));
+            inputBFs.push_back(input.GetBlindingFactor());
+        }
+
+        std::vector<BlindingFactor> outputBFs;
+        for (const uint64_t amount : amounts) {
+            BlindingFactor outputBF = Random().CSPRNG<32>();
+            builder.AddOutput(test::TxOutput::Create(EOutputFeatures::DEFAULT_OUTPUT, outputBF, amount));
+            outputBFs.push_back(outputBF);
+        }
+
+        BlindingFactor kernelBF = Crypto::AddBlindingFactors(outputBFs, inputBFs);
+        Commitment kernelCommit = Crypto::CommitBlinded(0, kernelBF);
+
+        Serializer serializer;
+        serializer.Append<uint8_t>((uint8_t)KernelType::PLAIN_KERNEL);
+        serializer.Append<uint64_t>(fee);
+
+        Signature signature = Crypto::BuildSignature(
+            kernelBF.ToSecretKey(),
+            Hashed(serializer.vec())
+        );
+
+        return builder.AddKernel(Kernel::CreatePlain(fee, std::move(kernelCommit), std::move(signature))).Build();
+    }
+
     const mw::Transaction::CPtr& GetTransaction() const noexcept { return m_pTransaction; }
     const std::vector<Output>& GetOutputs() const noexcept { return m_pTransaction->GetOutputs(); }
+    const std::vector<TxOutput>& GetTxOutputs() const noexcept { return m_txOutputs; }
 
     PegInCoin GetPegInCoin() const
     {
@@ -90,6 +133,7 @@ public:
 
 private:
     mw::Transaction::CPtr m_pTransaction;
+    std::vector<TxOutput> m_txOutputs;
 };
 
 END_NAMESPACE
\ No newline at end of file
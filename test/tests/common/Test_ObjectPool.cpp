@@ -0,0 +1,67 @@
+#include <catch.hpp>
+
+#include <mw/common/ObjectPool.h>
+#include <mw/models/tx/UTXO.h>
+#include <test_framework/models/Tx.h>
+
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+TEST_CASE("ObjectPool")
+{
+    Output output = test::Tx::CreatePegIn(1000).GetTransaction()->GetOutputs().front();
+
+    const ObjectPool::Stats before = ObjectPool::GetThreadStats();
+    {
+        UTXO::CPtr pUTXO = ObjectPool::MakeShared<UTXO>(5, mmr::LeafIndex::At(3), output);
+        REQUIRE(pUTXO->GetBlockHeight() == 5);
+        REQUIRE(pUTXO->GetOutput() == output);
+    }
+
+    // The freed block is reused by the next UTXO.
+    UTXO::CPtr pUTXO = ObjectPool::MakeShared<UTXO>(6, mmr::LeafIndex::At(4), output);
+    const ObjectPool::Stats stats = ObjectPool::GetThreadStats() - before;
+    REQUIRE(stats.GetTotal() == 2);
+    REQUIRE(stats.reused >= 1);
+    REQUIRE(stats.released == 1);
+
+    // Objects can be released on a different thread than the one that created them.
+    std::thread([pUTXO = std::move(pUTXO)]() mutable {
+        pUTXO.reset();
+        REQUIRE(ObjectPool::GetThreadStats().released == 1);
+    }).join();
+}
+
+TEST_CASE("ObjectPool - Throughput", "[.benchmark]")
+{
+    Output output = test::Tx::CreatePegIn(1000).GetTransaction()->GetOutputs().front();
+
+    // Roughly a block's worth of UTXOs, created and released together as blocks are connected.
+    const size_t num_utxos = 10'000;
+    const size_t num_iterations = 100;
+    std::vector<UTXO::CPtr> utxos;
+    utxos.reserve(num_utxos);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < num_utxos; j++) {
+            utxos.push_back(std::make_shared<UTXO>(j, mmr::LeafIndex::At(j), output));
+        }
+
+        utxos.clear();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "std::make_shared<UTXO>: " << num_utxos * num_iterations << " in " << elapsed.count() << "ms" << std::endl;
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        for (size_t j = 0; j < num_utxos; j++) {
+            utxos.push_back(ObjectPool::MakeShared<UTXO>(j, mmr::LeafIndex::At(j), output));
+        }
+
+        utxos.clear();
+    }
+    elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "ObjectPool::MakeShared<UTXO>: " << num_utxos * num_iterations << " in " << elapsed.count() << "ms" << std::endl;
+}
@@ -0,0 +1,45 @@
+#include <catch.hpp>
+
+#include <mw/common/ShardedFifoCache.h>
+
+#include <functional>
+
+TEST_CASE("ShardedFifoCache")
+{
+    // A single shard, so the eviction order is predictable.
+    ShardedFifoCache<uint64_t, int, std::hash<uint64_t>> cache(3, 1);
+
+    int value = 0;
+    REQUIRE_FALSE(cache.Find(1, value));
+
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+    cache.Insert(3, 30);
+    REQUIRE(cache.Find(1, value));
+    REQUIRE(value == 10);
+
+    // Inserting an existing key keeps the original value.
+    cache.Insert(1, 11);
+    REQUIRE(cache.Find(1, value));
+    REQUIRE(value == 10);
+
+    // The oldest entry is evicted first, regardless of when it was last used.
+    cache.Insert(4, 40);
+    REQUIRE_FALSE(cache.Contains(1));
+    REQUIRE(cache.Contains(2));
+    REQUIRE(cache.Contains(4));
+    REQUIRE(cache.GetSize() == 3);
+
+    ShardedFifoCache<uint64_t, int, std::hash<uint64_t>>::Stats stats = cache.GetStats();
+    REQUIRE(stats.insertions == 4);
+    REQUIRE(stats.evictions == 1);
+    REQUIRE(stats.hits == 4);
+    REQUIRE(stats.misses == 2);
+
+    cache.SetCapacity(1);
+    REQUIRE(cache.GetSize() == 1);
+    REQUIRE(cache.Contains(4));
+
+    cache.Clear();
+    REQUIRE(cache.GetSize() == 0);
+}
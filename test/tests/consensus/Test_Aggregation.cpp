@@ -0,0 +1,122 @@
+#include <catch.hpp>
+
+#include <mw/consensus/Aggregation.h>
+#include <mw/crypto/Random.h>
+
+#include <chrono>
+
+static Commitment RandomCommitment()
+{
+    return Commitment(Random::CSPRNG<33>().GetBigInt());
+}
+
+//
+// Builds a transaction with random (invalid) commitments and signatures, for testing aggregation only.
+// Spends the given commitment if one is provided.
+//
+static mw::Transaction CreateTx(const boost::optional<Commitment>& spent, const RangeProof::CPtr& pProof)
+{
+    std::vector<Input> inputs;
+    inputs.push_back(Input(EOutputFeatures::DEFAULT_OUTPUT, spent.has_value() ? Commitment(spent.value()) : RandomCommitment()));
+
+    std::vector<Output> outputs;
+    outputs.push_back(Output(EOutputFeatures::DEFAULT_OUTPUT, RandomCommitment(), std::vector<uint8_t>{}, pProof));
+    outputs.push_back(Output(EOutputFeatures::DEFAULT_OUTPUT, RandomCommitment(), std::vector<uint8_t>{}, pProof));
+
+    std::vector<Kernel> kernels;
+    kernels.push_back(Kernel::CreatePlain(10, RandomCommitment(), Signature(Random::CSPRNG<64>().GetBigInt())));
+
+    return mw::Transaction(
+        BlindingFactor(Random::CSPRNG<32>().GetBigInt()),
+        TxBody(std::move(inputs), std::move(outputs), std::move(kernels))
+    );
+}
+
+//
+// Every other transaction spends the first output of the one before it.
+//
+static std::vector<mw::Transaction> CreateChainedTxs(const size_t num_txs)
+{
+    auto pProof = std::make_shared<const RangeProof>(std::vector<uint8_t>(675, 0));
+
+    std::vector<mw::Transaction> txs;
+    txs.reserve(num_txs);
+    for (size_t i = 0; i < num_txs; i++) {
+        boost::optional<Commitment> spent = boost::none;
+        if (i % 2 == 1) {
+            spent = txs.back().GetOutputs().front().GetCommitment();
+        }
+
+        txs.push_back(CreateTx(spent, pProof));
+    }
+
+    return txs;
+}
+
+static std::vector<mw::Transaction::CPtr> ToPtrs(const std::vector<mw::Transaction>& txs)
+{
+    std::vector<mw::Transaction::CPtr> ptrs;
+    ptrs.reserve(txs.size());
+    for (const mw::Transaction& tx : txs) {
+        ptrs.push_back(std::make_shared<mw::Transaction>(tx));
+    }
+
+    return ptrs;
+}
+
+TEST_CASE("Aggregation")
+{
+    std::vector<mw::Transaction> txs = CreateChainedTxs(100);
+
+    mw::Transaction::CPtr pAggregated = Aggregation::Aggregate(ToPtrs(txs));
+
+    // The spent output and the input spending it are cut through for each of the 50 chained pairs.
+    REQUIRE(pAggregated->GetInputs().size() == 50);
+    REQUIRE(pAggregated->GetOutputs().size() == 150);
+    REQUIRE(pAggregated->GetKernels().size() == 100);
+    REQUIRE(pAggregated->GetTotalFee() == 1000);
+
+    REQUIRE(std::is_sorted(pAggregated->GetInputs().cbegin(), pAggregated->GetInputs().cend(), SortByHash));
+    REQUIRE(std::is_sorted(pAggregated->GetOutputs().cbegin(), pAggregated->GetOutputs().cend(), SortByHash));
+    REQUIRE(std::is_sorted(pAggregated->GetKernels().cbegin(), pAggregated->GetKernels().cend(), SortByHash));
+    CutThrough::VerifyCutThrough(pAggregated->GetInputs(), pAggregated->GetOutputs());
+}
+
+TEST_CASE("CutThrough")
+{
+    auto pProof = std::make_shared<const RangeProof>(std::vector<uint8_t>(675, 0));
+
+    Commitment commitment1 = RandomCommitment();
+    Commitment commitment2 = RandomCommitment();
+    Commitment commitment3 = RandomCommitment();
+
+    std::vector<Input> inputs{
+        Input(EOutputFeatures::DEFAULT_OUTPUT, Commitment(commitment1)),
+        Input(EOutputFeatures::DEFAULT_OUTPUT, Commitment(commitment2))
+    };
+    std::vector<Output> outputs{
+        Output(EOutputFeatures::DEFAULT_OUTPUT, Commitment(commitment3), std::vector<uint8_t>{}, pProof),
+        Output(EOutputFeatures::DEFAULT_OUTPUT, Commitment(commitment1), std::vector<uint8_t>{}, pProof)
+    };
+
+    CutThrough::PerformCutThrough(inputs, outputs);
+    REQUIRE(inputs.size() == 1);
+    REQUIRE(inputs.front().GetCommitment() == commitment2);
+    REQUIRE(outputs.size() == 1);
+    REQUIRE(outputs.front().GetCommitment() == commitment3);
+}
+
+TEST_CASE("Aggregation - Throughput", "[.benchmark]")
+{
+    for (const size_t num_txs : { 10'000, 50'000, 100'000 })
+    {
+        std::vector<mw::Transaction> txs = CreateChainedTxs(num_txs);
+        std::vector<mw::Transaction::CPtr> ptrs = ToPtrs(txs);
+
+        auto start = std::chrono::steady_clock::now();
+        Aggregation::Aggregate(ptrs);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Aggregation: " << num_txs << " txs in " << elapsed.count() << "ms" << std::endl;
+    }
+}
@@ -0,0 +1,127 @@
+#include <catch.hpp>
+
+#include <mw/consensus/TxValidator.h>
+#include <mw/crypto/Random.h>
+#include <mw/file/ScopedFileRemover.h>
+#include <mw/node/INode.h>
+
+#include <test_framework/DBWrapper.h>
+#include <test_framework/Miner.h>
+#include <test_framework/TestUtil.h>
+
+#include <chrono>
+
+TEST_CASE("TransactionValidator")
+{
+    test::Tx pegin = test::Tx::CreatePegIn(1000);
+    test::Tx spend = test::Tx::CreateSpend(pegin.GetTxOutputs(), { 600, 400 });
+
+    ///////////////////////
+    // Valid
+    ///////////////////////
+    auto pTransaction = std::make_shared<mw::Transaction>(*spend.GetTransaction());
+    REQUIRE_FALSE(pTransaction->WasValidated());
+    TransactionValidator().Validate(pTransaction);
+    REQUIRE(pTransaction->WasValidated());
+
+    ///////////////////////
+    // Invalid Sums
+    ///////////////////////
+    auto pBadOffset = std::make_shared<mw::Transaction>(
+        BlindingFactor(Random::CSPRNG<32>().GetBigInt()),
+        TxBody(spend.GetTransaction()->GetBody())
+    );
+    REQUIRE_THROWS_AS(TransactionValidator().Validate(pBadOffset), ValidationException);
+    REQUIRE_FALSE(pBadOffset->WasValidated());
+
+    ///////////////////////
+    // Invalid Signature
+    ///////////////////////
+    const Kernel& kernel = spend.GetTransaction()->GetKernels().front();
+    Kernel badSigKernel = Kernel::CreatePlain(kernel.GetFee(), Commitment(kernel.GetExcess()), Signature(Random::CSPRNG<64>().GetBigInt()));
+    auto pBadSig = std::make_shared<mw::Transaction>(
+        BlindingFactor(spend.GetTransaction()->GetOffset()),
+        TxBody(spend.GetTransaction()->GetInputs(), spend.GetTransaction()->GetOutputs(), { badSigKernel })
+    );
+    REQUIRE_THROWS_AS(TransactionValidator().Validate(pBadSig), ValidationException);
+
+    ///////////////////////
+    // Duplicate Outputs
+    ///////////////////////
+    // Rejected by the structure checks, before the (also broken) sums are checked.
+    std::vector<Output> outputs = spend.GetTransaction()->GetOutputs();
+    outputs.push_back(outputs.front());
+    auto pDuplicate = std::make_shared<mw::Transaction>(
+        BlindingFactor(spend.GetTransaction()->GetOffset()),
+        TxBody(spend.GetTransaction()->GetInputs(), outputs, spend.GetTransaction()->GetKernels())
+    );
+    REQUIRE_THROWS_WITH(TransactionValidator().Validate(pDuplicate), Catch::Contains("DUPLICATE_OUTPUT"));
+    REQUIRE_FALSE(pDuplicate->WasValidated());
+}
+
+TEST_CASE("TransactionValidator - Block From Validated Transactions")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, std::make_shared<TestDBWrapper>());
+
+    test::Miner miner;
+    test::Tx pegin = test::Tx::CreatePegIn(1000);
+    pNode->ConnectBlock(miner.MineBlock(150, { pegin }).GetBlock(), pNode->GetDBView());
+
+    test::Tx spend1 = test::Tx::CreateSpend(pegin.GetTxOutputs(), { 1000 });
+    test::Tx spend2 = test::Tx::CreateSpend(spend1.GetTxOutputs(), { 1000 });
+
+    auto pTx1 = std::make_shared<mw::Transaction>(*spend1.GetTransaction());
+    auto pTx2 = std::make_shared<mw::Transaction>(*spend2.GetTransaction());
+    TransactionValidator().Validate(pTx1);
+
+    // Only some of the transactions were validated, so the block must be validated in full.
+    auto pCache1 = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    REQUIRE_FALSE(pCache1->BuildNextBlock(151, { pTx1, pTx2 })->WasValidated());
+
+    TransactionValidator().Validate(pTx2);
+    auto pCache2 = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    mw::Block::Ptr pBlock = pCache2->BuildNextBlock(151, { pTx1, pTx2 });
+    REQUIRE(pBlock->WasValidated());
+
+    // The block is still valid when verified in full.
+    REQUIRE_NOTHROW(pBlock->Validate());
+
+    pNode.reset();
+}
+
+TEST_CASE("TransactionValidator - Admission Rate", "[.benchmark]")
+{
+    const size_t num_txs = 1000;
+
+    std::vector<mw::Transaction::Ptr> valid;
+    std::vector<mw::Transaction::Ptr> invalid;
+    for (size_t i = 0; i < num_txs; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        test::Tx spend = test::Tx::CreateSpend(pegin.GetTxOutputs(), { 1000 });
+        valid.push_back(std::make_shared<mw::Transaction>(*spend.GetTransaction()));
+
+        // Unbalanced, so it's rejected before any signatures or rangeproofs are verified.
+        invalid.push_back(std::make_shared<mw::Transaction>(
+            BlindingFactor(Random::CSPRNG<32>().GetBigInt()),
+            TxBody(spend.GetTransaction()->GetBody())
+        ));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& pTx : valid) {
+        TransactionValidator().Validate(pTx);
+    }
+    auto valid_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    for (const auto& pTx : invalid) {
+        REQUIRE_THROWS(TransactionValidator().Validate(pTx));
+    }
+    auto invalid_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "TransactionValidator: " << num_txs << " valid txs in " << valid_elapsed.count() << "us, "
+        << num_txs << " unbalanced txs rejected in " << invalid_elapsed.count() << "us" << std::endl;
+}
@@ -3,6 +3,10 @@
 #include <mw/crypto/Crypto.h>
 #include <mw/crypto/Random.h>
 
+#include <chrono>
+#include <iostream>
+#include <set>
+
 TEST_CASE("Crypto::AddCommitment")
 {
     // Test adding blinded commitment with transparent one
@@ -54,4 +58,70 @@ TEST_CASE("Crypto::AddCommitment")
         Commitment commit_c = Crypto::CommitBlinded(1, blind_c);
         REQUIRE(commit_c == difference);
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Crypto::AddCommitment - Repeated Points")
+{
+    std::vector<BlindingFactor> blinds;
+    std::vector<Commitment> commits;
+    for (uint64_t i = 0; i < 64; i++)
+    {
+        blinds.push_back(Random::CSPRNG<32>().GetBigInt());
+        commits.push_back(Crypto::CommitBlinded(i, blinds.back()));
+    }
+
+    // Sums of the same (already parsed) commitments must match freshly computed ones, whichever prefix the result has.
+    std::set<uint8_t> prefixes;
+    for (size_t i = 1; i < commits.size(); i++)
+    {
+        for (size_t round = 0; round < 2; round++)
+        {
+            Commitment sum = Crypto::AddCommitments({ commits[i], commits[i - 1] }, {});
+            REQUIRE(sum == Crypto::CommitBlinded(2 * i - 1, Crypto::AddBlindingFactors({ blinds[i], blinds[i - 1] })));
+
+            Commitment difference = Crypto::AddCommitments({ commits[i] }, { commits[i - 1] });
+            REQUIRE(difference == Crypto::CommitBlinded(1, Crypto::AddBlindingFactors({ blinds[i] }, { blinds[i - 1] })));
+
+            prefixes.insert(sum.data()[0]);
+        }
+    }
+
+    REQUIRE(prefixes == std::set<uint8_t>({ 0x08, 0x09 }));
+
+    // A commitment to 0 is just the blinding factor's public key.
+    SecretKey key = Random::CSPRNG<32>();
+    Commitment zeroCommit = Crypto::CommitBlinded(0, BlindingFactor(key));
+    for (size_t round = 0; round < 2; round++)
+    {
+        REQUIRE(Crypto::ToPublicKey(zeroCommit).GetBigInt() == Crypto::CalculatePublicKey(key).GetBigInt());
+    }
+
+    // A sum that cancels out to the point at infinity, or of nothing at all, is still an error.
+    REQUIRE_THROWS(Crypto::AddCommitments({ commits[1] }, { commits[1] }));
+    REQUIRE_THROWS(Crypto::AddCommitments({}, {}));
+}
+
+TEST_CASE("Crypto::AddCommitment - Performance", "[.benchmark]")
+{
+    const size_t numCommits = 10'000;
+
+    std::vector<Commitment> commits;
+    for (size_t i = 0; i < numCommits; i++)
+    {
+        commits.push_back(Crypto::CommitBlinded(i, Random::CSPRNG<32>().GetBigInt()));
+    }
+
+    std::vector<Commitment> positive(commits.begin(), commits.begin() + numCommits / 2);
+    std::vector<Commitment> negative(commits.begin() + numCommits / 2, commits.end());
+
+    for (size_t round = 1; round <= 3; round++)
+    {
+        auto start = std::chrono::steady_clock::now();
+        Commitment sum = Crypto::AddCommitments(positive, negative);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        REQUIRE(!sum.IsZero());
+
+        std::cout << "Summing " << numCommits << " commitments (round " << round << "): "
+            << elapsed.count() << "us" << std::endl;
+    }
+}
@@ -0,0 +1,110 @@
+#include <catch.hpp>
+
+#include <mw/crypto/Crypto.h>
+#include <mw/crypto/Random.h>
+#include <mw/crypto/ScratchSpacePool.h>
+#include <mw/crypto/VerificationCache.h>
+
+#include <chrono>
+#include <thread>
+
+using ProofData = std::tuple<Commitment, RangeProof::CPtr, std::vector<uint8_t>>;
+
+static ProofData CreateProof(const uint64_t amount)
+{
+    SecretKey blind = Random::CSPRNG<32>();
+    Commitment commitment = Crypto::CommitBlinded(amount, BlindingFactor(blind.GetBigInt()));
+    RangeProof::CPtr pProof = Crypto::GenerateRangeProof(
+        amount,
+        blind,
+        Random::CSPRNG<32>(),
+        Random::CSPRNG<32>(),
+        ProofMessage(BigInt<20>())
+    );
+
+    return std::make_tuple(commitment, pProof, std::vector<uint8_t>{});
+}
+
+TEST_CASE("Crypto::VerifyRangeProofs")
+{
+    std::vector<ProofData> proofs;
+    for (uint64_t i = 0; i < 40; i++) {
+        proofs.push_back(CreateProof(1000 + i));
+    }
+
+    REQUIRE(Crypto::VerifyRangeProofs(proofs));
+
+    // Verified proofs are cached, so checking them again doesn't verify anything.
+    const uint64_t hits = VerificationCache::GetRangeProofCache().GetStats().hits;
+    REQUIRE(Crypto::VerifyRangeProofs(proofs));
+    REQUIRE(VerificationCache::GetRangeProofCache().GetStats().hits == hits + proofs.size());
+
+    // A proof paired with the wrong commitment fails the whole set, wherever it is in the batch.
+    for (const size_t invalid_idx : { 0, 27, 39 }) {
+        std::vector<ProofData> invalid = proofs;
+        std::get<0>(invalid[invalid_idx]) = Crypto::CommitTransparent(5);
+        REQUIRE_FALSE(Crypto::VerifyRangeProofs(invalid));
+    }
+
+    REQUIRE(Crypto::VerifyRangeProofs({}));
+}
+
+TEST_CASE("Crypto::VerifyRangeProofs - Throughput", "[.benchmark]")
+{
+    const size_t num_proofs = 1024;
+
+    std::vector<ProofData> proofs;
+    for (uint64_t i = 0; i < num_proofs; i++) {
+        proofs.push_back(CreateProof(i));
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    REQUIRE(Crypto::VerifyRangeProofs(proofs));
+    auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Bulletproofs: " << num_proofs << " proofs verified in " << elapsed.count() << "ms on "
+        << std::thread::hardware_concurrency() << " cores" << std::endl;
+}
+
+TEST_CASE("Crypto::VerifyRangeProofs - Small Batch Latency", "[.benchmark]")
+{
+    const size_t num_iterations = 200;
+
+    ProofData proof = CreateProof(1000);
+
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        VerificationCache::GetRangeProofCache().Clear();
+        REQUIRE(Crypto::VerifyRangeProofs({ proof }));
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Bulletproofs: single proof verified in " << (elapsed.count() / num_iterations) << "us on average" << std::endl;
+}
+
+TEST_CASE("ScratchSpacePool")
+{
+    ProofData proof = CreateProof(1000);
+    REQUIRE(Crypto::VerifyRangeProofs({ proof }));
+
+    const ScratchSpacePool::Stats before = ScratchSpacePool::GetShared().GetStats();
+    for (size_t i = 0; i < 5; i++) {
+        VerificationCache::GetRangeProofCache().Clear();
+        REQUIRE(Crypto::VerifyRangeProofs({ proof }));
+    }
+    const ScratchSpacePool::Stats after = ScratchSpacePool::GetShared().GetStats();
+
+    // The scratch space from the first verification is reused.
+    REQUIRE(after.acquired == before.acquired + 5);
+    REQUIRE(after.created == before.created);
+    REQUIRE(after.inUse == 0);
+
+    // Proving on short-lived threads reuses the same scratch spaces, rather than leaving one behind per thread.
+    CreateProof(1000);
+    const ScratchSpacePool::Stats beforeThreads = ScratchSpacePool::GetShared().GetStats();
+    for (size_t i = 0; i < 5; i++) {
+        std::thread([]() { CreateProof(1000); }).join();
+    }
+
+    REQUIRE(ScratchSpacePool::GetShared().GetStats().created == beforeThreads.created);
+}
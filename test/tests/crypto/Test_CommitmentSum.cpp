@@ -0,0 +1,129 @@
+#include <catch.hpp>
+
+#include <mw/crypto/CommitmentSum.h>
+#include <mw/crypto/Crypto.h>
+#include <mw/crypto/Random.h>
+#include <mw/exceptions/CryptoException.h>
+
+#include <chrono>
+#include <iostream>
+
+TEST_CASE("CommitmentSum")
+{
+    std::vector<Commitment> positive;
+    std::vector<Commitment> negative;
+    for (uint64_t i = 0; i < 300; i++)
+    {
+        positive.push_back(Crypto::CommitBlinded(i + 100, Random::CSPRNG<32>().GetBigInt()));
+        if (i % 3 == 0) {
+            negative.push_back(Crypto::CommitBlinded(i, Random::CSPRNG<32>().GetBigInt()));
+        }
+    }
+
+    const Commitment expected = Crypto::AddCommitments(positive, negative);
+
+    // The result mustn't depend on how the commitments are split into batches.
+    for (const size_t batchSize : std::vector<size_t>{ 1, 7, 64, 1000, CommitmentSum::DEFAULT_BATCH_SIZE })
+    {
+        CommitmentSum sum(batchSize);
+        for (size_t i = 0; i < positive.size(); i++)
+        {
+            sum.Add(positive[i]);
+            if (i % 3 == 0) {
+                sum.Subtract(negative[i / 3]);
+            }
+        }
+
+        REQUIRE(sum.Total() == expected);
+    }
+
+    // Sums that cancel out are zero.
+    {
+        CommitmentSum sum(4);
+        REQUIRE(sum.Total().IsZero());
+
+        for (const Commitment& commitment : positive)
+        {
+            sum.Add(commitment);
+        }
+
+        for (const Commitment& commitment : positive)
+        {
+            sum.Subtract(commitment);
+        }
+
+        REQUIRE(sum.Total().IsZero());
+
+        // Still usable after cancelling out.
+        sum.Add(positive[5]);
+        REQUIRE(sum.Total() == positive[5]);
+    }
+
+    // Invalid commitments
+    {
+        Commitment invalid = positive.front();
+        invalid.data()[0] = 0x02;
+
+        CommitmentSum sum;
+        sum.Add(invalid);
+        REQUIRE_THROWS_AS(sum.Total(), CryptoException);
+    }
+
+    // Zero commitments are invalid, like they are for Crypto::AddCommitments.
+    {
+        CommitmentSum sum;
+        sum.Add(positive.front());
+        sum.Subtract(Commitment());
+        REQUIRE_THROWS_AS(sum.Total(), CryptoException);
+    }
+}
+
+TEST_CASE("CommitmentSum - State Validation", "[.benchmark]")
+{
+    // Generating millions of commitments would take far longer than summing them, so the same ones are used over and over.
+    // There are more of them than Crypto::AddCommitments can cache, so it still has to parse each one every time, like for a real state.
+    std::vector<Commitment> pool;
+    for (size_t i = 0; i < 131'072; i++)
+    {
+        pool.push_back(Crypto::CommitBlinded(i, Random::CSPRNG<32>().GetBigInt()));
+    }
+
+    const size_t num_compare = 1'000'000;
+    {
+        auto start = std::chrono::steady_clock::now();
+        std::vector<Commitment> commitments;
+        for (size_t i = 0; i < num_compare; i++)
+        {
+            commitments.push_back(pool[i % pool.size()]);
+        }
+
+        Commitment expected = Crypto::AddCommitments(commitments);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "Crypto::AddCommitments: " << num_compare << " commitments in " << elapsed.count() << "ms" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        CommitmentSum sum;
+        for (size_t i = 0; i < num_compare; i++)
+        {
+            sum.Add(pool[i % pool.size()]);
+        }
+
+        REQUIRE(sum.Total() == expected);
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "CommitmentSum: " << num_compare << " commitments in " << elapsed.count() << "ms" << std::endl;
+    }
+
+    const size_t num_utxos = 10'000'000;
+    {
+        auto start = std::chrono::steady_clock::now();
+        CommitmentSum sum;
+        for (size_t i = 0; i < num_utxos; i++)
+        {
+            sum.Add(pool[i % pool.size()]);
+        }
+
+        REQUIRE(!sum.Total().IsZero());
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "CommitmentSum: " << num_utxos << " commitments in " << elapsed.count() << "ms" << std::endl;
+    }
+}
@@ -0,0 +1,84 @@
+#include <catch.hpp>
+
+#include <mw/crypto/Crypto.h>
+#include <mw/crypto/Schnorr.h>
+#include <mw/crypto/Random.h>
+#include <mw/common/ThreadPool.h>
+
+#include <atomic>
+#include <chrono>
+
+//
+// Signs, verifies and proves in several tasks at once on the shared pool, each thread using its own randomized context.
+//
+static size_t SignProveVerify(const size_t num_tasks, const size_t iterations_per_task)
+{
+    std::atomic<size_t> num_valid{ 0 };
+    ThreadPool::GetShared().ForEach(num_tasks, [&num_valid, iterations_per_task](const size_t) {
+        for (size_t i = 0; i < iterations_per_task; i++) {
+            SecretKey key = Random::CSPRNG<32>();
+            mw::Hash message = Random::CSPRNG<32>().GetBigInt();
+            Signature signature = Schnorr::Sign(key, message);
+            if (Schnorr::Verify(signature, Crypto::CalculatePublicKey(key), message)) {
+                ++num_valid;
+            }
+
+            SecretKey blind = Random::CSPRNG<32>();
+            Commitment commitment = Crypto::CommitBlinded(i, BlindingFactor(blind));
+            RangeProof::CPtr pProof = Crypto::GenerateRangeProof(
+                i,
+                blind,
+                Random::CSPRNG<32>(),
+                Random::CSPRNG<32>(),
+                ProofMessage(BigInt<20>())
+            );
+            if (Crypto::VerifyRangeProofs({ std::make_tuple(commitment, pProof, std::vector<uint8_t>{}) })) {
+                ++num_valid;
+            }
+        }
+    });
+
+    return num_valid;
+}
+
+TEST_CASE("Crypto - Concurrent Contexts")
+{
+    REQUIRE(SignProveVerify(4, 2) == 16);
+}
+
+TEST_CASE("Crypto - Concurrent Throughput", "[.benchmark]")
+{
+    const size_t total_iterations = 64;
+
+    for (const size_t num_tasks : { 1, 4, 16 }) {
+        auto start = std::chrono::steady_clock::now();
+        REQUIRE(SignProveVerify(num_tasks, total_iterations / num_tasks) == total_iterations * 2);
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Crypto: " << total_iterations << " sign/verify/prove/verify iterations in " << num_tasks
+            << " tasks in " << elapsed.count() << "ms" << std::endl;
+    }
+}
+
+//
+// Only meaningful when run on its own, since any earlier crypto call would have already built the shared context.
+//
+TEST_CASE("Crypto - Cold Start", "[.benchmark]")
+{
+    SecretKey key = Random::CSPRNG<32>();
+    mw::Hash message = Random::CSPRNG<32>().GetBigInt();
+
+    auto start = std::chrono::steady_clock::now();
+    Signature signature = Schnorr::Sign(key, message);
+    REQUIRE(Schnorr::Verify(signature, Crypto::CalculatePublicKey(key), message));
+    auto verify_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    Commitment commitment = Crypto::CommitBlinded(1, BlindingFactor(key));
+    RangeProof::CPtr pProof = Crypto::GenerateRangeProof(1, key, key, key, ProofMessage(BigInt<20>()));
+    REQUIRE(Crypto::VerifyRangeProofs({ std::make_tuple(commitment, pProof, std::vector<uint8_t>{}) }));
+    auto proof_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Crypto: first sign+verify " << verify_elapsed.count() << "us, "
+        << "first rangeproof prove+verify " << proof_elapsed.count() << "us" << std::endl;
+}
@@ -0,0 +1,76 @@
+#include <catch.hpp>
+
+#include <mw/crypto/VerificationCache.h>
+#include <mw/crypto/Crypto.h>
+#include <mw/crypto/Schnorr.h>
+#include <mw/crypto/Random.h>
+
+static VerificationCache::Key RandomKey(const VerificationCache& cache)
+{
+    return cache.NewKey().Append(Random::CSPRNG<32>().GetBigInt().vec()).Build();
+}
+
+TEST_CASE("VerificationCache")
+{
+    VerificationCache cache(64, 4);
+
+    std::vector<uint8_t> data{ 1, 2, 3 };
+    VerificationCache::Key key = cache.NewKey().Append(data).Build();
+    REQUIRE_FALSE(cache.Contains(key));
+
+    cache.Insert(key);
+    REQUIRE(cache.Contains(key));
+    REQUIRE(cache.Contains(cache.NewKey().Append(data).Build()));
+
+    // Field boundaries are part of the key.
+    REQUIRE_FALSE(cache.Contains(cache.NewKey().Append({ 1 }).Append({ 2, 3 }).Build()));
+
+    // Salted, so another cache's keys differ.
+    VerificationCache other(64, 4);
+    REQUIRE(other.NewKey().Append(data).Build() != key);
+
+    VerificationCache::Stats stats = cache.GetStats();
+    REQUIRE(stats.hits == 2);
+    REQUIRE(stats.misses == 2);
+    REQUIRE(stats.insertions == 1);
+    REQUIRE(stats.size == 1);
+    REQUIRE(stats.GetHitRate() == 0.5);
+
+    // Never grows beyond its capacity.
+    for (size_t i = 0; i < 1000; i++) {
+        cache.Insert(RandomKey(cache));
+    }
+    REQUIRE(cache.GetStats().size <= 64);
+    REQUIRE(cache.GetStats().evictions >= 1000 + 1 - 64);
+
+    cache.SetCapacity(8);
+    REQUIRE(cache.GetStats().size <= 8);
+
+    cache.SetCapacity(0);
+    REQUIRE(cache.GetStats().size == 0);
+    cache.Insert(key);
+    REQUIRE_FALSE(cache.Contains(key));
+}
+
+TEST_CASE("VerificationCache - Schnorr::BatchVerify")
+{
+    VerificationCache& cache = VerificationCache::GetSignatureCache();
+
+    SecretKey key = Random::CSPRNG<32>();
+    Commitment excess = Crypto::CommitBlinded(0, BlindingFactor(key));
+    mw::Hash message = Random::CSPRNG<32>().GetBigInt();
+    Signature signature = Schnorr::Sign(key, message);
+
+    std::vector<std::tuple<Signature, Commitment, mw::Hash>> signatures{ std::make_tuple(signature, excess, message) };
+
+    VerificationCache::Stats before = cache.GetStats();
+    REQUIRE(Schnorr::BatchVerify(signatures));
+    REQUIRE(cache.GetStats().insertions == before.insertions + 1);
+
+    REQUIRE(Schnorr::BatchVerify(signatures));
+    REQUIRE(cache.GetStats().hits == before.hits + 1);
+
+    // A cached signature doesn't vouch for a different message.
+    std::get<2>(signatures.front()) = Random::CSPRNG<32>().GetBigInt();
+    REQUIRE_FALSE(Schnorr::BatchVerify(signatures));
+}
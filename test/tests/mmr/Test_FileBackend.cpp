@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <mw/mmr/backends/FileBackend.h>
+#include <mw/mmr/MMR.h>
 #include <mw/models/tx/Kernel.h>
 #include <mw/crypto/Random.h>
 #include <mw/file/ScopedFileRemover.h>
@@ -27,4 +28,47 @@ TEST_CASE("mmr::FileBackend")
         auto pBackend = FileBackend::Open(tempDir, boost::none);
         REQUIRE(pBackend->GetNumLeaves() == 1);
     }
-}
\ No newline at end of file
+}
+TEST_CASE("mmr::FileBackend::RebuildPositionFile")
+{
+    FilePath tempDir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(tempDir);
+
+    // Each leaf starts with the number of bytes after it.
+    auto leafSize = [](const uint8_t* pData, const size_t available) -> size_t {
+        return available > 0 ? (size_t)pData[0] + 1 : 0;
+    };
+
+    std::vector<std::vector<uint8_t>> leaves{ { 0x02, 0x05, 0x03 }, { 0x00 }, { 0x04, 0x01, 0x02, 0x03, 0x04 } };
+
+    // Written the way older versions did: as a fixed-length backend, so without a position file.
+    mw::Hash root;
+    {
+        auto pBackend = FileBackend::Open(tempDir, boost::optional<uint16_t>(3));
+        for (size_t i = 0; i < leaves.size(); i++) {
+            pBackend->AddLeaf(mmr::Leaf::Create(mmr::LeafIndex::At(i), std::vector<uint8_t>(leaves[i])));
+        }
+
+        pBackend->Commit();
+        root = MMR(pBackend).Root();
+    }
+
+    FileBackend::RebuildPositionFile(tempDir, leafSize);
+    {
+        auto pBackend = FileBackend::Open(tempDir, boost::none);
+        REQUIRE(pBackend->GetNumLeaves() == leaves.size());
+        for (size_t i = 0; i < leaves.size(); i++) {
+            REQUIRE(pBackend->GetLeaf(mmr::LeafIndex::At(i)).vec() == leaves[i]);
+        }
+
+        REQUIRE(MMR(pBackend).Root() == root);
+    }
+
+    // Data that doesn't match the hashes is refused.
+    {
+        tempDir.GetChild("pmmr_pos.bin").Remove();
+        File(tempDir.GetChild("pmmr_data.bin")).Truncate(6);
+        REQUIRE_THROWS_AS(FileBackend::RebuildPositionFile(tempDir, leafSize), FileException);
+        REQUIRE_FALSE(tempDir.GetChild("pmmr_pos.bin").Exists());
+    }
+}
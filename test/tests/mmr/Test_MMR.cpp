@@ -40,4 +40,33 @@ TEST_CASE("mmr::MMR")
     REQUIRE(mmr.GetNumLeaves() == 4);
     REQUIRE(mmr.GetNumNodes() == 7);
     REQUIRE(mmr.Root() == mw::Hash::FromHex("675996c8bbfce6319dd00588ebd289d555eedfa60aa17a9a83cc7da80888a97e"));
-}
\ No newline at end of file
+}
+TEST_CASE("mmr::MMRCache::GetMemoryUsage")
+{
+    auto pBackend = std::make_shared<VectorBackend>();
+    auto pMMR = std::make_shared<MMR>(pBackend);
+    MMRCache cache(pMMR);
+    REQUIRE(cache.GetMemoryUsage() == 0);
+
+    cache.Add(std::vector<uint8_t>({ 0, 1, 2 }));
+    cache.Add(std::vector<uint8_t>({ 1, 2, 3 }));
+    const size_t usage_2_leaves = cache.GetMemoryUsage();
+    REQUIRE(usage_2_leaves > 0);
+
+    cache.Add(std::vector<uint8_t>({ 2, 3, 4 }));
+    cache.Add(std::vector<uint8_t>({ 3, 4, 5 }));
+    const size_t usage_4_leaves = cache.GetMemoryUsage();
+    REQUIRE(usage_4_leaves > usage_2_leaves);
+
+    // Rewinding releases the memory of the removed leaves and hashes, but keeps the vectors' capacity,
+    // so re-adding the same leaves should bring the usage back to exactly where it was.
+    cache.Rewind(2);
+    REQUIRE(cache.GetMemoryUsage() < usage_4_leaves);
+    cache.Add(std::vector<uint8_t>({ 2, 3, 4 }));
+    cache.Add(std::vector<uint8_t>({ 3, 4, 5 }));
+    REQUIRE(cache.GetMemoryUsage() == usage_4_leaves);
+
+    cache.Flush();
+    REQUIRE(cache.GetMemoryUsage() == 0);
+    REQUIRE(pMMR->GetNumLeaves() == 4);
+}
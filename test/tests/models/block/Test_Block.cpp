@@ -1,8 +1,86 @@
 #include <catch.hpp>
 
 #include <mw/models/block/Block.h>
+#include <test_framework/Miner.h>
+
+#include <chrono>
+#include <iostream>
 
 TEST_CASE("Block")
 {
 
-}
\ No newline at end of file
+}
+
+TEST_CASE("Block - Serialize Throughput", "[.benchmark]")
+{
+    std::vector<test::Tx> txs;
+    for (size_t i = 0; i < 50; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::Miner miner;
+    mw::Block::Ptr pBlock = miner.MineBlock(10, txs).GetBlock();
+    const std::vector<uint8_t> expected = pBlock->Serialized();
+
+    const size_t num_iterations = 2000;
+    size_t total_bytes = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        total_bytes += pBlock->Serialized().size();
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    REQUIRE(total_bytes == expected.size() * num_iterations);
+    std::cout << "Block::Serialized: " << num_iterations << " blocks (" << expected.size() << " bytes each) in "
+        << elapsed.count() / 1000 << "ms, " << (double)total_bytes / std::max<int64_t>(elapsed.count(), 1) << " MB/s" << std::endl;
+
+    // Headers are mostly integers, so they show the per-field overhead rather than the cost of copying rangeproofs.
+    total_bytes = 0;
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations * 100; i++) {
+        total_bytes += pBlock->GetHeader()->Serialized().size();
+    }
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Header::Serialized: " << num_iterations * 100 << " headers in " << elapsed.count() / 1000 << "ms, "
+        << (double)total_bytes / std::max<int64_t>(elapsed.count(), 1) << " MB/s" << std::endl;
+}
+
+TEST_CASE("Block - Deserialize Throughput", "[.benchmark]")
+{
+    std::vector<test::Tx> txs;
+    for (size_t i = 0; i < 50; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::Miner miner;
+    mw::Block::Ptr pBlock = miner.MineBlock(10, txs).GetBlock();
+    const std::vector<uint8_t> serialized = pBlock->Serialized();
+
+    const size_t num_iterations = 2000;
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        Deserializer deserializer(serialized.data(), serialized.size());
+        REQUIRE(mw::Block::Deserialize(deserializer).GetKernels().size() == txs.size());
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Block::Deserialize: " << num_iterations << " blocks (" << serialized.size() << " bytes each) in "
+        << elapsed.count() / 1000 << "ms, " << (double)(serialized.size() * num_iterations) / std::max<int64_t>(elapsed.count(), 1) << " MB/s" << std::endl;
+
+    // Headers aren't hashed as they're decoded, so they show the cost of the deserializer itself.
+    const std::vector<uint8_t> header = pBlock->GetHeader()->Serialized();
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations * 100; i++) {
+        Deserializer deserializer(header.data(), header.size());
+        REQUIRE(mw::Header::Deserialize(deserializer).GetHeight() == 10);
+    }
+    elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "Header::Deserialize: " << num_iterations * 100 << " headers in " << elapsed.count() / 1000 << "ms, "
+        << (double)(header.size() * num_iterations * 100) / std::max<int64_t>(elapsed.count(), 1) << " MB/s" << std::endl;
+}
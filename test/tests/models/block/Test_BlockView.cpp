@@ -0,0 +1,170 @@
+#include <catch.hpp>
+
+#include <mw/models/block/BlockView.h>
+#include <mw/exceptions/DeserializationException.h>
+#include <test_framework/Miner.h>
+
+#include <chrono>
+#include <iostream>
+#include <malloc.h>
+
+TEST_CASE("BlockView")
+{
+    test::Tx pegin = test::Tx::CreatePegIn(1000);
+    std::vector<test::Tx> txs{ pegin, test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100) };
+
+    test::Miner miner;
+    mw::Block::Ptr pBlock = miner.MineBlock(10, txs).GetBlock();
+    const std::vector<uint8_t> serialized = pBlock->Serialized();
+
+    mw::BlockView view = mw::BlockView::Parse(std::vector<uint8_t>(serialized));
+    REQUIRE(view.GetHeader()->GetHash() == pBlock->GetHash());
+    REQUIRE(view.GetWeight() == pBlock->GetTxBody().GetWeight());
+
+    REQUIRE(view.GetNumInputs() == pBlock->GetInputs().size());
+    for (size_t i = 0; i < view.GetNumInputs(); i++) {
+        REQUIRE(view.GetInputCommitment(i) == pBlock->GetInputs()[i].GetCommitment());
+        REQUIRE(view.GetInputHash(i) == pBlock->GetInputs()[i].GetHash());
+        REQUIRE(view.GetInput(i).Serialized() == pBlock->GetInputs()[i].Serialized());
+    }
+
+    REQUIRE(view.GetNumOutputs() == pBlock->GetOutputs().size());
+    const std::vector<mw::Hash> outputHashes = view.GetOutputHashes();
+    for (size_t i = 0; i < view.GetNumOutputs(); i++) {
+        REQUIRE(view.GetOutputCommitment(i) == pBlock->GetOutputs()[i].GetCommitment());
+        REQUIRE(view.GetOutputHash(i) == pBlock->GetOutputs()[i].GetHash());
+        REQUIRE(outputHashes[i] == pBlock->GetOutputs()[i].GetHash());
+        REQUIRE(view.GetOutput(i).Serialized() == pBlock->GetOutputs()[i].Serialized());
+    }
+
+    REQUIRE(view.GetNumKernels() == pBlock->GetKernels().size());
+    for (size_t i = 0; i < view.GetNumKernels(); i++) {
+        REQUIRE(view.GetKernelHash(i) == pBlock->GetKernels()[i].GetHash());
+        REQUIRE(view.GetKernel(i).Serialized() == pBlock->GetKernels()[i].Serialized());
+    }
+
+    REQUIRE(view.Materialize()->Serialized() == serialized);
+
+    // Truncated
+    std::vector<uint8_t> truncated(serialized.begin(), serialized.end() - 1);
+    REQUIRE_THROWS_AS(mw::BlockView::Parse(std::move(truncated)), DeserializationException);
+}
+
+TEST_CASE("BlockView - Decode")
+{
+    std::vector<test::Tx> txs;
+    for (size_t i = 0; i < 40; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    // Enough outputs to be split into several chunks.
+    test::Miner miner;
+    mw::Block::Ptr pBlock = miner.MineBlock(10, txs).GetBlock();
+    REQUIRE(pBlock->GetOutputs().size() > 64);
+    const std::vector<uint8_t> serialized = pBlock->Serialized();
+
+    for (size_t num_threads : { 0, 1, 3 }) {
+        ThreadPool pool(num_threads);
+        mw::Block::Ptr pDecoded = mw::BlockView::Decode(serialized.data(), serialized.size(), pool);
+        REQUIRE(pDecoded->Serialized() == serialized);
+        REQUIRE(pDecoded->GetHash() == pBlock->GetHash());
+        REQUIRE(pDecoded->GetInputs() == pBlock->GetInputs());
+        REQUIRE(pDecoded->GetOutputs() == pBlock->GetOutputs());
+        REQUIRE(pDecoded->GetKernels() == pBlock->GetKernels());
+        REQUIRE_THROWS_AS(mw::BlockView::Decode(serialized.data(), serialized.size() - 1, pool), DeserializationException);
+    }
+}
+
+TEST_CASE("BlockView - Decode Latency", "[.benchmark]")
+{
+    std::vector<test::Tx> txs;
+    for (size_t i = 0; i < 250; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::Miner miner;
+    const std::vector<uint8_t> serialized = miner.MineBlock(10, txs).GetBlock()->Serialized();
+    const size_t num_iterations = 20;
+
+    // Hashing every element, as validation will, so both decoders do the same work.
+    auto start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < num_iterations; i++) {
+        Deserializer deserializer(serialized.data(), serialized.size());
+        mw::Block block = mw::Block::Deserialize(deserializer);
+        for (const Input& input : block.GetInputs()) {
+            input.GetHash();
+        }
+
+        for (const Output& output : block.GetOutputs()) {
+            output.GetHash();
+        }
+
+        for (const Kernel& kernel : block.GetKernels()) {
+            kernel.GetHash();
+        }
+    }
+    auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    std::cout << "Block::Deserialize: " << serialized.size() << " bytes in " << elapsed.count() / num_iterations << "us" << std::endl;
+
+    for (size_t num_threads : { 0, 1, 2, 4, 8 }) {
+        ThreadPool pool(num_threads);
+        start = std::chrono::steady_clock::now();
+        for (size_t i = 0; i < num_iterations; i++) {
+            REQUIRE(mw::BlockView::Decode(serialized.data(), serialized.size(), pool)->GetKernels().size() == txs.size());
+        }
+        elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "BlockView::Decode, " << num_threads + 1 << " threads: " << elapsed.count() / num_iterations << "us" << std::endl;
+    }
+}
+
+TEST_CASE("BlockView - Decode Memory", "[.benchmark]")
+{
+    std::vector<test::Tx> txs;
+    for (size_t i = 0; i < 100; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::Miner miner;
+    const std::vector<uint8_t> serialized = miner.MineBlock(10, txs).GetBlock()->Serialized();
+    const size_t num_blocks = 100;
+
+    {
+        const size_t heap_before = mallinfo2().uordblks;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<mw::Block::Ptr> blocks;
+        for (size_t i = 0; i < num_blocks; i++) {
+            Deserializer deserializer(serialized.data(), serialized.size());
+            blocks.push_back(std::make_shared<mw::Block>(mw::Block::Deserialize(deserializer)));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "Block::Deserialize: " << num_blocks << " blocks (" << serialized.size() << " bytes each) in " << elapsed.count() << "ms, "
+            << "holding " << (mallinfo2().uordblks - heap_before) / 1024 << " KiB of heap" << std::endl;
+    }
+
+    {
+        const size_t heap_before = mallinfo2().uordblks;
+        auto start = std::chrono::steady_clock::now();
+        std::vector<mw::BlockView> views;
+        for (size_t i = 0; i < num_blocks; i++) {
+            views.push_back(mw::BlockView::Parse(std::vector<uint8_t>(serialized)));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "BlockView::Parse: " << num_blocks << " blocks in " << elapsed.count() << "ms, "
+            << "holding " << (mallinfo2().uordblks - heap_before) / 1024 << " KiB of heap" << std::endl;
+
+        start = std::chrono::steady_clock::now();
+        for (const mw::BlockView& view : views) {
+            REQUIRE(view.GetOutputHashes().size() == view.GetNumOutputs());
+        }
+        elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+        std::cout << "BlockView::GetOutputHashes: " << num_blocks << " blocks in " << elapsed.count() << "ms" << std::endl;
+    }
+}
@@ -1,6 +1,18 @@
 #include <catch.hpp>
 
 #include <mw/models/crypto/BigInteger.h>
+#include <mw/models/crypto/Hash.h>
+#include <mw/models/crypto/Commitment.h>
+#include <mw/models/crypto/Signature.h>
+#include <mw/models/crypto/PublicKey.h>
+#include <mw/crypto/Random.h>
+#include <test_framework/Miner.h>
+
+#include <chrono>
+#include <fstream>
+#include <malloc.h>
+#include <type_traits>
+#include <unordered_map>
 
 TEST_CASE("BigInt")
 {
@@ -12,5 +24,98 @@ TEST_CASE("BigInt")
 
     BigInt<8> bigInt3 = BigInt<8>::ValueOf(12); // TODO: Pass in uint64_t
     REQUIRE(bigInt3.ToHex() == "000000000000000c");
+
+    REQUIRE(BigInt<8>().IsZero());
+    REQUIRE(bigInt3 < bigInt1);
+    REQUIRE(bigInt1 > bigInt3);
+    REQUIRE(bigInt1 <= bigInt1);
+    REQUIRE(bigInt1 >= bigInt1);
+    REQUIRE(bigInt1 != bigInt3);
+    REQUIRE((bigInt1 ^ bigInt1).IsZero());
+
+    Deserializer deserializer(Serializer().Append(bigInt1).vec());
+    REQUIRE(BigInt<8>::Deserialize(deserializer) == bigInt1);
     // TODO: Finish
-}
\ No newline at end of file
+}
+
+TEST_CASE("BigInt - Trivially Copyable")
+{
+    // Public values are stored inline, with no heap allocation or destructor.
+    REQUIRE(std::is_trivially_copyable_v<BigInt<32>>);
+    REQUIRE(std::is_trivially_copyable_v<mw::Hash>);
+    REQUIRE(std::is_trivially_copyable_v<Commitment>);
+    REQUIRE(std::is_trivially_copyable_v<Signature>);
+    REQUIRE(std::is_trivially_copyable_v<PublicKey>);
+    REQUIRE(sizeof(mw::Hash) == 32);
+    REQUIRE(sizeof(Commitment) == 33);
+
+    // Secrets wipe themselves when destroyed.
+    REQUIRE_FALSE(std::is_trivially_destructible_v<SecretKey>);
+    REQUIRE_FALSE(std::is_trivially_destructible_v<BlindingFactor>);
+}
+
+static size_t GetHeapBytes()
+{
+    return mallinfo2().uordblks;
+}
+
+static size_t GetRSSBytes()
+{
+    size_t pages = 0;
+    size_t resident = 0;
+    std::ifstream("/proc/self/statm") >> pages >> resident;
+    return resident * 4096;
+}
+
+TEST_CASE("BigInt - Memory", "[.benchmark]")
+{
+    // Block decode: deserialize copies of a block with 50 transactions.
+    {
+        std::vector<test::Tx> txs;
+        for (size_t i = 0; i < 25; i++) {
+            test::Tx pegin = test::Tx::CreatePegIn(1000);
+            txs.push_back(pegin);
+            txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+        }
+
+        test::Miner miner;
+        const std::vector<uint8_t> serialized = miner.MineBlock(10, txs).GetBlock()->Serialized();
+
+        const size_t heap_before = GetHeapBytes();
+        auto start = std::chrono::steady_clock::now();
+        std::vector<mw::Block> blocks;
+        blocks.reserve(1000);
+        for (size_t i = 0; i < 1000; i++) {
+            Deserializer deserializer(serialized);
+            blocks.push_back(mw::Block::Deserialize(deserializer));
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "BigInt: 1000 blocks (" << serialized.size() << " bytes each) deserialized in " << elapsed.count() << "ms, "
+            << "holding " << (GetHeapBytes() - heap_before) / 1024 << " KiB of heap" << std::endl;
+    }
+
+    // State load: a UTXO-like map from commitment to output hash.
+    {
+        const size_t num_entries = 1'000'000;
+        std::vector<std::pair<Commitment, mw::Hash>> entries;
+        entries.reserve(num_entries);
+        for (size_t i = 0; i < num_entries; i++) {
+            entries.push_back({ Commitment(Random::CSPRNG<33>().GetBigInt()), mw::Hash() });
+        }
+
+        const size_t heap_before = GetHeapBytes();
+        const size_t rss_before = GetRSSBytes();
+        auto start = std::chrono::steady_clock::now();
+        std::unordered_map<Commitment, mw::Hash> state;
+        state.reserve(num_entries);
+        for (const auto& entry : entries) {
+            state.insert(entry);
+        }
+        auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << "BigInt: " << num_entries << " map entries loaded in " << elapsed.count() << "ms, "
+            << "heap +" << (GetHeapBytes() - heap_before) / (1024 * 1024) << " MiB, "
+            << "RSS +" << (GetRSSBytes() - rss_before) / (1024 * 1024) << " MiB" << std::endl;
+    }
+}
@@ -4,6 +4,8 @@
 #include <mw/crypto/Random.h>
 #include <mw/models/tx/Kernel.h>
 
+#include <thread>
+
 TEST_CASE("Plain Kernel")
 {
     uint64_t fee = 1000;
@@ -276,4 +278,47 @@ TEST_CASE("Height-Locked")
     }
 }
 
+TEST_CASE("Kernel - Cached Forms")
+{
+    Commitment excess(Random::CSPRNG<33>().GetBigInt());
+    Signature signature(Random::CSPRNG<64>().GetBigInt());
+    const Kernel kernel = Kernel::CreatePlain(1000, Commitment(excess), Signature(signature));
+    const std::vector<uint8_t> serialized = kernel.Serialized();
+
+    // Threads racing to compute the cached forms must all see the same values.
+    std::vector<mw::Hash> hashes(4);
+    std::vector<mw::Hash> messages(4);
+    std::vector<std::vector<uint8_t>> serializations(4);
+    std::vector<std::thread> threads;
+    for (size_t i = 0; i < 4; i++) {
+        threads.emplace_back([&, i]() {
+            serializations[i] = kernel.GetSerialized();
+            hashes[i] = kernel.GetHash();
+            messages[i] = kernel.GetSignatureMessage();
+        });
+    }
+
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+
+    for (size_t i = 0; i < 4; i++) {
+        REQUIRE(serializations[i] == serialized);
+        REQUIRE(hashes[i] == Hashed(serialized));
+        REQUIRE(messages[i] == Hashed(Serializer().Append<uint8_t>(0).Append<uint64_t>(1000).vec()));
+    }
+
+    // The serialization is returned by reference, so it isn't copied on every call.
+    REQUIRE(&kernel.GetSerialized() == &kernel.GetSerialized());
+
+    // Copies and moves carry the cached forms with them.
+    Kernel copy = kernel;
+    REQUIRE(copy.GetSerialized() == serialized);
+    REQUIRE(copy.GetHash() == kernel.GetHash());
+
+    Kernel moved = std::move(copy);
+    REQUIRE(moved.GetSerialized() == serialized);
+    REQUIRE(moved.GetSignatureMessage() == kernel.GetSignatureMessage());
+}
+
 // TODO: Test unknown Kernel to ensure we can support soft-forking futre kernel types.
\ No newline at end of file
@@ -0,0 +1,199 @@
+#include <catch.hpp>
+
+#include <mw/node/BlockTemplateBuilder.h>
+#include <mw/consensus/Aggregation.h>
+#include <mw/node/CoinsView.h>
+#include <mw/file/ScopedFileRemover.h>
+#include <mw/node/INode.h>
+
+#include <test_framework/DBWrapper.h>
+#include <test_framework/Miner.h>
+#include <test_framework/TestUtil.h>
+
+#include <chrono>
+
+TEST_CASE("mw::BlockTemplateBuilder")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    test::Miner miner;
+
+    test::Tx pegin1 = test::Tx::CreatePegIn(1000);
+    test::Tx pegin2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { pegin1, pegin2 });
+    pNode->ConnectBlock(block1.GetBlock(), pNode->GetDBView());
+
+    // Each of these has a weight of 21
+    test::Tx txA = test::Tx::CreateSpend(pegin1.GetTxOutputs(), { 900 }, 100);
+    test::Tx txB = test::Tx::CreateSpend(txA.GetTxOutputs(), { 850 }, 50);
+    test::Tx txC = test::Tx::CreateSpend(pegin2.GetTxOutputs(), { 1990 }, 10);
+
+    auto build_from_scratch = [&pNode](const std::vector<mw::Transaction::CPtr>& txs) {
+        auto pCache = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+        return pCache->BuildNextBlock(151, txs);
+    };
+
+    ///////////////////////
+    // Matches BuildNextBlock
+    ///////////////////////
+    mw::BlockTemplateBuilder builder(pNode->GetDBView(), 151);
+
+    // The child is added first, so it's only selected once its parent shows up.
+    builder.AddTransaction(txB.GetTransaction());
+    REQUIRE_FALSE(builder.IsSelected(txB.GetTransaction()->GetHash()));
+    builder.AddTransaction(txA.GetTransaction());
+    builder.AddTransaction(txC.GetTransaction());
+    REQUIRE(builder.GetNumSelected() == 3);
+    REQUIRE(builder.GetWeight() == 63);
+    REQUIRE(builder.GetTotalFee() == 160);
+
+    mw::Block::Ptr pTemplate = builder.GetTemplate();
+    mw::Block::Ptr pExpected = build_from_scratch({ txA.GetTransaction(), txB.GetTransaction(), txC.GetTransaction() });
+    REQUIRE(pTemplate->GetHash() == pExpected->GetHash());
+    REQUIRE(pTemplate->GetInputs() == pExpected->GetInputs());
+    REQUIRE(pTemplate->GetOutputs() == pExpected->GetOutputs());
+    REQUIRE(pTemplate->GetKernels() == pExpected->GetKernels());
+
+    // Unchanged, so the same template is returned.
+    REQUIRE(builder.GetTemplate() == pTemplate);
+
+    // The base isn't modified, so templates can be built repeatedly.
+    REQUIRE(pNode->GetDBView()->GetBestHeader()->GetHash() == block1.GetHeader()->GetHash());
+
+    ///////////////////////
+    // Removing a parent drops its child
+    ///////////////////////
+    builder.RemoveTransaction(txA.GetTransaction()->GetHash());
+    REQUIRE_FALSE(builder.IsSelected(txB.GetTransaction()->GetHash()));
+    REQUIRE(builder.GetNumSelected() == 1);
+    REQUIRE(builder.GetTotalFee() == 10);
+    REQUIRE(builder.GetTemplate()->GetHash() == build_from_scratch({ txC.GetTransaction() })->GetHash());
+
+    // Adding it back reselects the child.
+    builder.AddTransaction(txA.GetTransaction());
+    REQUIRE(builder.GetNumSelected() == 3);
+    REQUIRE(builder.GetTemplate()->GetHash() == pExpected->GetHash());
+
+    ///////////////////////
+    // Weight limit
+    ///////////////////////
+    mw::BlockTemplateBuilder limited(pNode->GetDBView(), 151, 42);
+    limited.AddTransaction(txC.GetTransaction());
+    limited.AddTransaction(txA.GetTransaction());
+    REQUIRE(limited.GetNumSelected() == 2);
+
+    // txB doesn't fit, but pays a higher fee rate than txC, so it replaces txC in the next template.
+    limited.AddTransaction(txB.GetTransaction());
+    mw::Block::Ptr pLimited = limited.GetTemplate();
+    REQUIRE(limited.GetWeight() == 42);
+    REQUIRE(limited.GetTotalFee() == 150);
+    REQUIRE_FALSE(limited.IsSelected(txC.GetTransaction()->GetHash()));
+    REQUIRE(pLimited->GetHash() == build_from_scratch({ txA.GetTransaction(), txB.GetTransaction() })->GetHash());
+
+    ///////////////////////
+    // Conflicting transactions
+    ///////////////////////
+    // Both spend pegin2's output, so only the one paying the higher fee rate is selected.
+    test::Tx txConflict = test::Tx::CreateSpend(pegin2.GetTxOutputs(), { 1900 }, 100);
+    mw::BlockTemplateBuilder conflicts(pNode->GetDBView(), 151);
+    conflicts.AddTransaction(txC.GetTransaction());
+    conflicts.AddTransaction(txConflict.GetTransaction());
+    REQUIRE(conflicts.IsSelected(txC.GetTransaction()->GetHash()));
+    REQUIRE_FALSE(conflicts.IsSelected(txConflict.GetTransaction()->GetHash()));
+
+    mw::Block::Ptr pConflicts = conflicts.GetTemplate();
+    REQUIRE(conflicts.GetNumSelected() == 1);
+    REQUIRE(conflicts.IsSelected(txConflict.GetTransaction()->GetHash()));
+    REQUIRE(pConflicts->GetHash() == build_from_scratch({ txConflict.GetTransaction() })->GetHash());
+
+    // Removing the selected one lets the other take its place.
+    conflicts.RemoveTransaction(txConflict.GetTransaction()->GetHash());
+    REQUIRE(conflicts.GetTemplate()->GetHash() == build_from_scratch({ txC.GetTransaction() })->GetHash());
+
+    ///////////////////////
+    // Duplicate outputs and kernels
+    ///////////////////////
+    // The aggregate has pegin3's kernel and output but no inputs, so it doesn't conflict with pegin3 as a spend.
+    // Selecting both would count pegin3's kernel, output and offset twice.
+    test::Tx pegin3 = test::Tx::CreatePegIn(300);
+    test::Tx pegin4 = test::Tx::CreatePegIn(400);
+    mw::Transaction::CPtr pAggregate = Aggregation::Aggregate({ pegin3.GetTransaction(), pegin4.GetTransaction() });
+    mw::BlockTemplateBuilder duplicates(pNode->GetDBView(), 151);
+    duplicates.AddTransaction(pegin3.GetTransaction());
+    duplicates.AddTransaction(pAggregate);
+
+    mw::Block::Ptr pDuplicates = duplicates.GetTemplate();
+    REQUIRE(duplicates.GetNumSelected() == 1);
+    if (duplicates.IsSelected(pAggregate->GetHash())) {
+        REQUIRE(pDuplicates->GetHash() == build_from_scratch({ pAggregate })->GetHash());
+    } else {
+        REQUIRE(pDuplicates->GetHash() == build_from_scratch({ pegin3.GetTransaction() })->GetHash());
+    }
+
+    // The template is a valid block.
+    pNode->ConnectBlock(pTemplate, pNode->GetDBView());
+
+    pNode.reset();
+}
+
+TEST_CASE("mw::BlockTemplateBuilder - Emit Latency", "[.benchmark]")
+{
+    const size_t num_txs = 100;
+
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir);
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+
+    test::Miner miner;
+    std::vector<test::Tx> pegins;
+    for (size_t i = 0; i < num_txs + 1; i++) {
+        pegins.push_back(test::Tx::CreatePegIn(1000));
+    }
+
+    pNode->ConnectBlock(miner.MineBlock(150, pegins).GetBlock(), pNode->GetDBView());
+
+    std::vector<mw::Transaction::CPtr> txs;
+    for (size_t i = 0; i < num_txs + 1; i++) {
+        txs.push_back(test::Tx::CreateSpend(pegins[i].GetTxOutputs(), { 900 }, 100).GetTransaction());
+    }
+
+    mw::Transaction::CPtr pLastTx = txs.back();
+    txs.pop_back();
+
+    auto start = std::chrono::steady_clock::now();
+    auto pCache = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    pCache->BuildNextBlock(151, txs);
+    auto scratch_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    mw::BlockTemplateBuilder builder(pNode->GetDBView(), 151);
+    for (const auto& pTx : txs) {
+        builder.AddTransaction(pTx);
+    }
+
+    start = std::chrono::steady_clock::now();
+    builder.GetTemplate();
+    auto first_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    builder.GetTemplate();
+    auto cached_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    builder.AddTransaction(pLastTx);
+    builder.GetTemplate();
+    auto add_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "BlockTemplateBuilder: " << txs.size() << " txs, BuildNextBlock " << scratch_elapsed.count() << "us, "
+        << "first template " << first_elapsed.count() << "us, "
+        << "unchanged " << cached_elapsed.count() << "us, "
+        << "after adding 1 tx " << add_elapsed.count() << "us" << std::endl;
+
+    pNode.reset();
+}
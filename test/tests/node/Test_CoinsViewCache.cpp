@@ -0,0 +1,261 @@
+#include <catch.hpp>
+
+#include <mw/node/CoinsView.h>
+#include <mw/file/ScopedFileRemover.h>
+#include <mw/node/INode.h>
+
+#include <test_framework/DBWrapper.h>
+#include <test_framework/Miner.h>
+#include <test_framework/TestUtil.h>
+
+#include <algorithm>
+#include <chrono>
+
+TEST_CASE("mw::CoinsViewCache::GetMemoryUsage")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    const size_t empty_usage = pCachedView->GetMemoryUsage();
+
+    test::Miner miner;
+
+    ///////////////////////
+    // Apply Block 1
+    ///////////////////////
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(150, { block1_tx1 });
+    pCachedView->ApplyBlock(block1.GetBlock());
+
+    // At the very least, the cache holds the rangeproof and the MMR leaves for the output.
+    const size_t usage_1_block = pCachedView->GetMemoryUsage();
+    REQUIRE(usage_1_block > empty_usage + RangeProof::MAX_SIZE + 34);
+
+    ///////////////////////
+    // Apply Block 2
+    ///////////////////////
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 1000 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+    pCachedView->ApplyBlock(block2.GetBlock());
+    REQUIRE(pCachedView->GetMemoryUsage() > usage_1_block);
+
+    ///////////////////////
+    // Flush
+    ///////////////////////
+    auto pBatch = pDatabase->CreateBatch();
+    pCachedView->Flush(pBatch);
+    pBatch->Commit();
+
+    // Flushing releases all of the memory held by the cache.
+    REQUIRE(pCachedView->GetMemoryUsage() == empty_usage);
+
+    pNode.reset();
+}
+
+TEST_CASE("mw::CoinsViewDB - Flush Without Batch")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    test::Miner miner;
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(150, { block1_tx1 });
+
+    // Connecting directly to the CoinsViewDB writes the UTXOs using a batch created by the view.
+    pNode->ConnectBlock(block1.GetBlock(), pNode->GetDBView());
+
+    REQUIRE(pNode->GetDBView()->GetBestHeader() == block1.GetHeader());
+    REQUIRE(pNode->GetDBView()->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    pNode.reset();
+}
+
+TEST_CASE("mw::CoinsViewCache::FlushAsync")
+{
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    test::Tx block1_tx2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { block1_tx1, block1_tx2 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 600, 400 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    test::Tx block3_tx1 = test::Tx::CreateSpend({ block2_tx1.GetTxOutputs()[0], block1_tx2.GetTxOutputs()[0] }, { 2600 });
+    auto block3 = miner.MineBlock(152, { block3_tx1 });
+
+    // Connects all 3 blocks to a fresh node, flushing after each one, and returns the resulting DB view.
+    auto connect = [&](const bool async) {
+        FilePath datadir = test::TestUtil::GetTempDir();
+        ScopedFileRemover remover(datadir);
+
+        auto pDatabase = std::make_shared<TestDBWrapper>();
+        auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+
+        for (const auto& block : { block1, block2, block3 }) {
+            pCachedView->ApplyBlock(block.GetBlock());
+            if (async) {
+                // Block 2 spends coins from block 1 while block 1 may still be getting written.
+                pCachedView->FlushAsync();
+            } else {
+                pCachedView->Flush(nullptr);
+            }
+
+            REQUIRE(pCachedView->GetBestHeader() == block.GetHeader());
+        }
+
+        REQUIRE(pCachedView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).empty());
+        REQUIRE(pCachedView->GetUTXOs(block2_tx1.GetTxOutputs()[1].GetOutput().GetCommitment()).size() == 1);
+        REQUIRE(pCachedView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+        pCachedView->WaitForFlush();
+
+        auto pDBView = pNode->GetDBView();
+        REQUIRE(pDBView->GetBestHeader() == block3.GetHeader());
+        REQUIRE(pDBView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).empty());
+        REQUIRE(pDBView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+        std::vector<mw::Hash> roots{
+            pDBView->GetLeafSet()->Root(),
+            pDBView->GetKernelMMR()->Root(),
+            pDBView->GetOutputPMMR()->Root(),
+            pDBView->GetRangeProofPMMR()->Root()
+        };
+
+        pCachedView.reset();
+        pNode.reset();
+        return roots;
+    };
+
+    REQUIRE(connect(false) == connect(true));
+}
+
+TEST_CASE("mw::CoinsViewCache::FlushAsync - Failure")
+{
+    // Fails every batch commit once 'fail' is set.
+    class FailingDBWrapper : public libmw::IDBWrapper
+    {
+    public:
+        class FailingBatch : public libmw::IDBBatch
+        {
+        public:
+            void Write(const std::string&, const std::vector<uint8_t>&) final { }
+            void Erase(const std::string&) final { }
+            void Commit() final { throw std::runtime_error("Commit failed"); }
+        };
+
+        bool Read(const std::string& key, std::vector<uint8_t>& value) const final { return m_db.Read(key, value); }
+        std::unique_ptr<libmw::IDBIterator> NewIterator() final { return m_db.NewIterator(); }
+        std::unique_ptr<libmw::IDBBatch> CreateBatch() final
+        {
+            return fail ? std::unique_ptr<libmw::IDBBatch>(new FailingBatch()) : m_db.CreateBatch();
+        }
+
+        bool fail = false;
+
+    private:
+        TestDBWrapper m_db;
+    };
+
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir);
+
+    auto pDatabase = std::make_shared<FailingDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+
+    test::Miner miner;
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(150, { block1_tx1 });
+    test::Tx block2_tx1 = test::Tx::CreatePegIn(2000);
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    pDatabase->fail = true;
+    pCachedView->ApplyBlock(block1.GetBlock());
+    pCachedView->FlushAsync();
+    REQUIRE_THROWS_WITH(pCachedView->WaitForFlush(), "Commit failed");
+
+    // The cache stays readable, but never flushes again, even once the database recovers.
+    pDatabase->fail = false;
+    REQUIRE(pCachedView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE_THROWS_WITH(pCachedView->WaitForFlush(), "Commit failed");
+
+    pCachedView->ApplyBlock(block2.GetBlock());
+    REQUIRE_THROWS_WITH(pCachedView->FlushAsync(), "Commit failed");
+    REQUIRE_THROWS_WITH(pCachedView->Flush(nullptr), "Commit failed");
+    REQUIRE(pNode->GetDBView()->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).empty());
+
+    pCachedView.reset();
+    pNode.reset();
+}
+
+TEST_CASE("mw::CoinsViewCache::FlushAsync - Latency", "[.benchmark]")
+{
+    const size_t num_blocks = 200;
+    const size_t flush_interval = 10;
+
+    test::Miner miner;
+    std::vector<mw::Block::Ptr> blocks;
+    std::vector<test::Tx> prev_pegins;
+    for (size_t i = 0; i < num_blocks; i++) {
+        std::vector<test::Tx> pegins{ test::Tx::CreatePegIn(1000), test::Tx::CreatePegIn(2000) };
+        std::vector<test::Tx> txs = pegins;
+        for (const test::Tx& prev_pegin : prev_pegins) {
+            const test::TxOutput& output = prev_pegin.GetTxOutputs().front();
+            txs.push_back(test::Tx::CreateSpend({ output }, { output.GetAmount() }));
+        }
+
+        blocks.push_back(miner.MineBlock(150 + i, txs).GetBlock());
+        prev_pegins = pegins;
+    }
+
+    // Connects the blocks, flushing every flush_interval blocks, and prints the distribution
+    // of the time taken per block, including the time spent flushing after it.
+    auto connect = [&blocks, flush_interval](const bool async) {
+        FilePath datadir = test::TestUtil::GetTempDir();
+        ScopedFileRemover remover(datadir);
+
+        auto pDatabase = std::make_shared<TestDBWrapper>();
+        auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+
+        std::vector<int64_t> latencies;
+        for (size_t i = 0; i < blocks.size(); i++) {
+            auto start = std::chrono::steady_clock::now();
+            pCachedView->ApplyBlock(blocks[i]);
+            if ((i + 1) % flush_interval == 0) {
+                if (async) {
+                    pCachedView->FlushAsync();
+                } else {
+                    pCachedView->Flush(nullptr);
+                }
+            }
+
+            latencies.push_back(std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+
+        pCachedView->WaitForFlush();
+        mw::Hash output_root = pNode->GetDBView()->GetOutputPMMR()->Root();
+        pCachedView.reset();
+        pNode.reset();
+
+        std::sort(latencies.begin(), latencies.end());
+        auto percentile = [&latencies](const size_t pct) { return latencies[(latencies.size() - 1) * pct / 100]; };
+        std::cout << (async ? "FlushAsync: " : "Flush: ")
+            << "p50=" << percentile(50) << "us p90=" << percentile(90) << "us p99=" << percentile(99)
+            << "us max=" << latencies.back() << "us" << std::endl;
+        return output_root;
+    };
+
+    REQUIRE(connect(false) == connect(true));
+}
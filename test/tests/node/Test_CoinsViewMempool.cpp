@@ -0,0 +1,169 @@
+#include <catch.hpp>
+
+#include <mw/node/CoinsView.h>
+#include <mw/file/ScopedFileRemover.h>
+#include <mw/node/INode.h>
+#include <mw/exceptions/ValidationException.h>
+
+#include <test_framework/DBWrapper.h>
+#include <test_framework/Miner.h>
+#include <test_framework/TestUtil.h>
+
+#include <chrono>
+
+TEST_CASE("mw::CoinsViewMempool")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    test::Miner miner;
+
+    test::Tx pegin1 = test::Tx::CreatePegIn(1000);
+    test::Tx pegin2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { pegin1, pegin2 });
+    pNode->ConnectBlock(block1.GetBlock(), pNode->GetDBView());
+
+    auto pMempool = std::make_shared<mw::CoinsViewMempool>(pNode->GetDBView());
+
+    ///////////////////////
+    // Admission
+    ///////////////////////
+    test::Tx txA = test::Tx::CreateSpend(pegin1.GetTxOutputs(), { 600, 400 });
+    pMempool->AddTransaction(txA.GetTransaction());
+
+    // Chained spend of an unconfirmed output
+    test::Tx txB = test::Tx::CreateSpend({ txA.GetTxOutputs()[0] }, { 600 });
+    pMempool->AddTransaction(txB.GetTransaction());
+
+    test::Tx txC = test::Tx::CreateSpend(pegin2.GetTxOutputs(), { 2000 });
+    pMempool->AddTransaction(txC.GetTransaction());
+
+    test::Tx txD = test::Tx::CreateSpend({ txC.GetTxOutputs()[0] }, { 2000 });
+    pMempool->AddTransaction(txD.GetTransaction());
+    REQUIRE(pMempool->GetNumTransactions() == 4);
+
+    // Double spends of confirmed and unconfirmed outputs
+    test::Tx conflict1 = test::Tx::CreateSpend(pegin2.GetTxOutputs(), { 1500, 500 });
+    REQUIRE_THROWS_AS(pMempool->AddTransaction(conflict1.GetTransaction()), ValidationException);
+    test::Tx conflict2 = test::Tx::CreateSpend({ txA.GetTxOutputs()[0] }, { 600 });
+    REQUIRE_THROWS_AS(pMempool->AddTransaction(conflict2.GetTransaction()), ValidationException);
+
+    // Spends an output that doesn't exist
+    test::Tx missing = test::Tx::CreateSpend(test::Tx::CreatePegIn(500).GetTxOutputs(), { 500 });
+    REQUIRE_THROWS_AS(pMempool->AddTransaction(missing.GetTransaction()), ValidationException);
+    REQUIRE(pMempool->GetNumTransactions() == 4);
+
+    // UTXOs reflect the unconfirmed transactions, while the base is untouched.
+    REQUIRE(pMempool->GetUTXOs(pegin1.GetOutputs()[0].GetCommitment()).empty());
+    REQUIRE(pNode->GetDBView()->GetUTXOs(pegin1.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pMempool->GetUTXOs(txA.GetOutputs()[0].GetCommitment()).empty());
+    REQUIRE(pMempool->GetUTXOs(txA.GetOutputs()[1].GetCommitment()).size() == 1);
+    REQUIRE(pMempool->GetUTXOs(txA.GetOutputs()[1].GetCommitment()).front()->GetBlockHeight() == mw::CoinsViewMempool::UNCONFIRMED_HEIGHT);
+
+    ///////////////////////
+    // Remove For Block
+    ///////////////////////
+    // Block 2 confirms txA, and spends pegin2 in a transaction that conflicts with txC.
+    auto block2 = miner.MineBlock(151, { txA, conflict1 });
+    pNode->ConnectBlock(block2.GetBlock(), pNode->GetDBView());
+
+    std::vector<mw::Transaction::CPtr> removed = pMempool->RemoveForBlock(block2.GetBlock());
+    REQUIRE(removed.size() == 3);
+    REQUIRE(!pMempool->HasTransaction(txA.GetTransaction()->GetHash()));
+    REQUIRE(!pMempool->HasTransaction(txC.GetTransaction()->GetHash()));
+    REQUIRE(!pMempool->HasTransaction(txD.GetTransaction()->GetHash()));
+
+    // txB still spends txA's output, which is now confirmed.
+    REQUIRE(pMempool->HasTransaction(txB.GetTransaction()->GetHash()));
+    REQUIRE(pMempool->GetUTXOs(txA.GetOutputs()[0].GetCommitment()).empty());
+    REQUIRE(pNode->GetDBView()->GetUTXOs(txA.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pMempool->GetUTXOs(txC.GetOutputs()[0].GetCommitment()).empty());
+
+    ///////////////////////
+    // Remove Transaction
+    ///////////////////////
+    test::Tx txE = test::Tx::CreateSpend({ txB.GetTxOutputs()[0] }, { 600 });
+    pMempool->AddTransaction(txE.GetTransaction());
+    REQUIRE(pMempool->RemoveTransaction(txB.GetTransaction()->GetHash()).size() == 2);
+    REQUIRE(pMempool->GetNumTransactions() == 0);
+    REQUIRE(pMempool->GetUTXOs(txA.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    // A chain of descendants is removed along with its root, each parent before its children.
+    std::vector<test::Tx> chain{ test::Tx::CreateSpend({ txA.GetTxOutputs()[0] }, { 600 }) };
+    for (size_t i = 1; i < 10; i++) {
+        chain.push_back(test::Tx::CreateSpend({ chain.back().GetTxOutputs()[0] }, { 600 }));
+    }
+
+    for (const test::Tx& tx : chain) {
+        pMempool->AddTransaction(tx.GetTransaction());
+    }
+
+    removed = pMempool->RemoveTransaction(chain.front().GetTransaction()->GetHash());
+    REQUIRE(removed.size() == chain.size());
+    for (size_t i = 0; i < chain.size(); i++) {
+        REQUIRE(removed[i]->GetHash() == chain[i].GetTransaction()->GetHash());
+    }
+    REQUIRE(pMempool->GetNumTransactions() == 0);
+
+    pNode.reset();
+}
+
+TEST_CASE("mw::CoinsViewMempool - Admission Throughput", "[.benchmark]")
+{
+    const size_t num_txs = 1000;
+
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir);
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+
+    test::Miner miner;
+    std::vector<test::Tx> pegins;
+    for (size_t i = 0; i < num_txs; i++) {
+        pegins.push_back(test::Tx::CreatePegIn(1000));
+    }
+
+    pNode->ConnectBlock(miner.MineBlock(150, pegins).GetBlock(), pNode->GetDBView());
+
+    // Half of the transactions spend confirmed outputs, and the other half spend those unconfirmed outputs.
+    std::vector<mw::Transaction::CPtr> txs;
+    for (size_t i = 0; i < num_txs / 2; i++) {
+        test::Tx parent = test::Tx::CreateSpend(pegins[i].GetTxOutputs(), { 1000 });
+        test::Tx child = test::Tx::CreateSpend(parent.GetTxOutputs(), { 1000 });
+        txs.push_back(parent.GetTransaction());
+        txs.push_back(child.GetTransaction());
+    }
+
+    auto pMempool = std::make_shared<mw::CoinsViewMempool>(pNode->GetDBView());
+
+    auto start = std::chrono::steady_clock::now();
+    for (const auto& pTx : txs) {
+        pMempool->AddTransaction(pTx);
+    }
+    auto add_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Every transaction conflicts with one already admitted.
+    start = std::chrono::steady_clock::now();
+    for (const auto& pTx : txs) {
+        REQUIRE_THROWS(pMempool->AddTransaction(std::make_shared<mw::Transaction>(BlindingFactor(pTx->GetOffset()), TxBody(pTx->GetInputs(), {}, {}))));
+    }
+    auto reject_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    start = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < txs.size(); i += 2) {
+        pMempool->RemoveTransaction(txs[i]->GetHash());
+    }
+    auto remove_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+    REQUIRE(pMempool->GetNumTransactions() == 0);
+
+    std::cout << "CoinsViewMempool: " << txs.size() << " txs added in " << add_elapsed.count() << "us, "
+        << "double spends rejected in " << reject_elapsed.count() << "us, "
+        << "removed in " << remove_elapsed.count() << "us" << std::endl;
+
+    pNode.reset();
+}
@@ -0,0 +1,647 @@
+#include <catch.hpp>
+
+#include <mw/node/CoinsView.h>
+#include <mw/file/ScopedFileRemover.h>
+#include <mw/node/INode.h>
+#include <mw/exceptions/ConnectBlocksException.h>
+#include <mw/exceptions/NotFoundException.h>
+#include <mw/exceptions/ValidationException.h>
+#include <mw/consensus/BlockSumValidator.h>
+#include <mw/db/CoinDB.h>
+
+#include <test_framework/DBWrapper.h>
+#include <test_framework/Miner.h>
+#include <test_framework/TestUtil.h>
+
+#include <algorithm>
+#include <map>
+#include <chrono>
+
+// Serves blocks by height, standing in for the consumer's block database.
+class TestBlockStore : public mw::IBlockStore
+{
+public:
+    TestBlockStore(const std::vector<mw::Block::Ptr>& blocks)
+    {
+        for (const auto& pBlock : blocks) {
+            m_blocks[pBlock->GetHeight()] = pBlock;
+        }
+    }
+
+    mw::Header::CPtr GetHeader(const uint64_t height) const final { return GetBlock(height)->GetHeader(); }
+    mw::Header::CPtr GetHeader(const mw::Hash&) const final { ThrowNotFound("Not implemented"); }
+
+    mw::HeaderAndPegs::CPtr GetHeaderAndPegs(const uint64_t) const final { ThrowNotFound("Not implemented"); }
+    mw::HeaderAndPegs::CPtr GetHeaderAndPegs(const mw::Hash&) const final { ThrowNotFound("Not implemented"); }
+
+    mw::Block::CPtr GetBlock(const uint64_t height) const final
+    {
+        auto iter = m_blocks.find(height);
+        if (iter == m_blocks.cend()) {
+            ThrowNotFound_F("Block {} not found", height);
+        }
+
+        return iter->second;
+    }
+    mw::Block::CPtr GetBlock(const mw::Hash&) const final { ThrowNotFound("Not implemented"); }
+
+private:
+    std::map<uint64_t, mw::Block::CPtr> m_blocks;
+};
+
+static void CompareViews(const mw::ICoinsView::Ptr& pView1, const mw::ICoinsView::Ptr& pView2)
+{
+    REQUIRE(pView1->GetBestHeader() == pView2->GetBestHeader());
+    REQUIRE(pView1->GetLeafSet()->Root() == pView2->GetLeafSet()->Root());
+    REQUIRE(pView1->GetKernelMMR()->Root() == pView2->GetKernelMMR()->Root());
+    REQUIRE(pView1->GetOutputPMMR()->Root() == pView2->GetOutputPMMR()->Root());
+    REQUIRE(pView1->GetRangeProofPMMR()->Root() == pView2->GetRangeProofPMMR()->Root());
+}
+
+TEST_CASE("Node::ConnectBlocks")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    auto pDBView = pNode->GetDBView();
+
+    ///////////////////////
+    // Mine Chain
+    ///////////////////////
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    test::Tx block1_tx2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { block1_tx1, block1_tx2 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 600, 400 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    // Spends an output created in the previous block, and one created 2 blocks back.
+    test::Tx block3_tx1 = test::Tx::CreateSpend(
+        { block2_tx1.GetTxOutputs()[0], block1_tx2.GetTxOutputs()[0] },
+        { 2600 }
+    );
+    test::Tx block3_tx2 = test::Tx::CreatePegIn(500);
+    auto block3 = miner.MineBlock(152, { block3_tx1, block3_tx2 });
+
+    std::vector<mw::Block::Ptr> blocks{ block1.GetBlock(), block2.GetBlock(), block3.GetBlock() };
+
+    ///////////////////////
+    // Connect Sequentially
+    ///////////////////////
+    auto pSequentialView = std::make_shared<mw::CoinsViewCache>(pDBView);
+    std::vector<mw::BlockUndo::CPtr> sequentialUndos;
+    for (const auto& pBlock : blocks) {
+        sequentialUndos.push_back(pNode->ConnectBlock(pBlock, pSequentialView));
+    }
+
+    ///////////////////////
+    // Connect All At Once
+    ///////////////////////
+    auto pBatchedView = std::make_shared<mw::CoinsViewCache>(pDBView);
+    std::vector<mw::BlockUndo::CPtr> batchedUndos = pNode->ConnectBlocks(blocks, pBatchedView, 0);
+
+    ///////////////////////
+    // Compare Results
+    ///////////////////////
+    CompareViews(pSequentialView, pBatchedView);
+    REQUIRE(pBatchedView->GetBestHeader() == block3.GetHeader());
+
+    REQUIRE(batchedUndos.size() == sequentialUndos.size());
+    for (size_t i = 0; i < batchedUndos.size(); i++) {
+        REQUIRE(batchedUndos[i]->Serialized() == sequentialUndos[i]->Serialized());
+    }
+
+    REQUIRE(batchedUndos[2]->GetCoinsSpent().size() == 2);
+
+    std::vector<test::Tx> txs{ block1_tx1, block1_tx2, block2_tx1, block3_tx1, block3_tx2 };
+    for (const test::Tx& tx : txs) {
+        for (const Output& output : tx.GetOutputs()) {
+            REQUIRE(pBatchedView->GetUTXOs(output.GetCommitment()).size() == pSequentialView->GetUTXOs(output.GetCommitment()).size());
+        }
+    }
+
+    REQUIRE(pBatchedView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).empty());
+    REQUIRE(pBatchedView->GetUTXOs(block2_tx1.GetTxOutputs()[0].GetOutput().GetCommitment()).empty());
+    REQUIRE(pBatchedView->GetUTXOs(block2_tx1.GetTxOutputs()[1].GetOutput().GetCommitment()).size() == 1);
+    REQUIRE(pBatchedView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    ///////////////////////
+    // Disconnect Blocks 3 & 2
+    ///////////////////////
+    pNode->DisconnectBlock(batchedUndos[2], pBatchedView);
+    pNode->DisconnectBlock(batchedUndos[1], pBatchedView);
+
+    REQUIRE(pBatchedView->GetBestHeader() == block1.GetHeader());
+    REQUIRE(pBatchedView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pBatchedView->GetUTXOs(block1_tx2.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pBatchedView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).empty());
+
+    ///////////////////////
+    // Connect To DB With Budget
+    ///////////////////////
+    // A budget of 1 byte causes a flush to the CoinsViewDB after every block.
+    auto pDBUndos = pNode->ConnectBlocks(blocks, pDBView, 1);
+    CompareViews(pSequentialView, pDBView);
+    for (size_t i = 0; i < pDBUndos.size(); i++) {
+        REQUIRE(pDBUndos[i]->Serialized() == sequentialUndos[i]->Serialized());
+    }
+
+    REQUIRE(pDBView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).empty());
+    REQUIRE(pDBView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    pNode.reset();
+}
+
+TEST_CASE("Node::ConnectBlocks - Failure")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, std::make_shared<TestDBWrapper>());
+    auto pDBView = pNode->GetDBView();
+
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    auto block1 = miner.MineBlock(150, { block1_tx1 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 1000 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    test::Tx block3_tx1 = test::Tx::CreatePegIn(500);
+    auto block3 = miner.MineBlock(152, { block3_tx1 });
+
+    // Pegs out more than was pegged in, which is only caught when the block is applied.
+    const Kernel& kernel = block3_tx1.GetTransaction()->GetKernels().front();
+    Kernel pegout = Kernel::CreatePegOut(
+        2000,
+        0,
+        Bech32Address("ltc", std::vector<uint8_t>(20, 1)),
+        Commitment(kernel.GetCommitment()),
+        Signature(kernel.GetSignature())
+    );
+    auto block4 = miner.MineBlock(153, { test::Tx::Builder().AddKernel(pegout).Build() });
+
+    std::vector<mw::Block::Ptr> blocks{ block1.GetBlock(), block2.GetBlock(), block3.GetBlock(), block4.GetBlock() };
+
+    // A budget that's exceeded after block 2 (but not block 1), so block 3 is applied but not flushed when block 4 fails.
+    const size_t budget = [&]() {
+        auto pCache = std::make_shared<mw::CoinsViewCache>(pDBView);
+        pCache->ApplyBlock(block1.GetBlock());
+        return pCache->GetMemoryUsage();
+    }();
+
+    std::vector<mw::BlockUndo::CPtr> undos;
+    try
+    {
+        pNode->ConnectBlocks(blocks, pDBView, budget);
+        FAIL("Block 4 should fail to connect");
+    }
+    catch (const ConnectBlocksException& e)
+    {
+        REQUIRE(e.GetFailedIndex() == 3);
+        REQUIRE_THROWS_AS(std::rethrow_exception(e.GetCause()), ValidationException);
+        undos = e.GetUndos();
+    }
+
+    // Every block before the failed one is connected, including the one that wasn't flushed yet.
+    REQUIRE(undos.size() == 3);
+    REQUIRE(pDBView->GetBestHeader()->GetHash() == block3.GetHeader()->GetHash());
+    REQUIRE(pDBView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    // So they can all be disconnected.
+    pNode->DisconnectBlocks({ undos[2], undos[1] }, pDBView);
+    REQUIRE(pDBView->GetBestHeader()->GetHash() == block1.GetHeader()->GetHash());
+    REQUIRE(pDBView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pDBView->GetUTXOs(block3_tx1.GetOutputs()[0].GetCommitment()).empty());
+
+    pNode.reset();
+}
+
+TEST_CASE("Node::ConnectBlocks - Throughput", "[.benchmark]")
+{
+    const size_t num_blocks = 100;
+
+    test::Miner miner;
+    std::vector<mw::Block::Ptr> blocks;
+    std::vector<test::Tx> prev_pegins;
+    for (size_t i = 0; i < num_blocks; i++) {
+        // Each block pegs in 2 new coins, and spends the 2 coins pegged-in by the previous block.
+        std::vector<test::Tx> pegins{ test::Tx::CreatePegIn(1000), test::Tx::CreatePegIn(2000) };
+        std::vector<test::Tx> txs = pegins;
+        for (const test::Tx& prev_pegin : prev_pegins) {
+            const test::TxOutput& output = prev_pegin.GetTxOutputs().front();
+            txs.push_back(test::Tx::CreateSpend({ output }, { output.GetAmount() }));
+        }
+
+        blocks.push_back(miner.MineBlock(150 + i, txs).GetBlock());
+        prev_pegins = pegins;
+    }
+
+    // Consumers validate each block before connecting it, which leaves its commitments parsed and cached.
+    BlindingFactor prev_offset;
+    for (const auto& pBlock : blocks) {
+        BlockSumValidator::ValidateForBlock(pBlock->GetTxBody(), pBlock->GetOffset(), prev_offset);
+        prev_offset = pBlock->GetOffset();
+    }
+
+    auto connect = [&blocks](const bool batched) {
+        FilePath datadir = test::TestUtil::GetTempDir();
+        ScopedFileRemover remover(datadir);
+
+        auto pDatabase = std::make_shared<TestDBWrapper>();
+        auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+
+        auto start = std::chrono::steady_clock::now();
+        if (batched) {
+            pNode->ConnectBlocks(blocks, pCachedView, 0);
+
+            auto pBatch = pDatabase->CreateBatch();
+            pCachedView->Flush(pBatch);
+            pBatch->Commit();
+        } else {
+            for (const auto& pBlock : blocks) {
+                pNode->ConnectBlock(pBlock, pCachedView);
+
+                auto pBatch = pDatabase->CreateBatch();
+                pCachedView->Flush(pBatch);
+                pBatch->Commit();
+            }
+        }
+
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+        mw::Hash output_root = pNode->GetDBView()->GetOutputPMMR()->Root();
+        pNode.reset();
+
+        std::cout << (batched ? "ConnectBlocks: " : "ConnectBlock: ") << num_blocks << " blocks in " << elapsed.count() << "us" << std::endl;
+        return output_root;
+    };
+
+    REQUIRE(connect(false) == connect(true));
+}
+
+TEST_CASE("Node::DisconnectBlocks")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    test::Tx block1_tx2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { block1_tx1, block1_tx2 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 600, 400 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    // Spends an output created in block 2, which is also being disconnected.
+    test::Tx block3_tx1 = test::Tx::CreateSpend({ block2_tx1.GetTxOutputs()[0], block1_tx2.GetTxOutputs()[0] }, { 2600 });
+    test::Tx block3_tx2 = test::Tx::CreatePegIn(500);
+    auto block3 = miner.MineBlock(152, { block3_tx1, block3_tx2 });
+
+    auto undos = pNode->ConnectBlocks({ block1.GetBlock(), block2.GetBlock(), block3.GetBlock() }, pNode->GetDBView(), 0);
+
+    ///////////////////////
+    // Disconnect One At A Time
+    ///////////////////////
+    auto pSequentialView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    pNode->DisconnectBlock(undos[2], pSequentialView);
+    pNode->DisconnectBlock(undos[1], pSequentialView);
+
+    ///////////////////////
+    // Disconnect All At Once
+    ///////////////////////
+    auto pBatchedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    pNode->DisconnectBlocks({ undos[2], undos[1] }, pBatchedView);
+
+    CompareViews(pSequentialView, pBatchedView);
+    REQUIRE(pBatchedView->GetBestHeader() == block1.GetHeader());
+
+    std::vector<test::Tx> txs{ block1_tx1, block1_tx2, block2_tx1, block3_tx1, block3_tx2 };
+    for (const test::Tx& tx : txs) {
+        for (const Output& output : tx.GetOutputs()) {
+            REQUIRE(pBatchedView->GetUTXOs(output.GetCommitment()).size() == pSequentialView->GetUTXOs(output.GetCommitment()).size());
+        }
+    }
+
+    REQUIRE(pBatchedView->GetUTXOs(block1_tx1.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pBatchedView->GetUTXOs(block1_tx2.GetOutputs()[0].GetCommitment()).size() == 1);
+    REQUIRE(pBatchedView->GetUTXOs(block2_tx1.GetTxOutputs()[0].GetOutput().GetCommitment()).empty());
+    REQUIRE(pBatchedView->GetUTXOs(block3_tx2.GetOutputs()[0].GetCommitment()).empty());
+
+    ///////////////////////
+    // Reconnect
+    ///////////////////////
+    pNode->ConnectBlocks({ block2.GetBlock(), block3.GetBlock() }, pBatchedView, 0);
+    CompareViews(pNode->GetDBView(), pBatchedView);
+
+    pNode.reset();
+}
+
+TEST_CASE("Node - State Aggregates")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode->GetDBView()->GetAggregates() != nullptr);
+
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    test::Tx block1_tx2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { block1_tx1, block1_tx2 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 600, 400 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    test::Tx block3_tx1 = test::Tx::CreateSpend({ block2_tx1.GetTxOutputs()[0], block1_tx2.GetTxOutputs()[0] }, { 2600 });
+    test::Tx block3_tx2 = test::Tx::CreatePegIn(500);
+    auto block3 = miner.MineBlock(152, { block3_tx1, block3_tx2 });
+
+    pNode->ConnectBlocks({ block1.GetBlock(), block2.GetBlock() }, pNode->GetDBView(), 0);
+    mw::StateAggregates::CPtr pBlock2Aggregates = pNode->GetDBView()->GetAggregates();
+    REQUIRE(pBlock2Aggregates->GetHeaderHash() == block2.GetHeader()->GetHash());
+    REQUIRE(pBlock2Aggregates->GetPeggedSupply() == 3000);
+
+    auto undos = pNode->ConnectBlocks({ block3.GetBlock() }, pNode->GetDBView(), 0);
+    mw::StateAggregates::CPtr pBlock3Aggregates = pNode->GetDBView()->GetAggregates();
+    REQUIRE(pBlock3Aggregates->GetHeaderHash() == block3.GetHeader()->GetHash());
+    REQUIRE(pBlock3Aggregates->GetPeggedSupply() == 3500);
+    BlockSumValidator::ValidateAggregates(*pBlock3Aggregates, block3.GetHeader()->GetOffset());
+
+    // A block pegging out more than the pegged supply is rejected when it's applied, not when it's flushed.
+    {
+        const Kernel& kernel = block3_tx2.GetTransaction()->GetKernels().front();
+        Kernel pegout = Kernel::CreatePegOut(
+            3501,
+            0,
+            Bech32Address("ltc", std::vector<uint8_t>(20, 1)),
+            Commitment(kernel.GetCommitment()),
+            Signature(kernel.GetSignature())
+        );
+        auto block4 = miner.MineBlock(153, { test::Tx::Builder().AddKernel(pegout).Build() });
+
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+        REQUIRE_THROWS_WITH(pCachedView->ApplyBlock(block4.GetBlock()), Catch::Contains("BLOCK_SUMS"));
+        REQUIRE(pCachedView->GetBestHeader()->GetHash() == block3.GetHeader()->GetHash());
+    }
+
+    // Disconnecting block 3 restores the totals as of block 2.
+    {
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+        pNode->DisconnectBlock(undos.front(), pCachedView);
+        REQUIRE(pCachedView->GetAggregates()->Serialized() == pBlock2Aggregates->Serialized());
+    }
+
+    // The totals are saved, so they're checked without re-summing the state on restart.
+    pNode.reset();
+    pNode = mw::InitializeNode(datadir, "unittest", block3.GetHeader(), pDatabase);
+    REQUIRE(pNode->GetDBView()->GetAggregates()->Serialized() == pBlock3Aggregates->Serialized());
+    pNode.reset();
+
+    // Totals that don't balance are rejected, but an audit recomputes them from the state.
+    {
+        mw::StateAggregates::CPtr pWrongAggregates = std::make_shared<mw::StateAggregates>(
+            block3.GetHeader()->GetHash(),
+            pBlock3Aggregates->GetUTXOSum(),
+            pBlock3Aggregates->GetKernelSum(),
+            3501
+        );
+
+        auto pBatch = pDatabase->CreateBatch();
+        CoinDB(pDatabase.get(), pBatch.get()).WriteAggregates(pWrongAggregates);
+        pBatch->Commit();
+    }
+
+    REQUIRE_THROWS_AS(mw::InitializeNode(datadir, "unittest", block3.GetHeader(), pDatabase), ValidationException);
+
+    pNode = mw::InitializeNode(datadir, "unittest", block3.GetHeader(), pDatabase, true);
+    REQUIRE(pNode->GetDBView()->GetAggregates()->Serialized() == pBlock3Aggregates->Serialized());
+    pNode.reset();
+
+    // A database without saved totals, e.g. one written before they were tracked, is audited automatically.
+    {
+        auto pBatch = pDatabase->CreateBatch();
+        pBatch->Erase("Atip");
+        pBatch->Commit();
+    }
+
+    pNode = mw::InitializeNode(datadir, "unittest", block3.GetHeader(), pDatabase);
+    REQUIRE(pNode->GetDBView()->GetAggregates() != nullptr);
+    REQUIRE(pNode->GetDBView()->GetAggregates()->Serialized() == pBlock3Aggregates->Serialized());
+    pNode.reset();
+}
+
+TEST_CASE("Node::DisconnectBlocks - Reorg Depth", "[.benchmark]")
+{
+    // One more than the deepest reorg, since the first block can't be disconnected.
+    const size_t num_blocks = 101;
+
+    test::Miner miner;
+    std::vector<mw::Block::Ptr> blocks;
+    std::vector<test::Tx> prev_pegins;
+    for (size_t i = 0; i < num_blocks; i++) {
+        std::vector<test::Tx> pegins{ test::Tx::CreatePegIn(1000), test::Tx::CreatePegIn(2000) };
+        std::vector<test::Tx> txs = pegins;
+        for (const test::Tx& prev_pegin : prev_pegins) {
+            const test::TxOutput& output = prev_pegin.GetTxOutputs().front();
+            txs.push_back(test::Tx::CreateSpend({ output }, { output.GetAmount() }));
+        }
+
+        blocks.push_back(miner.MineBlock(150 + i, txs).GetBlock());
+        prev_pegins = pegins;
+    }
+
+    // Consumers validate each block before connecting it, which leaves its commitments parsed and cached.
+    BlindingFactor prev_offset;
+    for (const auto& pBlock : blocks) {
+        BlockSumValidator::ValidateForBlock(pBlock->GetTxBody(), pBlock->GetOffset(), prev_offset);
+        prev_offset = pBlock->GetOffset();
+    }
+
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir);
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    auto undos = pNode->ConnectBlocks(blocks, pNode->GetDBView(), 0);
+    std::reverse(undos.begin(), undos.end());
+
+    for (const size_t depth : { 1, 10, 20, 50, 100 }) {
+        std::vector<mw::BlockUndo::CPtr> reorg_undos(undos.cbegin(), undos.cbegin() + depth);
+
+        // Each reorg is undone in a cache, so the CoinsViewDB stays at the tip.
+        auto pSequentialView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+        auto start = std::chrono::steady_clock::now();
+        for (const auto& pUndo : reorg_undos) {
+            pNode->DisconnectBlock(pUndo, pSequentialView);
+        }
+        auto sequential = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        auto pBatchedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+        start = std::chrono::steady_clock::now();
+        pNode->DisconnectBlocks(reorg_undos, pBatchedView);
+        auto batched = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        CompareViews(pSequentialView, pBatchedView);
+        std::cout << "Depth " << depth << ": DisconnectBlock " << sequential.count() << "us, DisconnectBlocks " << batched.count() << "us" << std::endl;
+    }
+
+    pNode.reset();
+}
+
+TEST_CASE("Node::ExpandUndo")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    REQUIRE(pNode != nullptr);
+
+    test::Miner miner;
+
+    test::Tx block1_tx1 = test::Tx::CreatePegIn(1000);
+    test::Tx block1_tx2 = test::Tx::CreatePegIn(2000);
+    auto block1 = miner.MineBlock(150, { block1_tx1, block1_tx2 });
+
+    test::Tx block2_tx1 = test::Tx::CreateSpend(block1_tx1.GetTxOutputs(), { 600, 400 });
+    auto block2 = miner.MineBlock(151, { block2_tx1 });
+
+    test::Tx block3_tx1 = test::Tx::CreateSpend({ block2_tx1.GetTxOutputs()[0], block1_tx2.GetTxOutputs()[0] }, { 2600 });
+    auto block3 = miner.MineBlock(152, { block3_tx1 });
+
+    std::vector<mw::Block::Ptr> blocks{ block1.GetBlock(), block2.GetBlock(), block3.GetBlock() };
+    auto undos = pNode->ConnectBlocks(blocks, pNode->GetDBView(), 0);
+    REQUIRE(undos[2]->GetCoinsSpent().size() == 2);
+
+    ///////////////////////
+    // Serialize
+    ///////////////////////
+    std::vector<uint8_t> compact_bytes = mw::CompactBlockUndo::FromUndo(*undos[2]).Serialized();
+    REQUIRE(compact_bytes.size() < undos[2]->Serialized().size() / 5);
+
+    Deserializer deserializer{ compact_bytes };
+    auto pCompactUndo = std::make_shared<mw::CompactBlockUndo>(mw::CompactBlockUndo::Deserialize(deserializer));
+    REQUIRE(pCompactUndo->Serialized() == compact_bytes);
+
+    ///////////////////////
+    // Expand From MMRs
+    ///////////////////////
+    auto pExpanded = pNode->ExpandUndo(pCompactUndo, pNode->GetDBView(), nullptr);
+    REQUIRE(pExpanded->Serialized() == undos[2]->Serialized());
+
+    // Also works through a cache, where the leaves may not have been flushed yet.
+    auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    pNode->DisconnectBlock(undos[2], pCachedView);
+    pNode->ConnectBlock(block3.GetBlock(), pCachedView);
+    REQUIRE(pNode->ExpandUndo(pCompactUndo, pCachedView, nullptr)->Serialized() == undos[2]->Serialized());
+
+    ///////////////////////
+    // Expand From Block Store
+    ///////////////////////
+    {
+        // A node with empty MMRs has none of the leaves, just like after pruning.
+        FilePath datadir2 = test::TestUtil::GetTempDir();
+        ScopedFileRemover remover2(datadir2);
+        auto pNode2 = mw::InitializeNode(datadir2, "unittest", nullptr, std::make_shared<TestDBWrapper>());
+
+        TestBlockStore blockStore(blocks);
+        auto pFromBlocks = pNode2->ExpandUndo(pCompactUndo, pNode2->GetDBView(), &blockStore);
+        REQUIRE(pFromBlocks->Serialized() == undos[2]->Serialized());
+
+        REQUIRE_THROWS_AS(pNode2->ExpandUndo(pCompactUndo, pNode2->GetDBView(), nullptr), NotFoundException);
+    }
+
+    ///////////////////////
+    // Disconnect
+    ///////////////////////
+    pNode->DisconnectBlock(pExpanded, pNode->GetDBView());
+    REQUIRE(pNode->GetDBView()->GetBestHeader()->GetHash() == block2.GetHeader()->GetHash());
+    REQUIRE(pNode->GetDBView()->GetUTXOs(block1_tx2.GetOutputs()[0].GetCommitment()).size() == 1);
+
+    pNode.reset();
+}
+
+TEST_CASE("Node::ExpandUndo - Size and Time", "[.benchmark]")
+{
+    const size_t num_blocks = 101;
+
+    test::Miner miner;
+    std::vector<mw::Block::Ptr> blocks;
+    std::vector<test::Tx> prev_pegins;
+    for (size_t i = 0; i < num_blocks; i++) {
+        std::vector<test::Tx> pegins{ test::Tx::CreatePegIn(1000), test::Tx::CreatePegIn(2000) };
+        std::vector<test::Tx> txs = pegins;
+        for (const test::Tx& prev_pegin : prev_pegins) {
+            const test::TxOutput& output = prev_pegin.GetTxOutputs().front();
+            txs.push_back(test::Tx::CreateSpend({ output }, { output.GetAmount() }));
+        }
+
+        blocks.push_back(miner.MineBlock(150 + i, txs).GetBlock());
+        prev_pegins = pegins;
+    }
+
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir);
+
+    auto pDatabase = std::make_shared<TestDBWrapper>();
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, pDatabase);
+    auto undos = pNode->ConnectBlocks(blocks, pNode->GetDBView(), 0);
+    std::reverse(undos.begin(), undos.end());
+    undos.pop_back();
+
+    size_t full_size = 0;
+    size_t compact_size = 0;
+    std::vector<std::vector<uint8_t>> full_bytes;
+    std::vector<std::vector<uint8_t>> compact_bytes;
+    for (const auto& pUndo : undos) {
+        full_bytes.push_back(pUndo->Serialized());
+        compact_bytes.push_back(mw::CompactBlockUndo::FromUndo(*pUndo).Serialized());
+        full_size += full_bytes.back().size();
+        compact_size += compact_bytes.back().size();
+    }
+
+    std::cout << "Undo size for " << undos.size() << " blocks: full " << full_size << " bytes, compact " << compact_size << " bytes" << std::endl;
+
+    // Deserializes every undo and disconnects all blocks, as a reorg to the first block would.
+    auto disconnect = [&](const bool compact) {
+        auto pCachedView = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+
+        auto start = std::chrono::steady_clock::now();
+        std::vector<mw::BlockUndo::CPtr> deserialized;
+        for (size_t i = 0; i < undos.size(); i++) {
+            if (compact) {
+                Deserializer deserializer{ compact_bytes[i] };
+                auto pCompactUndo = std::make_shared<mw::CompactBlockUndo>(mw::CompactBlockUndo::Deserialize(deserializer));
+                deserialized.push_back(pNode->ExpandUndo(pCompactUndo, pCachedView, nullptr));
+            } else {
+                Deserializer deserializer{ full_bytes[i] };
+                deserialized.push_back(std::make_shared<mw::BlockUndo>(mw::BlockUndo::Deserialize(deserializer)));
+            }
+        }
+
+        pNode->DisconnectBlocks(deserialized, pCachedView);
+        auto elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+        std::cout << (compact ? "Compact" : "Full") << " undo: disconnected " << undos.size() << " blocks in " << elapsed.count() << "us" << std::endl;
+        return pCachedView->GetOutputPMMR()->Root();
+    };
+
+    REQUIRE(disconnect(false) == disconnect(true));
+
+    pNode.reset();
+}
@@ -1,9 +1,19 @@
 #include <catch.hpp>
 
 #include <mw/node/INode.h>
+#include <mw/node/CoinsView.h>
+#include <mw/node/validation/BlockValidator.h>
+#include <mw/exceptions/ValidationException.h>
+#include <mw/crypto/Random.h>
+#include <mw/crypto/VerificationCache.h>
 #include <mw/file/ScopedFileRemover.h>
 #include <test_framework/Miner.h>
 #include <test_framework/TestNode.h>
+#include <test_framework/DBWrapper.h>
+
+#include <chrono>
+#include <future>
+#include <unordered_set>
 
 TEST_CASE("BlockValidator")
 {
@@ -28,4 +38,192 @@ TEST_CASE("BlockValidator")
     REQUIRE_FALSE(block_10.GetBlock()->WasValidated());
     pNode->ValidateBlock(block_10.GetBlock(), pegInCoins, pegOutCoins);
     REQUIRE(block_10.GetBlock()->WasValidated());
-}
\ No newline at end of file
+}
+TEST_CASE("BlockValidator - Stages")
+{
+    test::Miner miner;
+
+    test::Tx pegin = test::Tx::CreatePegIn(5'000'000);
+    test::Tx spend = test::Tx::CreateSpend(pegin.GetTxOutputs(), { 4'000'000, 900'000 }, 100'000);
+    test::MinedBlock block_10 = miner.MineBlock(10, { pegin, spend });
+
+    std::vector<PegInCoin> pegInCoins{
+        PegInCoin(5'000'000, pegin.GetTransaction()->GetKernels()[0].GetCommitment())
+    };
+
+    ///////////////////////
+    // Valid
+    ///////////////////////
+    auto pBlock = std::make_shared<mw::Block>(*block_10.GetBlock());
+    BlockValidator validator;
+    validator.Validate(pBlock, pegInCoins, {});
+    REQUIRE(pBlock->WasValidated());
+
+    std::unordered_set<std::string> stages;
+    for (const auto& timing : validator.GetTimings()) {
+        stages.insert(timing.first);
+    }
+    REQUIRE(stages == std::unordered_set<std::string>{ "weight", "cut-through", "kernel signatures", "rangeproofs", "peg-ins", "peg-outs" });
+
+    // Only the weight and pegs are checked once the block is validated.
+    validator.Validate(pBlock, pegInCoins, {});
+    REQUIRE(validator.GetTimings().size() == 3);
+    REQUIRE_THROWS_AS(validator.Validate(pBlock, {}, {}), ValidationException);
+
+    ///////////////////////
+    // From A Pool Thread
+    ///////////////////////
+    // Validating on the pool's only thread would deadlock if Validate waited for the stages to run on the pool.
+    {
+        ThreadPool pool(1);
+        std::promise<bool> validated;
+        pool.Submit([&pool, &validated, &block_10, &pegInCoins]() {
+            auto pCopy = std::make_shared<mw::Block>(*block_10.GetBlock());
+            BlockValidator(pool).Validate(pCopy, pegInCoins, {});
+            validated.set_value(pCopy->WasValidated());
+        });
+
+        std::future<bool> result = validated.get_future();
+        REQUIRE(result.wait_for(std::chrono::seconds(60)) == std::future_status::ready);
+        REQUIRE(result.get());
+    }
+
+    ///////////////////////
+    // Invalid Signature
+    ///////////////////////
+    std::vector<Kernel> kernels = block_10.GetBlock()->GetKernels();
+    kernels.back() = Kernel::CreatePlain(
+        kernels.back().GetFee(),
+        Commitment(kernels.back().GetExcess()),
+        Signature(Random::CSPRNG<64>().GetBigInt())
+    );
+    auto pBadSig = std::make_shared<mw::Block>(
+        block_10.GetHeader(),
+        TxBody(block_10.GetBlock()->GetInputs(), block_10.GetBlock()->GetOutputs(), kernels)
+    );
+    REQUIRE_THROWS_AS(validator.Validate(pBadSig, pegInCoins, {}), ValidationException);
+    REQUIRE_FALSE(pBadSig->WasValidated());
+}
+
+TEST_CASE("BlockValidator - Aggregate Weight")
+{
+    FilePath datadir = test::TestUtil::GetTempDir();
+    ScopedFileRemover remover(datadir); // Removes the directory when this goes out of scope.
+
+    auto pNode = mw::InitializeNode(datadir, "unittest", nullptr, std::make_shared<TestDBWrapper>());
+
+    // Two transactions that are each within the weight limit, but aren't together.
+    const size_t num_outputs = (Consensus::MAX_BLOCK_WEIGHT / Consensus::OUTPUT_WEIGHT / 2) + 1;
+    auto create_tx = []() {
+        mw::Transaction::CPtr pPegIn = test::Tx::CreatePegIn(1000).GetTransaction();
+        std::vector<Output> outputs(num_outputs, pPegIn->GetOutputs().front());
+        auto pTx = std::make_shared<mw::Transaction>(
+            BlindingFactor(pPegIn->GetOffset()),
+            TxBody(std::vector<Input>{}, std::move(outputs), std::vector<Kernel>(pPegIn->GetKernels()))
+        );
+        REQUIRE(pTx->GetBody().GetWeight() <= Consensus::MAX_BLOCK_WEIGHT);
+        pTx->MarkAsValidated();
+        return pTx;
+    };
+
+    auto pCache = std::make_shared<mw::CoinsViewCache>(pNode->GetDBView());
+    mw::Block::Ptr pBlock = pCache->BuildNextBlock(1, { create_tx(), create_tx() });
+    REQUIRE(pBlock->GetTxBody().GetWeight() > Consensus::MAX_BLOCK_WEIGHT);
+    REQUIRE_FALSE(pBlock->WasValidated());
+
+    std::vector<PegInCoin> pegInCoins;
+    for (const Kernel& kernel : pBlock->GetKernels()) {
+        pegInCoins.push_back(PegInCoin(kernel.GetAmount(), kernel.GetCommitment()));
+    }
+
+    // Even a block marked as validated is checked against the weight limit.
+    pBlock->MarkAsValidated();
+    BlockValidator validator;
+    REQUIRE_THROWS_WITH(validator.Validate(pBlock, pegInCoins, {}), Catch::Contains("BLOCK_WEIGHT"));
+}
+
+TEST_CASE("BlockValidator - Latency", "[.benchmark]")
+{
+    const size_t num_txs = 100;
+
+    test::Miner miner;
+
+    std::vector<test::Tx> txs;
+    std::vector<PegInCoin> pegInCoins;
+    for (size_t i = 0; i < num_txs; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        pegInCoins.push_back(PegInCoin(1000, pegin.GetTransaction()->GetKernels()[0].GetCommitment()));
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::MinedBlock block = miner.MineBlock(10, txs);
+
+    // Start each measurement with nothing cached.
+    auto clear_caches = []() {
+        VerificationCache::GetSignatureCache().Clear();
+        VerificationCache::GetRangeProofCache().Clear();
+    };
+
+    clear_caches();
+    auto start = std::chrono::steady_clock::now();
+    block.GetBlock()->Validate();
+    auto sequential_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    BlockValidator validator;
+    auto pBlock = std::make_shared<mw::Block>(*block.GetBlock());
+    clear_caches();
+    start = std::chrono::steady_clock::now();
+    validator.Validate(pBlock, pegInCoins, {});
+    auto parallel_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "BlockValidator: " << pBlock->GetOutputs().size() << " outputs, sequential " << sequential_elapsed.count() << "us, "
+        << "parallel " << parallel_elapsed.count() << "us (" << ThreadPool::GetShared().GetNumThreads() << " threads)" << std::endl;
+    for (const auto& timing : validator.GetTimings()) {
+        std::cout << "  " << timing.first << ": " << timing.second.count() << "us" << std::endl;
+    }
+}
+
+TEST_CASE("BlockValidator - Mempool Seen", "[.benchmark]")
+{
+    const size_t num_txs = 100;
+
+    test::Miner miner;
+
+    std::vector<test::Tx> txs;
+    std::vector<PegInCoin> pegInCoins;
+    for (size_t i = 0; i < num_txs; i++) {
+        test::Tx pegin = test::Tx::CreatePegIn(1000);
+        pegInCoins.push_back(PegInCoin(1000, pegin.GetTransaction()->GetKernels()[0].GetCommitment()));
+        txs.push_back(pegin);
+        txs.push_back(test::Tx::CreateSpend(pegin.GetTxOutputs(), { 500, 400 }, 100));
+    }
+
+    test::MinedBlock block = miner.MineBlock(10, txs);
+
+    VerificationCache::GetSignatureCache().Clear();
+    VerificationCache::GetRangeProofCache().Clear();
+
+    BlockValidator validator;
+    auto start = std::chrono::steady_clock::now();
+    validator.Validate(std::make_shared<mw::Block>(*block.GetBlock()), pegInCoins, {});
+    auto cold_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    // Verify every transaction on its own, as mempool admission would, then validate the block again.
+    VerificationCache::GetSignatureCache().Clear();
+    VerificationCache::GetRangeProofCache().Clear();
+    for (const test::Tx& tx : txs) {
+        tx.GetTransaction()->GetBody().Validate();
+    }
+
+    VerificationCache::GetSignatureCache().ResetStats();
+    VerificationCache::GetRangeProofCache().ResetStats();
+    start = std::chrono::steady_clock::now();
+    validator.Validate(std::make_shared<mw::Block>(*block.GetBlock()), pegInCoins, {});
+    auto seen_elapsed = std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - start);
+
+    std::cout << "BlockValidator: " << txs.size() << " txs, cold " << cold_elapsed.count() << "us, "
+        << "mempool-seen " << seen_elapsed.count() << "us (hit rates: signatures "
+        << VerificationCache::GetSignatureCache().GetStats().GetHitRate() << ", rangeproofs "
+        << VerificationCache::GetRangeProofCache().GetStats().GetHitRate() << ")" << std::endl;
+}
@@ -1,6 +1,7 @@
 #include <catch.hpp>
 
 #include <mw/serialization/Deserializer.h>
+#include <mw/exceptions/DeserializationException.h>
 
 TEST_CASE("Deserializer")
 {
@@ -29,4 +30,18 @@ TEST_CASE("Deserializer")
     }
 
     // TODO: ReadVarStr, ReadVector, ReadArray
+}
+
+TEST_CASE("Deserializer - Borrowed Memory")
+{
+    const std::vector<uint8_t> bytes({ 0, 0, 0, 0, 0, 0, 0, 4, 84, 69, 83, 84, 1, 2, 3, 4, 5 });
+    Deserializer deserializer(bytes.data(), bytes.size());
+
+    REQUIRE(deserializer.ReadVarStr() == "TEST");
+    REQUIRE(deserializer.ReadBytes(2) == bytes.data() + 12);
+    REQUIRE(deserializer.ReadVector(2) == std::vector<uint8_t>({ 3, 4 }));
+    REQUIRE(deserializer.GetRemainingSize() == 1);
+    REQUIRE_THROWS_AS(deserializer.Read<uint16_t>(), DeserializationException);
+    REQUIRE(deserializer.ReadArray<1>() == std::array<uint8_t, 1>({ 5 }));
+    REQUIRE_THROWS_AS(deserializer.ReadBytes(1), DeserializationException);
 }
\ No newline at end of file
@@ -45,4 +45,23 @@ TEST_CASE("Serializer")
     // TODO: Append(const Serializable&), Append(const std::shared_ptr<const Serializable>)
 
     // TODO: uint8_t& operator[], const uint8_t& operator[]
+}
+
+TEST_CASE("Serializer - SizeOnly")
+{
+    // SizeOnly() counts bytes without writing them
+    {
+        Serializer serializer = Serializer::SizeOnly();
+        serializer.Append<uint64_t>(1).Append<uint8_t>(2).AppendLE<uint32_t>(3).Append("TEST");
+        REQUIRE(serializer.size() == 8 + 1 + 4 + 12);
+        REQUIRE(serializer.vec().empty());
+    }
+
+    // Moving the buffer out leaves the bytes as they were
+    {
+        Serializer serializer(8);
+        serializer.Append(1234567890ull);
+        REQUIRE(std::vector<uint8_t>({ 0, 0, 0, 0, 73, 150, 2, 210 }) == serializer.vec());
+        REQUIRE(std::vector<uint8_t>({ 0, 0, 0, 0, 73, 150, 2, 210 }) == std::move(serializer).vec());
+    }
 }
\ No newline at end of file